@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "snek/macros.hpp"
+
+namespace snek::bench
+{
+  /** Exit status of a regression check which could not be performed. */
+  static constexpr int kSkipped = 77;
+
+  /**
+   * Named piece of code whose running time is measured.
+   */
+  struct Benchmark
+  {
+    /**
+     * Runs the measured code given number of times and returns the number
+     * of items, such as tokens or statements, processed in total, or zero if
+     * the benchmark does not measure throughput.
+     */
+    using function_type = std::function<std::uint64_t(std::uint64_t)>;
+
+    std::string name;
+    function_type function;
+  };
+
+  /**
+   * Measurements of a single benchmark.
+   */
+  struct Result
+  {
+    std::string name;
+    /** Number of iterations run in each repetition. */
+    std::uint64_t iterations;
+    /** Number of items processed in each repetition. */
+    std::uint64_t items;
+    /** Nanoseconds taken by one iteration, for each repetition. */
+    std::vector<double> samples;
+    /**
+     * Instructions retired during one iteration, for each repetition. Empty
+     * if instructions were not counted.
+     */
+    std::vector<double> instructions;
+
+    double min() const;
+
+    double max() const;
+
+    double mean() const;
+
+    double median() const;
+
+    double median_instructions() const;
+  };
+
+  struct Options
+  {
+    /** Minimum time in seconds each repetition should take. */
+    double min_time = 0.1;
+    /** Number of times each benchmark is measured. */
+    std::size_t repetitions = 3;
+    /** Fixed number of iterations, instead of calibrating from min_time. */
+    std::optional<std::uint64_t> iterations;
+    /** Only benchmarks whose name contains this are run. */
+    std::string filter;
+    /** Whether retired instructions should be counted, when possible. */
+    bool count_instructions = true;
+  };
+
+  /**
+   * Counts instructions retired in user space by the calling thread, using
+   * the performance counters of Linux. On other platforms, and when the
+   * counters are not accessible, the counter is not available.
+   */
+  class InstructionCounter final
+  {
+  public:
+    DISALLOW_COPY_AND_ASSIGN(InstructionCounter);
+
+    explicit InstructionCounter();
+
+    ~InstructionCounter();
+
+    inline bool available() const
+    {
+      return m_fd >= 0;
+    }
+
+    void Start();
+
+    /**
+     * Stops counting and returns the number of instructions retired since
+     * the counter was started.
+     */
+    std::uint64_t Stop();
+
+  private:
+    int m_fd;
+  };
+
+  class Registry final
+  {
+  public:
+    inline const std::vector<Benchmark>& benchmarks() const
+    {
+      return m_benchmarks;
+    }
+
+    void Add(const std::string& name, const Benchmark::function_type& function);
+
+    /**
+     * Adds benchmark which evaluates given Snek expression, in a scope where
+     * given setup script has been run.
+     */
+    void AddExpression(
+      const std::string& name,
+      const std::u32string& setup,
+      const std::u32string& expression
+    );
+
+    /**
+     * Adds benchmark which runs given Snek script. Output of the script is
+     * discarded.
+     */
+    void AddScript(const std::string& name, const std::string& source);
+
+  private:
+    std::vector<Benchmark> m_benchmarks;
+  };
+
+  /**
+   * Returns syntactically valid Snek source code of given number of
+   * functions, exercising most of the tokens and statements of the
+   * language.
+   */
+  std::string MakeSyntheticSource(std::size_t function_count);
+
+  Result Run(const Benchmark& benchmark, const Options& options);
+
+  void WriteTable(std::ostream& output, const std::vector<Result>& results);
+
+  void WriteJson(
+    std::ostream& output,
+    const std::vector<Result>& results,
+    const Options& options
+  );
+
+  /**
+   * Returns the compiler and build type the benchmarks were built with.
+   * Results are only comparable between identical builds.
+   */
+  std::string GetBuildName();
+
+  /**
+   * Runs benchmarks listed in given baseline file with the same number of
+   * iterations as in the baseline, and reports the change of each. Returns
+   * exit status of the check; failure if any of the benchmarks has become
+   * slower by more than given percentage, or kSkipped if the baseline was
+   * recorded with different build or counter.
+   */
+  int CheckBaseline(
+    std::ostream& output,
+    const Registry& registry,
+    const Options& options,
+    const std::string& path,
+    double threshold
+  );
+
+  /**
+   * Measures the benchmarks listed in given baseline file again, and
+   * replaces the baseline with the results.
+   */
+  int UpdateBaseline(
+    const Registry& registry,
+    const Options& options,
+    const std::string& path
+  );
+
+  void RegisterLexerBenchmarks(Registry& registry);
+
+  void RegisterParserBenchmarks(Registry& registry);
+
+  void RegisterEvaluatorBenchmarks(Registry& registry);
+
+  void RegisterBuiltinBenchmarks(Registry& registry);
+
+  void RegisterProgramBenchmarks(Registry& registry);
+}
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+#include "snek/bench/benchmark.hpp"
+#include "snek/interpreter/evaluate.hpp"
+#include "snek/interpreter/runtime.hpp"
+#include "snek/parser/lexer.hpp"
+
+namespace snek::bench
+{
+  using interpreter::Runtime;
+  using interpreter::Scope;
+
+  namespace
+  {
+    struct ExpressionState
+    {
+      Runtime runtime;
+      Scope::ptr scope;
+      parser::expression::ptr expression;
+    };
+
+    struct ScriptState
+    {
+      Runtime runtime;
+      Scope::ptr scope;
+    };
+  }
+
+  double
+  Result::min() const
+  {
+    return samples.empty()
+      ? 0
+      : *std::min_element(std::begin(samples), std::end(samples));
+  }
+
+  double
+  Result::max() const
+  {
+    return samples.empty()
+      ? 0
+      : *std::max_element(std::begin(samples), std::end(samples));
+  }
+
+  double
+  Result::mean() const
+  {
+    return samples.empty()
+      ? 0
+      : std::accumulate(std::begin(samples), std::end(samples), 0.0)
+        / static_cast<double>(samples.size());
+  }
+
+  static double
+  Median(std::vector<double> sorted)
+  {
+    const auto size = sorted.size();
+
+    if (!size)
+    {
+      return 0;
+    }
+    std::sort(std::begin(sorted), std::end(sorted));
+
+    return size % 2
+      ? sorted[size / 2]
+      : (sorted[size / 2 - 1] + sorted[size / 2]) / 2;
+  }
+
+  double
+  Result::median() const
+  {
+    return Median(samples);
+  }
+
+  double
+  Result::median_instructions() const
+  {
+    return Median(instructions);
+  }
+
+  void
+  Registry::Add(
+    const std::string& name,
+    const Benchmark::function_type& function
+  )
+  {
+    m_benchmarks.push_back({ name, function });
+  }
+
+  void
+  Registry::AddExpression(
+    const std::string& name,
+    const std::u32string& setup,
+    const std::u32string& expression
+  )
+  {
+    // Runtimes are constructed on first use, so that benchmarks which are
+    // filtered out do not construct them at all.
+    std::shared_ptr<ExpressionState> state;
+
+    Add(name, [state, setup, expression](std::uint64_t iterations) mutable
+    {
+      if (!state)
+      {
+        parser::Lexer lexer(expression, U"<bench>");
+
+        state = std::make_shared<ExpressionState>();
+        state->scope = std::make_shared<Scope>(state->runtime.root_scope());
+        state->runtime.RunScript(state->scope, setup, U"<setup>");
+        state->expression = parser::expression::Parse(lexer);
+      }
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        interpreter::EvaluateExpression(
+          state->runtime,
+          state->scope,
+          state->expression
+        );
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+  }
+
+  void
+  Registry::AddScript(const std::string& name, const std::string& source)
+  {
+    std::shared_ptr<ScriptState> state;
+
+    Add(name, [state, source](std::uint64_t iterations) mutable
+    {
+      if (!state)
+      {
+        auto& runtime = (state = std::make_shared<ScriptState>())->runtime;
+
+        // Shadow the `print` function, so that the output of the script
+        // does not get mixed with the results.
+        state->scope = std::make_shared<Scope>(runtime.root_scope());
+        state->scope->DeclareVariable(
+          U"print",
+          interpreter::value::Function::MakeNative(
+            { { U"objects", runtime.list_type(), nullptr, true } },
+            runtime.void_type(),
+            [](Runtime&, const std::vector<interpreter::value::ptr>&)
+            {
+              return nullptr;
+            }
+          ),
+          true
+        );
+      }
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        state->runtime.RunScript(
+          std::make_shared<Scope>(state->scope),
+          source,
+          U"<bench>"
+        );
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+  }
+
+  std::string
+  MakeSyntheticSource(std::size_t function_count)
+  {
+    std::stringstream output;
+
+    for (std::size_t i = 0; i < function_count; ++i)
+    {
+      output << "# Synthetic function number " << i << ".\n"
+             << "const function" << i
+             << " = (a: Int, b: Float, c: String = \"default\") -> Float:\n"
+             << "  let result = a * 2 + b / 3.5 - " << i << "\n"
+             << "  let record = { name: c, values: [1, 2.5, \"three\"] }\n"
+             << "  while result < 100 && a != 0 || !c:\n"
+             << "    result += 1\n"
+             << "    if result % 7 == 0:\n"
+             << "      break\n"
+             << "    else if result > 50:\n"
+             << "      continue\n"
+             << "  for value in record.values:\n"
+             << "    result = value == 1 ? result + value : result\n"
+             << "  const name = record?.name ?? c\n"
+             << "  return name.length() > 3 ? result : -result\n"
+             << "\n";
+    }
+
+    return output.str();
+  }
+
+  static double
+  Measure(const Benchmark& benchmark, std::uint64_t iterations)
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    benchmark.function(iterations);
+
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+  }
+
+  static std::uint64_t
+  Calibrate(const Benchmark& benchmark, double min_time)
+  {
+    std::uint64_t iterations = 1;
+
+    for (;;)
+    {
+      const auto elapsed = Measure(benchmark, iterations);
+
+      if (elapsed >= min_time || iterations >= (1ULL << 40))
+      {
+        return iterations;
+      }
+      else if (elapsed < min_time / 100)
+      {
+        iterations *= 10;
+      } else {
+        // Overshoot slightly, so that the next measurement is likely to be
+        // long enough.
+        iterations = static_cast<std::uint64_t>(std::ceil(
+          static_cast<double>(iterations) * min_time * 1.2 / elapsed
+        ));
+      }
+    }
+  }
+
+  std::string
+  GetBuildName()
+  {
+    return SNEK_BENCH_BUILD;
+  }
+
+  Result
+  Run(const Benchmark& benchmark, const Options& options)
+  {
+    InstructionCounter counter;
+    const auto count = options.count_instructions && counter.available();
+    Result result;
+
+    // Warm up, which also runs any lazy setup of the benchmark.
+    benchmark.function(1);
+    result.name = benchmark.name;
+    result.iterations = options.iterations
+      ? std::max<std::uint64_t>(*options.iterations, 1)
+      : Calibrate(benchmark, options.min_time);
+    result.items = 0;
+    for (std::size_t i = 0; i < options.repetitions; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      if (count)
+      {
+        counter.Start();
+      }
+      result.items = benchmark.function(result.iterations);
+      if (count)
+      {
+        result.instructions.push_back(
+          static_cast<double>(counter.Stop())
+          / static_cast<double>(result.iterations)
+        );
+      }
+      result.samples.push_back(
+        std::chrono::duration<double, std::nano>(
+          std::chrono::steady_clock::now() - start
+        ).count() / static_cast<double>(result.iterations)
+      );
+    }
+
+    return result;
+  }
+
+  void
+  WriteTable(std::ostream& output, const std::vector<Result>& results)
+  {
+    std::size_t name_width = 9;
+
+    for (const auto& result : results)
+    {
+      name_width = std::max(name_width, result.name.length());
+    }
+    output << std::left << std::setw(name_width) << "Benchmark" << std::right
+           << std::setw(14) << "Median ns"
+           << std::setw(14) << "Min ns"
+           << std::setw(12) << "Iterations"
+           << std::setw(16) << "Items/s"
+           << '\n';
+    for (const auto& result : results)
+    {
+      const auto median = result.median();
+
+      output << std::left << std::setw(name_width) << result.name
+             << std::right << std::fixed << std::setprecision(1)
+             << std::setw(14) << median
+             << std::setw(14) << result.min()
+             << std::setw(12) << result.iterations;
+      if (result.items && median > 0)
+      {
+        output << std::setw(16) << std::setprecision(0)
+               << static_cast<double>(result.items) * 1e9
+                  / (median * static_cast<double>(result.iterations));
+      }
+      output << '\n';
+    }
+  }
+
+  static void
+  WriteJsonString(std::ostream& output, const std::string& value)
+  {
+    output << '"';
+    for (const auto c : value)
+    {
+      if (c == '"' || c == '\\')
+      {
+        output << '\\' << c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+      {
+        output << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>(c) << std::dec << std::setfill(' ');
+      } else {
+        output << c;
+      }
+    }
+    output << '"';
+  }
+
+  void
+  WriteJson(
+    std::ostream& output,
+    const std::vector<Result>& results,
+    const Options& options
+  )
+  {
+    const auto counted = !results.empty() && std::all_of(
+      std::begin(results),
+      std::end(results),
+      [](const Result& result)
+      {
+        return !result.instructions.empty();
+      }
+    );
+
+    output << "{\n"
+           << "  \"context\": {\n"
+           << "    \"build\": ";
+    WriteJsonString(output, GetBuildName());
+    output << ",\n"
+           << "    \"counter\": \""
+           << (counted ? "instructions" : "time")
+           << "\",\n"
+           << "    \"min_time\": " << options.min_time << ",\n"
+           << "    \"repetitions\": " << options.repetitions << "\n"
+           << "  },\n"
+           << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const auto& result = results[i];
+      const auto median = result.median();
+
+      output << (i > 0 ? "," : "") << "\n    {\n"
+             << "      \"name\": ";
+      WriteJsonString(output, result.name);
+      output << ",\n"
+             << std::setprecision(17)
+             << "      \"iterations\": " << result.iterations << ",\n"
+             << "      \"median_ns\": " << median << ",\n"
+             << "      \"mean_ns\": " << result.mean() << ",\n"
+             << "      \"min_ns\": " << result.min() << ",\n"
+             << "      \"max_ns\": " << result.max();
+      if (counted)
+      {
+        output << ",\n      \"median_instructions\": "
+               << result.median_instructions();
+      }
+      if (result.items && median > 0)
+      {
+        output << ",\n      \"items_per_second\": "
+               << static_cast<double>(result.items) * 1e9
+                  / (median * static_cast<double>(result.iterations));
+      }
+      output << "\n    }";
+    }
+    output << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/bench/benchmark.hpp"
+
+namespace snek::bench
+{
+  static const char32_t* setup =
+    U"const numbers = range(100).map((n) => n)\n"
+    U"const floats = numbers.map((n) => n * 0.5)\n"
+    U"const words = numbers.map((n) => \"word\" + n.toString())\n"
+    U"const text = words.join(\" \")\n"
+    U"const r = { a: 1, b: \"two\", c: [3], d: { e: 4 } }\n";
+
+  static const std::pair<const char*, const char32_t*> expressions[] =
+  {
+    { "List#+", U"numbers + numbers" },
+    { "List#[]", U"numbers[50]" },
+    { "List#filter", U"numbers.filter((n) => n % 2 == 0)" },
+    { "List#includes", U"numbers.includes(99)" },
+    { "List#indexOf", U"numbers.indexOf(99)" },
+    { "List#join", U"words.join(\", \")" },
+    { "List#map", U"numbers.map((n) => n + 1)" },
+    { "List#reduce", U"numbers.reduce((a, b) => a + b)" },
+    { "List#reverse", U"numbers.reverse()" },
+    { "List#size", U"numbers.size()" },
+    { "List#sort", U"floats.reverse().sort()" },
+    { "List#sum", U"floats.sum()" },
+    { "String#+", U"text + text" },
+    { "String#[]", U"text[100]" },
+    { "String#includes", U"text.includes(\"word99\")" },
+    { "String#indexOf", U"text.indexOf(\"word99\")" },
+    { "String#length", U"text.length()" },
+    { "String#reverse", U"text.reverse()" },
+    { "String#toUpper", U"text.toUpper()" },
+    { "Record#+", U"r + { f: 5 }" },
+    { "Record#[]", U"r[\"d\"]" },
+    { "Record#entries", U"r.entries()" },
+    { "Record#keys", U"r.keys()" },
+    { "Record#values", U"r.values()" },
+    { "eval", U"eval(\"[1, 2, 3].map((n) => n * 2)\")" },
+  };
+
+  void
+  RegisterBuiltinBenchmarks(Registry& registry)
+  {
+    for (const auto& entry : expressions)
+    {
+      registry.AddExpression(
+        std::string("builtin/") + entry.first,
+        setup,
+        entry.second
+      );
+    }
+  }
+}
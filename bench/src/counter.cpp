@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#if defined(__linux__)
+#  include <cstring>
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "snek/bench/benchmark.hpp"
+
+namespace snek::bench
+{
+  InstructionCounter::InstructionCounter()
+    : m_fd(-1)
+  {
+#if defined(__linux__)
+    struct perf_event_attr attributes;
+
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    m_fd = static_cast<int>(
+      syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0)
+    );
+#endif
+  }
+
+  InstructionCounter::~InstructionCounter()
+  {
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+      close(m_fd);
+    }
+#endif
+  }
+
+  void
+  InstructionCounter::Start()
+  {
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+      ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  std::uint64_t
+  InstructionCounter::Stop()
+  {
+#if defined(__linux__)
+    std::uint64_t count = 0;
+
+    if (m_fd < 0)
+    {
+      return 0;
+    }
+    ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+    {
+      return 0;
+    }
+
+    return count;
+#else
+    return 0;
+#endif
+  }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/bench/benchmark.hpp"
+#include "snek/interpreter/native.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+namespace snek::bench
+{
+  using interpreter::Runtime;
+  using interpreter::value::Function;
+  using interpreter::value::ptr;
+
+  static ptr
+  Identity(ptr value)
+  {
+    return value;
+  }
+
+  static const char32_t* setup =
+    U"let x = 5\n"
+    U"let l = [1, 2, 3]\n"
+    U"let r = { a: 1, b: 2 }\n"
+    U"const id = (value) => value\n";
+
+  /** Expressions evaluated for each kind of syntax tree node. */
+  static const std::pair<const char*, const char32_t*> expressions[] =
+  {
+    { "Assign", U"x = 5" },
+    { "Binary", U"x + 1" },
+    { "Boolean", U"true" },
+    { "Call", U"id(1)" },
+    { "Decrement", U"x--" },
+    { "Float", U"1.5" },
+    { "Function", U"(value) => value" },
+    { "Id", U"x" },
+    { "Increment", U"x++" },
+    { "Int", U"42" },
+    { "List", U"[1, 2, 3]" },
+    { "Null", U"null" },
+    { "Property", U"r.a" },
+    { "Record", U"{ a: 1, b: 2 }" },
+    { "Spread", U"[...l]" },
+    { "Subscript", U"l[1]" },
+    { "String", U"\"text\"" },
+    { "Ternary", U"x > 2 ? x : 0" },
+    { "Unary", U"-x" },
+  };
+
+  void
+  RegisterEvaluatorBenchmarks(Registry& registry)
+  {
+    const auto runtime = std::make_shared<Runtime>();
+
+    for (const auto& entry : expressions)
+    {
+      registry.AddExpression(
+        std::string("evaluate/") + entry.first,
+        setup,
+        entry.second
+      );
+    }
+
+    registry.Add("dispatch/CallMethod", [runtime](std::uint64_t iterations)
+    {
+      const auto value = runtime->MakeInt(5);
+      const std::vector<ptr> arguments = { runtime->MakeInt(1) };
+
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        interpreter::value::CallMethod(*runtime, value, U"+", arguments);
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+
+    registry.Add("call/native", [runtime](std::uint64_t iterations)
+    {
+      const auto function = Function::MakeNative(
+        { { U"value", runtime->any_type() } },
+        runtime->any_type(),
+        [](Runtime&, const std::vector<ptr>& arguments)
+        {
+          return arguments[0];
+        }
+      );
+      const std::vector<ptr> arguments = { runtime->MakeInt(1) };
+
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        Function::Call(*runtime, function, arguments);
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+
+    registry.Add("call/native-typed", [runtime](std::uint64_t iterations)
+    {
+      const auto function = interpreter::native::Bind<Identity>(
+        &runtime->builtins(),
+        { { U"value" } }
+      );
+      const std::vector<ptr> arguments = { runtime->MakeInt(1) };
+
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        Function::Call(*runtime, function, arguments);
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+
+    registry.Add("call/scripted", [runtime](std::uint64_t iterations)
+    {
+      const auto function = std::static_pointer_cast<Function>(
+        runtime->RunScript(runtime->root_scope(), U"(value) => value")
+      );
+      const std::vector<ptr> arguments = { runtime->MakeInt(1) };
+
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        Function::Call(*runtime, function, arguments);
+      }
+
+      return static_cast<std::uint64_t>(0);
+    });
+  }
+}
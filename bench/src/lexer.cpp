@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/bench/benchmark.hpp"
+#include "snek/parser/lexer.hpp"
+
+namespace snek::bench
+{
+  using parser::Lexer;
+  using parser::Token;
+
+  void
+  RegisterLexerBenchmarks(Registry& registry)
+  {
+    const auto source = std::make_shared<std::string>(
+      MakeSyntheticSource(100)
+    );
+
+    registry.Add("lexer/ReadToken", [source](std::uint64_t iterations)
+    {
+      std::uint64_t tokens = 0;
+
+      for (std::uint64_t i = 0; i < iterations; ++i)
+      {
+        Lexer lexer(source->data(), source->length());
+
+        while (lexer.ReadToken().kind != Token::Kind::Eof)
+        {
+          ++tokens;
+        }
+      }
+
+      return tokens;
+    });
+  }
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/bench/benchmark.hpp"
+#include "snek/interpreter/error.hpp"
+#include "snek/parser/error.hpp"
+
+using namespace snek::bench;
+
+static Options options;
+static std::string format = "table";
+static std::optional<std::string> output_path;
+static bool list_benchmarks = false;
+static std::optional<std::string> baseline_path;
+static double threshold = 10;
+static bool update_baseline = false;
+
+static void
+PrintUsage(std::ostream& output, const char* executable_name)
+{
+  output << std::endl
+         << "Usage: "
+         << executable_name
+         << " [switches]"
+         << std::endl
+         << "  --filter=text     Run only benchmarks whose name contains"
+         << std::endl
+         << "                    given text."
+         << std::endl
+         << "  --min-time=secs   Minimum duration of each repetition."
+         << std::endl
+         << "  --iterations=n    Run fixed number of iterations instead."
+         << std::endl
+         << "  --repetitions=n   Number of times each benchmark is measured."
+         << std::endl
+         << "  --format=format   Output format; either `table' or `json'."
+         << std::endl
+         << "  --output=file     Write the results into given file."
+         << std::endl
+         << "  --list            List names of the benchmarks."
+         << std::endl
+         << "  --baseline=file   Compare benchmarks listed in given baseline"
+         << std::endl
+         << "                    file against it, failing on regressions."
+         << std::endl
+         << "  --threshold=pct   Percentage of slowdown considered as"
+         << std::endl
+         << "                    regression. Defaults to 10."
+         << std::endl
+         << "  --update-baseline Measure the benchmarks of the baseline file"
+         << std::endl
+         << "                    again and replace it with the results."
+         << std::endl
+         << "  --help            Display this message."
+         << std::endl
+         << std::endl;
+}
+
+static void
+Fail(const char* executable_name, const char* message)
+{
+  std::cerr << message << std::endl;
+  PrintUsage(std::cerr, executable_name);
+  std::exit(EXIT_FAILURE);
+}
+
+static void
+ParseArgs(int argc, char** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const auto arg = argv[i];
+
+    if (!std::strcmp(arg, "--help"))
+    {
+      PrintUsage(std::cout, argv[0]);
+      std::exit(EXIT_SUCCESS);
+    }
+    else if (!std::strcmp(arg, "--list"))
+    {
+      list_benchmarks = true;
+    }
+    else if (!std::strcmp(arg, "--update-baseline"))
+    {
+      update_baseline = true;
+    }
+    else if (!std::strncmp(arg, "--baseline=", 11) && arg[11])
+    {
+      baseline_path = arg + 11;
+    }
+    else if (!std::strncmp(arg, "--threshold=", 12))
+    {
+      threshold = std::atof(arg + 12);
+      if (threshold <= 0)
+      {
+        Fail(argv[0], "Positive number expected for the --threshold option.");
+      }
+    }
+    else if (!std::strncmp(arg, "--filter=", 9))
+    {
+      options.filter = arg + 9;
+    }
+    else if (!std::strncmp(arg, "--min-time=", 11))
+    {
+      options.min_time = std::atof(arg + 11);
+      if (options.min_time <= 0)
+      {
+        Fail(argv[0], "Positive number expected for the --min-time option.");
+      }
+    }
+    else if (!std::strncmp(arg, "--iterations=", 13))
+    {
+      const auto iterations = std::atoll(arg + 13);
+
+      if (iterations <= 0)
+      {
+        Fail(
+          argv[0],
+          "Positive number expected for the --iterations option."
+        );
+      }
+      options.iterations = static_cast<std::uint64_t>(iterations);
+    }
+    else if (!std::strncmp(arg, "--repetitions=", 14))
+    {
+      const auto repetitions = std::atoi(arg + 14);
+
+      if (repetitions <= 0)
+      {
+        Fail(
+          argv[0],
+          "Positive number expected for the --repetitions option."
+        );
+      }
+      options.repetitions = static_cast<std::size_t>(repetitions);
+    }
+    else if (!std::strncmp(arg, "--format=", 9))
+    {
+      format = arg + 9;
+      if (format != "table" && format != "json")
+      {
+        Fail(argv[0], "Unrecognized output format.");
+      }
+    }
+    else if (!std::strncmp(arg, "--output=", 9) && arg[9])
+    {
+      output_path = arg + 9;
+    } else {
+      std::cerr << "Unrecognized switch: " << arg << std::endl;
+      PrintUsage(std::cerr, argv[0]);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  Registry registry;
+  std::vector<Result> results;
+  std::ofstream file;
+
+  ParseArgs(argc, argv);
+
+  RegisterLexerBenchmarks(registry);
+  RegisterParserBenchmarks(registry);
+  RegisterEvaluatorBenchmarks(registry);
+  RegisterBuiltinBenchmarks(registry);
+  RegisterProgramBenchmarks(registry);
+
+  if (update_baseline && !baseline_path)
+  {
+    Fail(argv[0], "The --update-baseline option requires --baseline.");
+  }
+  else if (baseline_path)
+  {
+    try
+    {
+      return update_baseline
+        ? UpdateBaseline(registry, options, *baseline_path)
+        : CheckBaseline(
+          std::cout,
+          registry,
+          options,
+          *baseline_path,
+          threshold
+        );
+    }
+    catch (const snek::interpreter::Error& e)
+    {
+      std::cerr << peelo::unicode::encoding::utf8::encode(e.message)
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  for (const auto& benchmark : registry.benchmarks())
+  {
+    if (
+      !options.filter.empty() &&
+      benchmark.name.find(options.filter) == std::string::npos
+    )
+    {
+      continue;
+    }
+    else if (list_benchmarks)
+    {
+      std::cout << benchmark.name << std::endl;
+      continue;
+    }
+    try
+    {
+      results.push_back(Run(benchmark, options));
+    }
+    catch (const snek::interpreter::Error& e)
+    {
+      std::cerr << "Benchmark `"
+                << benchmark.name
+                << "' failed: "
+                << peelo::unicode::encoding::utf8::encode(e.message)
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    catch (const snek::parser::SyntaxError& e)
+    {
+      std::cerr << "Benchmark `"
+                << benchmark.name
+                << "' failed: "
+                << peelo::unicode::encoding::utf8::encode(e.message)
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  if (list_benchmarks)
+  {
+    return EXIT_SUCCESS;
+  }
+
+  if (output_path)
+  {
+    file.open(*output_path);
+    if (!file.good())
+    {
+      std::cerr << "Unable to write results `" << *output_path << "'."
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  auto& output = output_path ? static_cast<std::ostream&>(file) : std::cout;
+
+  if (format == "json")
+  {
+    WriteJson(output, results, options);
+  } else {
+    WriteTable(output, results);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "snek/bench/benchmark.hpp"
+
+namespace snek::bench
+{
+  /** Larger synthetic workloads, which run for several milliseconds. */
+  static const std::pair<const char*, const char*> workloads[] =
+  {
+    {
+      "loop",
+      "let total = 0\n"
+      "let i = 0\n"
+      "while i < 1000:\n"
+      "  total += i % 7\n"
+      "  i++\n"
+    },
+    {
+      "for-range",
+      "let total = 0\n"
+      "for i in range(1000):\n"
+      "  if i % 3 == 0:\n"
+      "    total += i\n"
+    },
+    {
+      "closures",
+      "const makeCounter = ():\n"
+      "  let count = 0\n"
+      "  return () => ++count\n"
+      "for i in range(200):\n"
+      "  const counter = makeCounter()\n"
+      "  counter()\n"
+      "  counter()\n"
+    },
+    {
+      "strings",
+      "let text = \"\"\n"
+      "for i in range(200):\n"
+      "  text = text + \"x\"\n"
+      "text.toUpper().reverse().indexOf(\"y\")\n"
+    },
+    {
+      "records",
+      "let points = []\n"
+      "for i in range(200):\n"
+      "  points = points + [{ x: i, y: i * 2 }]\n"
+      "points.map((p) => p.x + p.y).reduce((a, b) => a + b)\n"
+    },
+    {
+      "list-pipeline",
+      "const even = range(2000).filter((n) => n % 2 == 0)\n"
+      "even.map((n) => n * n).reduce((a, b) => a + b)\n"
+    },
+    {
+      "sort",
+      "range(1000).map((n) => (n * 7919) % 1000).sort()\n"
+    },
+  };
+
+  static bool
+  ReadExample(const std::string& name, std::string& source)
+  {
+    std::ifstream input(std::string(SNEK_BENCH_EXAMPLES_DIR) + "/" + name);
+    std::stringstream buffer;
+
+    if (!input.good())
+    {
+      return false;
+    }
+    buffer << input.rdbuf();
+    source = buffer.str();
+
+    return true;
+  }
+
+  void
+  RegisterProgramBenchmarks(Registry& registry)
+  {
+    for (const auto name : { "fibonacci.snek", "factorial.snek" })
+    {
+      std::string source;
+
+      if (!ReadExample(name, source))
+      {
+        std::cerr << "Unable to read example `" << name << "'." << std::endl;
+        continue;
+      }
+      registry.AddScript(std::string("example/") + name, source);
+    }
+    for (const auto& workload : workloads)
+    {
+      registry.AddScript(
+        std::string("program/") + workload.first,
+        workload.second
+      );
+    }
+  }
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/bench/benchmark.hpp"
+#include "snek/interpreter/error.hpp"
+#include "snek/interpreter/json.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+namespace snek::bench
+{
+  using interpreter::Runtime;
+  namespace value = interpreter::value;
+
+  namespace
+  {
+    struct BaselineEntry
+    {
+      std::string name;
+      std::uint64_t iterations;
+      double value;
+    };
+
+    struct Baseline
+    {
+      std::string build;
+      bool counted;
+      std::vector<BaselineEntry> entries;
+    };
+  }
+
+  static value::ptr
+  GetField(const value::ptr& record, const std::u32string& name)
+  {
+    if (value::IsRecord(record))
+    {
+      const auto field = std::static_pointer_cast<value::Record>(record)
+        ->GetOwnProperty(name);
+
+      if (field)
+      {
+        return *field;
+      }
+    }
+
+    return nullptr;
+  }
+
+  static std::string
+  GetString(const value::ptr& record, const std::u32string& name)
+  {
+    const auto field = GetField(record, name);
+
+    return value::IsString(field)
+      ? peelo::unicode::encoding::utf8::encode(field->ToString())
+      : std::string();
+  }
+
+  static double
+  GetNumber(const value::ptr& record, const std::u32string& name)
+  {
+    const auto field = GetField(record, name);
+
+    return value::IsInt(field) || value::IsFloat(field)
+      ? std::static_pointer_cast<value::Number>(field)->ToFloat()
+      : 0;
+  }
+
+  static bool
+  ReadBaseline(const std::string& path, Baseline& baseline)
+  {
+    std::ifstream input(path);
+    std::stringstream buffer;
+    Runtime runtime;
+    value::ptr root;
+    value::ptr benchmarks;
+
+    if (!input.good())
+    {
+      std::cerr << "Unable to read baseline `" << path << "'." << std::endl;
+
+      return false;
+    }
+    buffer << input.rdbuf();
+    try
+    {
+      root = interpreter::json::Parse(runtime, buffer.str());
+    }
+    catch (const interpreter::Error& e)
+    {
+      std::cerr << "Unable to parse baseline `"
+                << path
+                << "': "
+                << peelo::unicode::encoding::utf8::encode(e.message)
+                << std::endl;
+
+      return false;
+    }
+
+    const auto context = GetField(root, U"context");
+
+    baseline.build = GetString(context, U"build");
+    baseline.counted = GetString(context, U"counter") == "instructions";
+    benchmarks = GetField(root, U"benchmarks");
+    if (!value::IsList(benchmarks))
+    {
+      std::cerr << "Baseline `" << path << "' lists no benchmarks."
+                << std::endl;
+
+      return false;
+    }
+    const auto list = std::static_pointer_cast<value::List>(benchmarks);
+
+    for (std::size_t i = 0; i < list->GetSize(); ++i)
+    {
+      const auto element = list->At(i);
+
+      baseline.entries.push_back({
+        GetString(element, U"name"),
+        static_cast<std::uint64_t>(GetNumber(element, U"iterations")),
+        GetNumber(
+          element,
+          baseline.counted ? U"median_instructions" : U"median_ns"
+        )
+      });
+    }
+
+    return true;
+  }
+
+  static const Benchmark*
+  FindBenchmark(const Registry& registry, const std::string& name)
+  {
+    for (const auto& benchmark : registry.benchmarks())
+    {
+      if (benchmark.name == name)
+      {
+        return &benchmark;
+      }
+    }
+    std::cerr << "Unknown benchmark `" << name << "' in baseline."
+              << std::endl;
+
+    return nullptr;
+  }
+
+  int
+  CheckBaseline(
+    std::ostream& output,
+    const Registry& registry,
+    const Options& options,
+    const std::string& path,
+    double threshold
+  )
+  {
+    Baseline baseline;
+    auto result = EXIT_SUCCESS;
+
+    if (!ReadBaseline(path, baseline))
+    {
+      return EXIT_FAILURE;
+    }
+    else if (!baseline.counted)
+    {
+      // Wall time varies too much between runs on shared machines to be
+      // compared against a threshold, so such baseline cannot be checked.
+      output << "Baseline has been recorded by measuring time instead of "
+             << "counting instructions. Record it again with `make "
+             << "snek-bench-baseline' where performance counters are "
+             << "accessible."
+             << std::endl;
+
+      return EXIT_FAILURE;
+    }
+    else if (baseline.build != GetBuildName())
+    {
+      output << "Baseline has been recorded with `"
+             << baseline.build
+             << "' but this is `"
+             << GetBuildName()
+             << "'; skipping."
+             << std::endl;
+
+      return kSkipped;
+    }
+    else if (baseline.counted && !InstructionCounter().available())
+    {
+      output << "Baseline has been recorded by counting instructions, "
+             << "which is not possible here; skipping."
+             << std::endl;
+
+      return kSkipped;
+    }
+
+    output << std::left << std::setw(28) << "Benchmark" << std::right
+           << std::setw(16) << "Baseline"
+           << std::setw(16) << "Current"
+           << std::setw(10) << "Change"
+           << std::endl;
+    for (const auto& entry : baseline.entries)
+    {
+      const auto benchmark = FindBenchmark(registry, entry.name);
+      auto benchmark_options = options;
+      double current;
+      double change;
+
+      if (!benchmark)
+      {
+        return EXIT_FAILURE;
+      }
+      benchmark_options.iterations = entry.iterations;
+      benchmark_options.count_instructions = baseline.counted;
+
+      const auto measured = Run(*benchmark, benchmark_options);
+
+      current = baseline.counted
+        ? measured.median_instructions()
+        : measured.median();
+      change = entry.value > 0
+        ? (current - entry.value) * 100 / entry.value
+        : 0;
+      output << std::left << std::setw(28) << entry.name << std::right
+             << std::fixed << std::setprecision(0)
+             << std::setw(16) << entry.value
+             << std::setw(16) << current
+             << std::setprecision(1)
+             << std::setw(9) << change << '%';
+      if (change > threshold)
+      {
+        output << "  REGRESSION";
+        result = EXIT_FAILURE;
+      }
+      output << std::endl;
+    }
+
+    return result;
+  }
+
+  int
+  UpdateBaseline(
+    const Registry& registry,
+    const Options& options,
+    const std::string& path
+  )
+  {
+    Baseline baseline;
+    std::vector<Result> results;
+    std::ofstream output;
+
+    if (!ReadBaseline(path, baseline))
+    {
+      return EXIT_FAILURE;
+    }
+    else if (!options.count_instructions || !InstructionCounter().available())
+    {
+      std::cerr << "Instructions cannot be counted here, so the baseline "
+                << "records time, which the regression test does not accept."
+                << std::endl;
+    }
+    for (const auto& entry : baseline.entries)
+    {
+      const auto benchmark = FindBenchmark(registry, entry.name);
+
+      if (!benchmark)
+      {
+        return EXIT_FAILURE;
+      }
+      results.push_back(Run(*benchmark, options));
+    }
+    output.open(path);
+    if (!output.good())
+    {
+      std::cerr << "Unable to write baseline `" << path << "'." << std::endl;
+
+      return EXIT_FAILURE;
+    }
+    WriteJson(output, results, options);
+
+    return EXIT_SUCCESS;
+  }
+}
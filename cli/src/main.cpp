@@ -23,6 +23,7 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -37,11 +38,19 @@
 #include <peelo/unicode/encoding/utf8.hpp>
 
 #include "snek/cli/utils.hpp"
+#include "snek/interpreter/allocation_tracker.hpp"
+#include "snek/interpreter/module.hpp"
+#include "snek/interpreter/profiler.hpp"
 #include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
 
+using snek::interpreter::AllocationTracker;
 using snek::interpreter::Error;
+using snek::interpreter::Program;
+using snek::interpreter::Profiler;
 using snek::interpreter::Runtime;
 using snek::interpreter::Scope;
+using snek::interpreter::WorkStealingPool;
 
 namespace snek::cli
 {
@@ -50,6 +59,16 @@ namespace snek::cli
 
 static std::optional<std::string> script;
 static std::vector<std::string> inline_scripts;
+static std::optional<std::vector<std::string>> modules_to_compile;
+static std::optional<std::size_t> thread_count;
+static std::optional<std::string> profile_path;
+static Profiler profiler;
+static std::optional<std::string> allocations_path;
+static AllocationTracker allocation_tracker;
+static bool print_statistics = false;
+#if defined(SNEK_ENABLE_STATISTICS)
+static const Runtime* statistics_runtime = nullptr;
+#endif
 
 static void
 PrintUsage(std::ostream& output, const char* executable_name)
@@ -61,6 +80,24 @@ PrintUsage(std::ostream& output, const char* executable_name)
          << std::endl
          << "  -e program        One line of program. (Omit programfile.)"
          << std::endl
+         << "  --compile files   Compile given modules into `.snekc' files."
+         << std::endl
+         << "  --threads count   Number of threads used by parallel list"
+         << std::endl
+         << "                    operations."
+         << std::endl
+         << "  --profile=file    Sample the program and write collapsed call"
+         << std::endl
+         << "                    stacks into given file."
+         << std::endl
+         << "  --allocations=file Write allocation sites of values into"
+         << std::endl
+         << "                    given file."
+         << std::endl
+         << "  --stats           Print execution counters when the program"
+         << std::endl
+         << "                    exits."
+         << std::endl
          << "  --version         Print the version."
          << std::endl
          << "  --help            Display this message."
@@ -83,6 +120,11 @@ ParseArgs(int argc, char** argv)
     }
     else if (*arg != '-')
     {
+      if (modules_to_compile)
+      {
+        modules_to_compile->push_back(arg);
+        continue;
+      }
       script = arg;
       break;
     }
@@ -101,6 +143,57 @@ ParseArgs(int argc, char** argv)
       {
         // TODO: Output version.
         std::exit(EXIT_SUCCESS);
+      }
+      else if (!std::strcmp(arg, "--compile"))
+      {
+        modules_to_compile.emplace();
+        continue;
+      }
+      else if (!std::strcmp(arg, "--threads"))
+      {
+        if (offset < argc)
+        {
+          const auto count = std::atoi(argv[offset++]);
+
+          if (count > 0)
+          {
+            thread_count = static_cast<std::size_t>(count);
+            continue;
+          }
+        }
+        std::cerr << "Positive number expected for the --threads option."
+                  << std::endl;
+        PrintUsage(std::cerr, argv[0]);
+        std::exit(EXIT_FAILURE);
+      }
+      else if (!std::strcmp(arg, "--stats"))
+      {
+        print_statistics = true;
+        continue;
+      }
+      else if (!std::strncmp(arg, "--profile=", 10))
+      {
+        if (arg[10])
+        {
+          profile_path = arg + 10;
+          continue;
+        }
+        std::cerr << "Filename expected for the --profile option."
+                  << std::endl;
+        PrintUsage(std::cerr, argv[0]);
+        std::exit(EXIT_FAILURE);
+      }
+      else if (!std::strncmp(arg, "--allocations=", 14))
+      {
+        if (arg[14])
+        {
+          allocations_path = arg + 14;
+          continue;
+        }
+        std::cerr << "Filename expected for the --allocations option."
+                  << std::endl;
+        PrintUsage(std::cerr, argv[0]);
+        std::exit(EXIT_FAILURE);
       } else {
         std::cerr << "Unrecognized switch: " << arg << std::endl;
         PrintUsage(std::cerr, argv[0]);
@@ -154,7 +247,22 @@ RunScript(
 {
   try
   {
-    runtime.RunScript(scope, source, filename);
+    Program::ptr program;
+
+    // Script is parsed fully before it's executed, so that the modules it
+    // imports can be loaded in the background from the beginning.
+    try
+    {
+      program = runtime.Compile(source, filename);
+    }
+    catch (const Error&)
+    {
+      // Let the script run until the syntax error, so that the error is
+      // reported in the usual way.
+      runtime.RunScript(scope, source, filename);
+      return;
+    }
+    runtime.Run(program, scope);
   }
   catch (const Error& e)
   {
@@ -163,6 +271,30 @@ RunScript(
   }
 }
 
+static void
+CompileModules(Runtime& runtime)
+{
+  using peelo::unicode::encoding::utf8::decode;
+
+  if (modules_to_compile->empty())
+  {
+    std::cerr << "No modules given for the --compile option." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  for (const auto& path : *modules_to_compile)
+  {
+    try
+    {
+      snek::interpreter::CompileFilesystemModule(runtime, decode(path));
+    }
+    catch (const Error& e)
+    {
+      snek::cli::utils::PrintStackTrace(std::cerr, e);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+}
+
 static inline std::string
 ReadStream(std::istream& stream)
 {
@@ -197,6 +329,74 @@ RunFile(
   RunScript(runtime, scope, decode(filename), source);
 }
 
+/**
+ * Stops the profiler and writes the samples into the profile file. This is
+ * also registered as exit handler, so that the profile is written even when
+ * the program terminates because of an error.
+ */
+static void
+WriteProfile()
+{
+  std::ofstream output;
+
+  if (!profiler.running())
+  {
+    return;
+  }
+  profiler.Stop();
+  output.open(*profile_path);
+  if (!output.good())
+  {
+    std::cerr << "Unable to write profile `" << *profile_path << "'."
+              << std::endl;
+    return;
+  }
+  profiler.WriteFolded(output);
+}
+
+/**
+ * Stops the allocation tracker and writes the allocation sites into the
+ * allocations file. This is also registered as exit handler, so that the
+ * allocations are written even when the program terminates because of an
+ * error.
+ */
+static void
+WriteAllocations()
+{
+  std::ofstream output;
+
+  if (!allocation_tracker.running())
+  {
+    return;
+  }
+  allocation_tracker.Stop();
+  output.open(*allocations_path);
+  if (!output.good())
+  {
+    std::cerr << "Unable to write allocations `" << *allocations_path << "'."
+              << std::endl;
+    return;
+  }
+  allocation_tracker.WriteTable(output);
+}
+
+#if defined(SNEK_ENABLE_STATISTICS)
+/**
+ * Outputs execution counters of the runtime into standard error stream.
+ * This is also registered as exit handler, so that the counters are
+ * printed even when the program terminates because of an error.
+ */
+static void
+PrintStatistics()
+{
+  if (statistics_runtime)
+  {
+    statistics_runtime->statistics().Write(std::cerr);
+    statistics_runtime = nullptr;
+  }
+}
+#endif
+
 static inline bool
 IsInteractiveTerminal()
 {
@@ -215,6 +415,48 @@ main(int argc, char** argv)
 
   ParseArgs(argc, argv);
 
+  if (thread_count)
+  {
+    // The main thread also participates in the parallel operations.
+    runtime.set_worker_pool(
+      std::make_shared<WorkStealingPool>(*thread_count - 1)
+    );
+  }
+
+  if (profile_path)
+  {
+    if (!profiler.Start(runtime))
+    {
+      std::cerr << "Profiling is not supported on this platform."
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::atexit(WriteProfile);
+  }
+
+  if (allocations_path)
+  {
+    if (!allocation_tracker.Start())
+    {
+      std::cerr << "Interpreter has been built without allocation tracking."
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    std::atexit(WriteAllocations);
+  }
+
+  if (print_statistics)
+  {
+#if defined(SNEK_ENABLE_STATISTICS)
+    statistics_runtime = &runtime;
+    std::atexit(PrintStatistics);
+#else
+    std::cerr << "Interpreter has been built without execution counters."
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+#endif
+  }
+
   // Define the magic variable used to detect whether an module is being
   // imported or not.
   scope->DeclareVariable(
@@ -222,7 +464,11 @@ main(int argc, char** argv)
     snek::interpreter::value::String::Make(U"__main__")
   );
 
-  if (!inline_scripts.empty())
+  if (modules_to_compile)
+  {
+    CompileModules(runtime);
+  }
+  else if (!inline_scripts.empty())
   {
     for (const auto& inline_script : inline_scripts)
     {
@@ -240,5 +486,11 @@ main(int argc, char** argv)
     RunScript(runtime, scope, U"<stdin>", ReadStream(std::cin));
   }
 
+  WriteProfile();
+  WriteAllocations();
+#if defined(SNEK_ENABLE_STATISTICS)
+  PrintStatistics();
+#endif
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+#include "snek/macros.hpp"
+#include "snek/position.hpp"
+
+namespace snek::interpreter::value
+{
+  enum class Kind;
+}
+
+namespace snek::interpreter
+{
+  /**
+   * Heap profiler which attributes values created by the interpreter to the
+   * position in source code that was being evaluated when the value was
+   * created. Lists, records, strings, functions bound to values, boxed
+   * numbers and scopes are tracked.
+   *
+   * Tracker is bound to the thread which started it, and allocations made
+   * by other threads, such as workers of parallel list operations, are not
+   * attributed to it. Sizes are approximations of the memory held by the
+   * object itself and it's elements; reference counting overhead and memory
+   * held by nested values are not included. Allocations are only tracked
+   * when the interpreter has been built with SNEK_ENABLE_ALLOCATION_TRACKING.
+   */
+  class AllocationTracker final
+  {
+  public:
+    using counter_type = std::uint64_t;
+
+    struct Counter
+    {
+      /** Number of objects created. */
+      counter_type count = 0;
+      /** Approximate number of bytes allocated for the objects. */
+      counter_type bytes = 0;
+    };
+
+    /** Number of tracked object kinds; value kinds followed by scopes. */
+    static constexpr std::size_t kKindCount = 9;
+
+    using site_key_type = std::tuple<const std::u32string*, int, int>;
+
+    struct Site
+    {
+      std::shared_ptr<const std::u32string> filename;
+      std::array<Counter, kKindCount> counters;
+    };
+
+    DISALLOW_COPY_AND_ASSIGN(AllocationTracker);
+
+    explicit AllocationTracker();
+
+    ~AllocationTracker();
+
+    /**
+     * Begins attributing allocations made by the calling thread into this
+     * tracker. Returns false if allocation tracking has not been built into
+     * the interpreter, or if the thread is already being tracked.
+     */
+    bool Start();
+
+    /**
+     * Stops tracking allocations. Must be called from the thread which
+     * started the tracker.
+     */
+    void Stop();
+
+    inline bool running() const
+    {
+      return m_running;
+    }
+
+    /**
+     * Returns total number of values of given kind created while the
+     * tracker has been running.
+     */
+    Counter total(value::Kind kind) const;
+
+    /**
+     * Returns total number of scopes created while the tracker has been
+     * running.
+     */
+    Counter scope_total() const;
+
+    /**
+     * Writes human readable report of the allocations into given stream;
+     * totals by kind of object followed by allocation sites, sorted by the
+     * number of bytes allocated in descending order.
+     */
+    void WriteTable(std::ostream& output) const;
+
+    /**
+     * Discards all allocations tracked so far.
+     */
+    void Clear();
+
+    /**
+     * Records creation of a value of given kind and size into the tracker
+     * running in the current thread, if there is one.
+     */
+    static void Track(value::Kind kind, std::size_t bytes);
+
+    /**
+     * Records creation of a scope into the tracker running in the current
+     * thread, if there is one.
+     */
+    static void TrackScope();
+
+    /**
+     * Returns the current allocation site of this thread. Tasks save and
+     * restore it when they switch between stacks.
+     */
+    static inline const std::optional<Position>* site()
+    {
+      return s_position;
+    }
+
+    static inline void set_site(const std::optional<Position>* position)
+    {
+      s_position = position;
+    }
+
+    /**
+     * Makes the position of a node the allocation site of values created
+     * while the node is being evaluated.
+     */
+    class SiteScope final
+    {
+    public:
+      DISALLOW_COPY_AND_ASSIGN(SiteScope);
+
+      explicit SiteScope(const std::optional<Position>& position)
+        : m_previous(s_position)
+      {
+        s_position = &position;
+      }
+
+      ~SiteScope()
+      {
+        s_position = m_previous;
+      }
+
+    private:
+      const std::optional<Position>* m_previous;
+    };
+
+  private:
+    void Add(std::size_t index, std::size_t bytes);
+
+  private:
+    static inline thread_local const std::optional<Position>* s_position =
+      nullptr;
+    bool m_running;
+    std::map<site_key_type, Site> m_sites;
+  };
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+
+#include "snek/interpreter/value.hpp"
+
+namespace snek::interpreter
+{
+  class Runtime;
+}
+
+namespace snek::interpreter::json
+{
+  /**
+   * Parses given UTF-8 encoded JSON text directly into Snek values. Objects
+   * become records and arrays become lists. Numbers without fraction or
+   * exponent which fit into 64 bits become ints and all other numbers become
+   * floats. Error is thrown if the input is not valid JSON.
+   */
+  value::ptr
+  Parse(Runtime& runtime, const std::string& input);
+
+  /**
+   * Converts given value into JSON text, which is appended to the given
+   * buffer. Error is thrown if the value contains functions or is nested
+   * too deeply.
+   */
+  void
+  Stringify(
+    const Runtime& runtime,
+    const value::ptr& value,
+    std::u32string& output
+  );
+}
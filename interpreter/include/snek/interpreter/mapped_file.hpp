@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+
+#include "snek/macros.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Read only view to contents of an file. Memory mapped when supported by
+   * the platform, otherwise the contents are read into memory.
+   */
+  class MappedFile final
+  {
+  public:
+    DISALLOW_COPY_AND_ASSIGN(MappedFile);
+
+    /**
+     * Maps given file into memory. If the file cannot be opened or it's
+     * empty, data() will return null pointer.
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    inline const char* data() const
+    {
+      return m_data;
+    }
+
+    inline std::size_t size() const
+    {
+      return m_size;
+    }
+
+  private:
+    const char* m_data;
+    std::size_t m_size;
+#if defined(_WIN32)
+    std::string m_storage;
+#endif
+  };
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "snek/interpreter/thread_pool.hpp"
+#include "snek/parser/statement.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Module read from the filesystem, but not yet executed.
+   */
+  struct LoadedModule
+  {
+    /**
+     * Source code of the module, if it had to be read. Null if the module
+     * could not be found, or if it was loaded from an compiled module file.
+     */
+    std::optional<std::string> source;
+    /**
+     * Parsed statements of the module. Null if the module could not be found
+     * or if it contains syntax errors.
+     */
+    std::optional<std::vector<parser::statement::ptr>> statements;
+    /**
+     * Set when the module was parsed from source, but writing of it's
+     * compiled module file was deferred.
+     */
+    std::optional<std::uint64_t> source_size;
+    std::int64_t source_mtime = 0;
+    std::uint64_t source_hash = 0;
+  };
+
+  /**
+   * Reads and parses module from the filesystem, using compiled module file
+   * when one is available. Does not touch any runtime state, so it can be
+   * called from any thread.
+   *
+   * If the module has to be parsed from source, it's compiled module file is
+   * written unless `write_compiled` is false, in which case it can be
+   * written later with WriteCompiledModule().
+   */
+  LoadedModule LoadFilesystemModule(
+    const std::u32string& path,
+    bool write_compiled = true
+  );
+
+  /**
+   * Writes compiled module file for module whose writing was deferred by
+   * LoadFilesystemModule(). Does nothing if there is nothing to write.
+   */
+  void WriteCompiledModule(const std::u32string& path, LoadedModule& module);
+
+  /**
+   * Loads and parses modules in background threads before they are imported.
+   * Once an module has been loaded, modules imported by it's top level import
+   * statements are prefetched as well, so the whole dependency graph of an
+   * program ends up being loaded in parallel while the main thread executes.
+   *
+   * Modules are loaded on a thread pool which is shared with other
+   * prefetchers. Modules which are still waiting to be loaded when the
+   * prefetcher is destroyed are not loaded at all. Compiled module files of
+   * prefetched modules are only written once the module is actually loaded
+   * with Load().
+   */
+  class ModulePrefetcher final
+  {
+  public:
+    DISALLOW_COPY_AND_ASSIGN(ModulePrefetcher);
+
+    explicit ModulePrefetcher(ThreadPool& pool = ThreadPool::Shared());
+
+    /**
+     * Schedules module with given path to be loaded, unless it has already
+     * been requested.
+     */
+    void Prefetch(const std::u32string& path);
+
+    /**
+     * Schedules modules referenced by top level import statements of given
+     * statements to be loaded.
+     */
+    void Prefetch(const std::vector<parser::statement::ptr>& statements);
+
+    /**
+     * Returns module with given path. If the module has been prefetched, waits
+     * for the background thread to finish loading it. If it has not been
+     * picked up by any background thread yet, or it has not been requested at
+     * all, the module is loaded in the calling thread instead.
+     */
+    LoadedModule Load(const std::u32string& path);
+
+  private:
+    struct Entry
+    {
+      std::atomic<bool> claimed{false};
+      std::promise<LoadedModule> promise;
+    };
+
+    /**
+     * State of the prefetcher shared with it's queued tasks, which only
+     * hold a weak reference to it.
+     */
+    struct State
+    {
+      std::mutex mutex;
+      std::unordered_set<std::u32string> requested;
+      std::unordered_map<std::u32string, std::shared_ptr<Entry>> pending;
+    };
+
+    static void Prefetch(
+      ThreadPool& pool,
+      const std::shared_ptr<State>& state,
+      const std::u32string& path
+    );
+
+    static void Prefetch(
+      ThreadPool& pool,
+      const std::shared_ptr<State>& state,
+      const std::vector<parser::statement::ptr>& statements
+    );
+
+    ThreadPool& m_pool;
+    const std::shared_ptr<State> m_state;
+  };
+}
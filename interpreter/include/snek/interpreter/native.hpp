@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/type.hpp"
+
+/**
+ * Binding of strongly typed C++ functions as native functions of Snek.
+ *
+ * Types of the parameters and the return value of the native function are
+ * derived from signature of the C++ function, and conversions between Snek
+ * values and C++ values are resolved at compile time. Calls go directly to
+ * the C++ function, instead of through std::function, without the argument
+ * vector being copied.
+ *
+ *     static std::int64_t
+ *     Add(std::int64_t a, std::int64_t b)
+ *     {
+ *       return a + b;
+ *     }
+ *
+ *     native::Bind<Add>(builtins, { { U"a" }, { U"b" } });
+ *
+ * If first parameter of the C++ function is a reference to the runtime, the
+ * runtime which calls the function is given to it. Supported C++ types are:
+ *
+ * - bool, which maps to Boolean.
+ * - std::int64_t, which maps to Int.
+ * - double, which maps to Number. Ints given as arguments are converted into
+ *   floating point numbers.
+ * - std::u32string, which maps to String.
+ * - value::ptr, which maps to any.
+ * - Shared pointers to value::List, value::Record, value::Function and
+ *   value::String, which map to List, Record, Function and String.
+ * - std::optional of any of the above, which maps to optional type where
+ *   null converts into std::nullopt and vice versa.
+ * - void as the return type, which maps to void and returns null.
+ *
+ * Rest parameters are not supported; use value::Function::MakeNative for
+ * such functions.
+ */
+namespace snek::interpreter::native
+{
+  /**
+   * Name and optional default value of a parameter of a bound function. Type
+   * of the parameter comes from the C++ function.
+   */
+  struct Parameter
+  {
+    std::u32string name;
+    parser::expression::ptr default_value = nullptr;
+  };
+
+  /**
+   * Conversion between Snek values and values of C++ type T.
+   */
+  template<class T>
+  struct Traits;
+
+  template<>
+  struct Traits<value::ptr>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->any_type();
+    }
+
+    static inline bool Is(const value::ptr&)
+    {
+      return true;
+    }
+
+    static inline const value::ptr& From(const value::ptr& value)
+    {
+      return value;
+    }
+
+    static inline value::ptr To(Runtime&, value::ptr value)
+    {
+      return value;
+    }
+  };
+
+  template<>
+  struct Traits<bool>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->boolean_type();
+    }
+
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::IsBoolean(value);
+    }
+
+    static inline bool From(const value::ptr& value)
+    {
+      return static_cast<const value::Boolean*>(value.get())->value;
+    }
+
+    static inline value::ptr To(Runtime& runtime, bool value)
+    {
+      return runtime.MakeBoolean(value);
+    }
+  };
+
+  template<>
+  struct Traits<std::int64_t>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->int_type();
+    }
+
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::IsInt(value);
+    }
+
+    static inline std::int64_t From(const value::ptr& value)
+    {
+      return static_cast<const value::Int*>(value.get())->value;
+    }
+
+    static inline value::ptr To(Runtime& runtime, std::int64_t value)
+    {
+      return runtime.MakeInt(value);
+    }
+  };
+
+  template<>
+  struct Traits<double>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->number_type();
+    }
+
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::IsNumber(value);
+    }
+
+    static inline double From(const value::ptr& value)
+    {
+      return static_cast<const value::Number*>(value.get())->ToFloat();
+    }
+
+    static inline value::ptr To(Runtime&, double value)
+    {
+      return std::make_shared<value::Float>(value);
+    }
+  };
+
+  template<>
+  struct Traits<std::u32string>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->string_type();
+    }
+
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::IsString(value);
+    }
+
+    static inline std::u32string From(const value::ptr& value)
+    {
+      return value->ToString();
+    }
+
+    static inline value::ptr To(Runtime&, const std::u32string& value)
+    {
+      return value::String::Make(value);
+    }
+  };
+
+  /**
+   * Conversion for shared pointers to values of certain kind, which are
+   * passed through as they are.
+   */
+  template<class T, value::Kind K>
+  struct PointerTraits
+  {
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::KindOf(value) == K;
+    }
+
+    static inline std::shared_ptr<T> From(const value::ptr& value)
+    {
+      return std::static_pointer_cast<T>(value);
+    }
+
+    static inline value::ptr To(Runtime&, std::shared_ptr<T> value)
+    {
+      return value;
+    }
+  };
+
+  template<>
+  struct Traits<std::shared_ptr<value::List>>
+    : PointerTraits<value::List, value::Kind::List>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->list_type();
+    }
+  };
+
+  template<>
+  struct Traits<std::shared_ptr<value::Record>>
+    : PointerTraits<value::Record, value::Kind::Record>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->record_type();
+    }
+  };
+
+  template<>
+  struct Traits<std::shared_ptr<value::Function>>
+    : PointerTraits<value::Function, value::Kind::Function>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->function_type();
+    }
+  };
+
+  template<>
+  struct Traits<std::shared_ptr<value::String>>
+    : PointerTraits<value::String, value::Kind::String>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return builtins->string_type();
+    }
+  };
+
+  template<class T>
+  struct Traits<std::optional<T>>
+  {
+    static inline type::ptr Type(const Builtins* builtins)
+    {
+      return type::MakeOptional(Traits<T>::Type(builtins));
+    }
+
+    static inline bool Is(const value::ptr& value)
+    {
+      return value::IsNull(value) || Traits<T>::Is(value);
+    }
+
+    static inline std::optional<T> From(const value::ptr& value)
+    {
+      if (value::IsNull(value))
+      {
+        return std::nullopt;
+      }
+
+      return Traits<T>::From(value);
+    }
+
+    static inline value::ptr To(Runtime& runtime, std::optional<T> value)
+    {
+      if (!value)
+      {
+        return nullptr;
+      }
+
+      return Traits<T>::To(runtime, std::move(*value));
+    }
+  };
+
+  /**
+   * Decomposes signature of a C++ function into it's return type and types
+   * of it's parameters, excluding the optional runtime parameter.
+   */
+  template<class F>
+  struct Signature;
+
+  template<class R, class... Args>
+  struct Signature<R(*)(Args...)>
+  {
+    using return_type = R;
+    using argument_types = std::tuple<std::decay_t<Args>...>;
+    static constexpr bool takes_runtime = false;
+  };
+
+  template<class R, class... Args>
+  struct Signature<R(*)(Runtime&, Args...)>
+  {
+    using return_type = R;
+    using argument_types = std::tuple<std::decay_t<Args>...>;
+    static constexpr bool takes_runtime = true;
+  };
+
+  /**
+   * Returns value of parameter which was not given an argument, by evaluating
+   * it's default value, or throws an error if the parameter has no default
+   * value.
+   */
+  value::ptr GetDefaultArgument(
+    Runtime& runtime,
+    const interpreter::Parameter& parameter
+  );
+
+  [[noreturn]] void ThrowArgumentError(
+    Runtime& runtime,
+    const interpreter::Parameter& parameter,
+    const value::ptr& argument
+  );
+
+  template<auto Callback>
+  class TypedFunction final : public value::Function
+  {
+  public:
+    using signature_type = Signature<decltype(Callback)>;
+    using result_type = typename signature_type::return_type;
+    using argument_types = typename signature_type::argument_types;
+
+    static constexpr std::size_t kArity = std::tuple_size_v<argument_types>;
+
+    explicit TypedFunction(
+      const Builtins* builtins,
+      const Parameter* parameters
+    )
+      : value::Function()
+      , m_parameters(
+          MakeParameters(
+            builtins,
+            parameters,
+            std::make_index_sequence<kArity>()
+          )
+        )
+      , m_return_type(MakeReturnType(builtins)) {}
+
+    inline const std::vector<interpreter::Parameter>& parameters()
+      const override
+    {
+      return m_parameters;
+    }
+
+    inline const type::ptr& return_type() const override
+    {
+      return m_return_type;
+    }
+
+  protected:
+    value::ptr
+    Call(
+      Runtime& runtime,
+      const std::vector<value::ptr>& arguments,
+      const std::optional<Position>&
+    ) const override
+    {
+#if defined(SNEK_ENABLE_STATISTICS)
+      ++runtime.statistics().native_calls;
+#endif
+
+      return Invoke(
+        runtime,
+        arguments,
+        std::make_index_sequence<kArity>()
+      );
+    }
+
+  private:
+    template<std::size_t... I>
+    static std::vector<interpreter::Parameter>
+    MakeParameters(
+      const Builtins* builtins,
+      const Parameter* parameters,
+      std::index_sequence<I...>
+    )
+    {
+      return {
+        {
+          parameters[I].name,
+          Traits<std::tuple_element_t<I, argument_types>>::Type(builtins),
+          parameters[I].default_value
+        }...
+      };
+    }
+
+    static type::ptr
+    MakeReturnType(const Builtins* builtins)
+    {
+      if constexpr (std::is_void_v<result_type>)
+      {
+        return builtins->void_type();
+      } else {
+        return Traits<std::decay_t<result_type>>::Type(builtins);
+      }
+    }
+
+    template<std::size_t I>
+    std::tuple_element_t<I, argument_types>
+    Convert(
+      Runtime& runtime,
+      const std::vector<value::ptr>& arguments
+    ) const
+    {
+      using traits = Traits<std::tuple_element_t<I, argument_types>>;
+      const auto& parameter = m_parameters[I];
+
+      if (I < arguments.size())
+      {
+        const auto& argument = arguments[I];
+
+        if (!traits::Is(argument))
+        {
+          ThrowArgumentError(runtime, parameter, argument);
+        }
+
+        return traits::From(argument);
+      }
+
+      const auto argument = GetDefaultArgument(runtime, parameter);
+
+      if (!traits::Is(argument))
+      {
+        ThrowArgumentError(runtime, parameter, argument);
+      }
+
+      return traits::From(argument);
+    }
+
+    template<std::size_t... I>
+    value::ptr
+    Invoke(
+      Runtime& runtime,
+      const std::vector<value::ptr>& arguments,
+      std::index_sequence<I...>
+    ) const
+    {
+      // Braced initialization converts the arguments from left to right.
+      argument_types converted{ Convert<I>(runtime, arguments)... };
+
+      if constexpr (std::is_void_v<result_type>)
+      {
+        Apply(runtime, std::move(converted));
+
+        return nullptr;
+      } else {
+        return Traits<std::decay_t<result_type>>::To(
+          runtime,
+          Apply(runtime, std::move(converted))
+        );
+      }
+    }
+
+    static inline result_type
+    Apply(Runtime& runtime, argument_types&& arguments)
+    {
+      if constexpr (signature_type::takes_runtime)
+      {
+        return std::apply(
+          [&runtime](auto&&... args) -> result_type
+          {
+            return Callback(runtime, std::move(args)...);
+          },
+          std::move(arguments)
+        );
+      } else {
+        return std::apply(Callback, std::move(arguments));
+      }
+    }
+
+  private:
+    const std::vector<interpreter::Parameter> m_parameters;
+    const type::ptr m_return_type;
+  };
+
+  /**
+   * Binds given C++ function as native function, whose parameters have the
+   * given names and default values. Number of the names must match number of
+   * parameters of the C++ function.
+   */
+  template<auto Callback, std::size_t N>
+  std::shared_ptr<value::Function>
+  Bind(const Builtins* builtins, const Parameter (&parameters)[N])
+  {
+    static_assert(
+      N == TypedFunction<Callback>::kArity,
+      "Number of parameter names does not match the function."
+    );
+
+    return std::make_shared<TypedFunction<Callback>>(builtins, parameters);
+  }
+
+  template<auto Callback>
+  std::shared_ptr<value::Function>
+  Bind(const Builtins* builtins)
+  {
+    static_assert(
+      TypedFunction<Callback>::kArity == 0,
+      "Number of parameter names does not match the function."
+    );
+
+    return std::make_shared<TypedFunction<Callback>>(builtins, nullptr);
+  }
+}
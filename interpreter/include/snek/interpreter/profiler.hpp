@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "snek/interpreter/frame.hpp"
+#include "snek/macros.hpp"
+
+namespace snek::interpreter
+{
+  class Runtime;
+
+  /**
+   * Sampling profiler which periodically records the call stack of a
+   * runtime. A timer signal marks a sample as pending, and the runtime takes
+   * the sample on its next function call, as the call stack cannot be
+   * safely inspected from within a signal handler. Samples are written into
+   * lock free ring buffer from which they are aggregated into call stack
+   * counts.
+   *
+   * Only one profiler can be running in a process at a time, and profiling
+   * is only supported on POSIX platforms. Profiling has to be started and
+   * stopped from the thread which runs the profiled runtime, but samples can
+   * be read from any thread. Worker contexts of parallel operations share
+   * the profiler of their runtime, so samples may be taken from any thread
+   * as well.
+   */
+  class Profiler final
+  {
+  public:
+    using interval_type = std::chrono::microseconds;
+    using count_container_type = std::unordered_map<std::string, std::size_t>;
+
+    /** Maximum number of samples held in the ring buffer. */
+    static constexpr std::size_t kBufferSize = 256;
+    /** Maximum number of innermost frames recorded in a sample. */
+    static constexpr std::size_t kMaxDepth = 64;
+
+    DISALLOW_COPY_AND_ASSIGN(Profiler);
+
+    explicit Profiler();
+
+    ~Profiler();
+
+    /**
+     * Begins sampling call stack of given runtime at given interval of
+     * consumed processor time. Returns false if profiling could not be
+     * started.
+     */
+    bool Start(
+      Runtime& runtime,
+      const interval_type& interval = interval_type(1000)
+    );
+
+    /**
+     * Stops sampling and aggregates samples remaining in the buffer.
+     */
+    void Stop();
+
+    inline bool running() const
+    {
+      return m_runtime != nullptr;
+    }
+
+    /**
+     * Returns number of samples which were discarded because the buffer was
+     * full.
+     */
+    inline std::size_t dropped() const
+    {
+      return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns number of times each call stack has been sampled. Call stacks
+     * are given as frames separated with semicolons, outermost frame first.
+     */
+    count_container_type counts();
+
+    /**
+     * Writes the samples in collapsed stack format used by flame graph
+     * tools.
+     */
+    void WriteFolded(std::ostream& output);
+
+    /**
+     * Discards all samples taken so far.
+     */
+    void Clear();
+
+    /**
+     * Takes a sample of the runtime's call stack if one has been requested
+     * by the timer. Called by the runtime whenever a function is called.
+     */
+    inline void Poll(const Runtime& runtime)
+    {
+      if (
+        m_sample_pending.load(std::memory_order_relaxed) &&
+        m_sample_pending.exchange(false, std::memory_order_relaxed)
+      )
+      {
+        TakeSample(runtime);
+      }
+    }
+
+  private:
+    struct Sample
+    {
+      std::size_t depth;
+      bool truncated;
+      Frame frames[kMaxDepth];
+    };
+
+    static void HandleSignal(int);
+
+    void TakeSample(const Runtime& runtime);
+
+    void Drain();
+
+  private:
+    Runtime* m_runtime;
+    std::atomic<bool> m_sample_pending;
+    /** Set while some thread is writing a sample into the buffer. */
+    std::atomic<bool> m_sampling;
+    std::unique_ptr<Sample[]> m_buffer;
+    std::atomic<std::size_t> m_head;
+    std::atomic<std::size_t> m_tail;
+    std::atomic<std::size_t> m_dropped;
+    std::mutex m_drain_mutex;
+    count_container_type m_counts;
+  };
+}
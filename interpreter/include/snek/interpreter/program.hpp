@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "snek/parser/statement.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Parsed form of a script, returned by Runtime::Compile. Program is
+   * immutable, so it can be executed any number of times, in any scope and
+   * by any runtime, including runtimes in different threads, without
+   * parsing the source code again.
+   */
+  class Program final
+  {
+  public:
+    using ptr = std::shared_ptr<const Program>;
+    using statement_container_type = std::vector<parser::statement::ptr>;
+
+    DISALLOW_COPY_AND_ASSIGN(Program);
+
+    explicit Program(
+      const std::u32string& filename,
+      int line,
+      int column,
+      statement_container_type statements
+    )
+      : m_filename(filename)
+      , m_line(line)
+      , m_column(column)
+      , m_statements(std::move(statements)) {}
+
+    inline const std::u32string& filename() const
+    {
+      return m_filename;
+    }
+
+    inline int line() const
+    {
+      return m_line;
+    }
+
+    inline int column() const
+    {
+      return m_column;
+    }
+
+    inline const statement_container_type& statements() const
+    {
+      return m_statements;
+    }
+
+  private:
+    const std::u32string m_filename;
+    const int m_line;
+    const int m_column;
+    const statement_container_type m_statements;
+  };
+}
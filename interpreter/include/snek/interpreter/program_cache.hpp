@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "snek/interpreter/program.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Bounded cache of programs compiled from source code given to the eval
+   * builtin, keyed by the source code. When the cache is full, inserting a
+   * new entry evicts the least recently used one.
+   *
+   * The cache is not synchronized; each runtime has one of it's own.
+   */
+  class ProgramCache final
+  {
+  public:
+    static constexpr std::size_t kCapacity = 256;
+
+    /**
+     * Source code longer than this is not cached, so that a script which
+     * evaluates large one-off strings does not fill the memory with them.
+     */
+    static constexpr std::size_t kMaxSourceLength = 4096;
+
+    DISALLOW_COPY_AND_ASSIGN(ProgramCache);
+
+    explicit ProgramCache(std::size_t capacity = kCapacity);
+
+    /**
+     * Returns number of entries currently stored in the cache.
+     */
+    inline std::size_t size() const
+    {
+      return m_entries.size();
+    }
+
+    inline std::size_t capacity() const
+    {
+      return m_capacity;
+    }
+
+    /**
+     * Returns number of lookups which found a program from the cache.
+     */
+    inline std::size_t hits() const
+    {
+      return m_hits;
+    }
+
+    /**
+     * Returns number of lookups which did not find a program from the cache.
+     */
+    inline std::size_t misses() const
+    {
+      return m_misses;
+    }
+
+    /**
+     * Looks for a program compiled from given source code and marks it as
+     * the most recently used one. Returns null pointer if the cache does not
+     * contain such program.
+     */
+    Program::ptr Find(const std::u32string& source);
+
+    /**
+     * Stores program compiled from given source code, unless the source code
+     * is too long to be cached.
+     */
+    void Insert(const std::u32string& source, const Program::ptr& program);
+
+    /**
+     * Removes all entries from the cache and resets the counters.
+     */
+    void Clear();
+
+  private:
+    struct Entry
+    {
+      std::u32string source;
+      Program::ptr program;
+    };
+    using entry_container_type = std::list<Entry>;
+
+  private:
+    const std::size_t m_capacity;
+    entry_container_type m_entries;
+    std::unordered_map<
+      std::u32string_view,
+      entry_container_type::iterator
+    > m_index;
+    std::size_t m_hits;
+    std::size_t m_misses;
+  };
+}
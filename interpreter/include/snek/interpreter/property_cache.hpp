@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "snek/interpreter/value.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Fixed size cache of property lookups made through prototype chains,
+   * keyed by the prototype where the lookup started and the name of the
+   * property. Each (prototype, name) pair maps into a single slot of the
+   * cache, so inserting a new entry evicts whatever was stored in that slot
+   * before.
+   *
+   * Storage for the cache is allocated when the first entry is inserted. The
+   * cache is not synchronized; each runtime has one of it's own.
+   */
+  class PropertyCache final
+  {
+  public:
+    static constexpr std::size_t kSize = 512;
+
+    DEFAULT_COPY_AND_ASSIGN(PropertyCache);
+
+    explicit PropertyCache();
+
+    /**
+     * Returns number of entries currently stored in the cache.
+     */
+    inline std::size_t size() const
+    {
+      return m_size;
+    }
+
+    std::optional<value::ptr> Find(
+      const value::ptr& prototype,
+      const std::u32string& name
+    ) const;
+
+    /**
+     * Stores result of property lookup which started from given prototype
+     * and found the property from holder, which is either the prototype
+     * itself or one of it's ancestors.
+     */
+    void Insert(
+      const value::ptr& prototype,
+      const std::u32string& name,
+      const value::ptr& holder,
+      const value::ptr& property
+    );
+
+    /**
+     * Removes all entries whose lookup either started from given prototype
+     * or found the property from it.
+     */
+    void Invalidate(const value::ptr& prototype);
+
+    /**
+     * Removes all entries from the cache.
+     */
+    void Clear();
+
+  private:
+    struct Entry
+    {
+      value::ptr prototype;
+      std::u32string name;
+      value::ptr holder;
+      value::ptr property;
+    };
+
+    std::size_t IndexOf(
+      const value::ptr& prototype,
+      const std::u32string& name
+    ) const;
+
+  private:
+    std::vector<Entry> m_entries;
+    std::size_t m_size;
+  };
+}
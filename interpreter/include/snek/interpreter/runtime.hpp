@@ -25,25 +25,50 @@
  */
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <random>
+
+#include "snek/interpreter/builtins.hpp"
 #include "snek/interpreter/config.hpp"
 #include "snek/interpreter/error.hpp"
+#include "snek/interpreter/program.hpp"
+#include "snek/interpreter/program_cache.hpp"
+#include "snek/interpreter/property_cache.hpp"
 #include "snek/interpreter/scope.hpp"
+#include "snek/interpreter/statistics.hpp"
 
 namespace snek::interpreter
 {
+  class ModulePrefetcher;
+  class Profiler;
+  class Task;
+  class WorkStealingPool;
+
   Scope::ptr
   ImportFilesystemModule(
     Runtime& runtime,
     const std::u32string& path
   );
 
+  /**
+   * Parses module from given source file and writes it's syntax tree into a
+   * compiled module file next to the source file, from which later imports
+   * of the module can load it without having to parse the source code again.
+   */
+  void
+  CompileFilesystemModule(
+    Runtime& runtime,
+    const std::u32string& path
+  );
+
   class Runtime
   {
   public:
 #if defined(SNEK_ENABLE_INT_CACHE)
-    static constexpr std::int64_t kIntCacheMin = -5;
-    static constexpr std::int64_t kIntCacheMax = 256;
-    static constexpr std::size_t kIntCacheSize = -kIntCacheMin + kIntCacheMax;
+    static constexpr std::int64_t kIntCacheMin = Builtins::kIntCacheMin;
+    static constexpr std::int64_t kIntCacheMax = Builtins::kIntCacheMax;
+    static constexpr std::size_t kIntCacheSize = Builtins::kIntCacheSize;
 #endif
 
     using call_stack_type = std::stack<Frame>;
@@ -57,8 +82,34 @@ namespace snek::interpreter
       std::u32string,
       Scope::ptr
     >;
+    using random_generator_type = std::mt19937_64;
+    using clock_type = std::chrono::steady_clock;
+
+    /**
+     * Limits how much work scripts executed by the runtime may do before
+     * they are aborted with an error.
+     */
+    struct Budget
+    {
+      /**
+       * Number of loop iterations and function calls allowed, or no limit
+       * if empty.
+       */
+      std::optional<std::uint64_t> fuel;
+      /**
+       * Point in time after which execution is aborted, or no deadline if
+       * empty.
+       */
+      std::optional<clock_type::time_point> deadline;
+    };
 
-    DEFAULT_COPY_AND_ASSIGN(Runtime);
+    /**
+     * Deadline is checked only on every this many checkpoints, as reading
+     * the clock is relatively expensive.
+     */
+    static constexpr std::uint32_t kDeadlineCheckInterval = 64;
+
+    DISALLOW_COPY_AND_ASSIGN(Runtime);
 
     Runtime(
       const module_importer_type& module_importer = ImportFilesystemModule
@@ -66,97 +117,110 @@ namespace snek::interpreter
 
     inline const type::ptr& any_type() const
     {
-      return m_any_type;
+      return m_builtins->any_type();
     }
 
     inline const type::ptr& boolean_type() const
     {
-      return m_boolean_type;
+      return m_builtins->boolean_type();
     }
 
     inline const type::ptr& float_type() const
     {
-      return m_float_type;
+      return m_builtins->float_type();
     }
 
     inline const type::ptr& function_type() const
     {
-      return m_function_type;
+      return m_builtins->function_type();
     }
 
     inline const type::ptr& int_type() const
     {
-      return m_int_type;
+      return m_builtins->int_type();
     }
 
     inline const type::ptr& list_type() const
     {
-      return m_list_type;
+      return m_builtins->list_type();
     }
 
     inline const type::ptr& number_type() const
     {
-      return m_number_type;
+      return m_builtins->number_type();
     }
 
     inline const type::ptr& record_type() const
     {
-      return m_record_type;
+      return m_builtins->record_type();
     }
 
     inline const type::ptr& string_type() const
     {
-      return m_string_type;
+      return m_builtins->string_type();
     }
 
     inline const type::ptr& void_type() const
     {
-      return m_void_type;
+      return m_builtins->void_type();
     }
 
     inline const value::ptr& boolean_prototype() const
     {
-      return m_boolean_prototype;
+      return m_builtins->boolean_prototype();
     }
 
     inline const value::ptr& float_prototype() const
     {
-      return m_float_prototype;
+      return m_builtins->float_prototype();
     }
 
     inline const value::ptr& function_prototype() const
     {
-      return m_function_prototype;
+      return m_builtins->function_prototype();
     }
 
     inline const value::ptr& int_prototype() const
     {
-      return m_int_prototype;
+      return m_builtins->int_prototype();
     }
 
     inline const value::ptr& list_prototype() const
     {
-      return m_list_prototype;
+      return m_builtins->list_prototype();
     }
 
     inline const value::ptr& number_prototype() const
     {
-      return m_number_prototype;
+      return m_builtins->number_prototype();
     }
 
     inline const value::ptr& object_prototype() const
     {
-      return m_object_prototype;
+      return m_builtins->object_prototype();
     }
 
     inline const value::ptr& record_prototype() const
     {
-      return m_record_prototype;
+      return m_builtins->record_prototype();
     }
 
     inline const value::ptr& string_prototype() const
     {
-      return m_string_prototype;
+      return m_builtins->string_prototype();
+    }
+
+    inline const value::ptr& sequence_prototype() const
+    {
+      return m_builtins->sequence_prototype();
+    }
+
+    /**
+     * Returns the process wide builtins used by the runtime.
+     */
+    inline const Builtins& builtins() const
+    {
+      return *m_builtins;
     }
 
     inline const Scope::ptr& root_scope() const
@@ -177,7 +241,7 @@ namespace snek::interpreter
     inline value::ptr MakeBoolean(bool value)
     {
 #if defined(SNEK_ENABLE_BOOLEAN_CACHE)
-      return value ? m_true_value : m_false_value;
+      return m_builtins->MakeBoolean(value);
 #else
       return std::make_shared<value::Boolean>(value);
 #endif
@@ -194,6 +258,14 @@ namespace snek::interpreter
 
     value::ptr MakeInt(std::int64_t value);
 
+    /**
+     * Returns random number generator of the runtime, which is seeded when
+     * this method is called for the first time. Each runtime has generator of
+     * it's own so that runtimes running in different threads do not have to
+     * share one.
+     */
+    random_generator_type& random_generator();
+
     value::ptr RunScript(
       const Scope::ptr& scope,
       const std::string& source,
@@ -210,29 +282,206 @@ namespace snek::interpreter
       int column = 1
     );
 
+    /**
+     * Parses given source code into a program, which can then be executed
+     * with Run() any number of times without parsing it again. Syntax errors
+     * are thrown as errors of the runtime.
+     */
+    Program::ptr Compile(
+      const std::string& source,
+      const std::u32string& filename = U"<eval>",
+      int line = 1,
+      int column = 1
+    );
+
+    Program::ptr Compile(
+      const std::u32string& source,
+      const std::u32string& filename = U"<eval>",
+      int line = 1,
+      int column = 1
+    );
+
+    /**
+     * Executes previously compiled program in given scope and returns value
+     * of the last statement. Modules imported by top level statements of the
+     * program begin to load in the background right away, when the runtime
+     * imports modules from the filesystem.
+     */
+    value::ptr Run(const Program::ptr& program, const Scope::ptr& scope);
+
+    /**
+     * Executes already parsed statements, such as ones loaded from a compiled
+     * module, in given scope.
+     */
+    value::ptr RunStatements(
+      const Scope::ptr& scope,
+      const std::vector<parser::statement::ptr>& statements,
+      const std::u32string& filename = U"<eval>"
+    );
+
     Scope::ptr ImportModule(const std::u32string& path);
 
+    inline const module_importer_type& module_importer() const
+    {
+      return m_module_importer;
+    }
+
+#if defined(SNEK_ENABLE_PROPERTY_CACHE)
+    /**
+     * Returns cache of property lookups made through prototype chains. The
+     * cache does not affect results of the lookups, so it can be modified
+     * even through a constant reference to the runtime.
+     */
+    inline PropertyCache& property_cache() const
+    {
+      return m_property_cache;
+    }
+#endif
+
+#if defined(SNEK_ENABLE_EVAL_CACHE)
+    /**
+     * Returns cache of programs compiled from source code given to the eval
+     * builtin.
+     */
+    inline ProgramCache& program_cache()
+    {
+      return m_program_cache;
+    }
+#endif
+
+#if defined(SNEK_ENABLE_STATISTICS)
+    /**
+     * Returns execution counters of the runtime. Counting does not affect the
+     * execution, so the counters can be updated even through a constant
+     * reference to the runtime.
+     */
+    inline Statistics& statistics() const
+    {
+      return m_statistics;
+    }
+#endif
+
+    /**
+     * Returns the pool of worker threads used by parallel list operations.
+     * Unless a pool has been set for the runtime, the process wide default
+     * pool is used.
+     */
+    WorkStealingPool& worker_pool();
+
+    inline void set_worker_pool(const std::shared_ptr<WorkStealingPool>& pool)
+    {
+      m_worker_pool = pool;
+    }
+
+    /**
+     * Returns the profiler currently sampling the runtime, or null pointer if
+     * the runtime is not being profiled.
+     */
+    inline Profiler* profiler() const
+    {
+      return m_profiler;
+    }
+
+    inline void set_profiler(Profiler* profiler)
+    {
+      m_profiler = profiler;
+    }
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+    /**
+     * Returns the module prefetcher of the runtime, which is created when
+     * this method is called for the first time.
+     */
+    ModulePrefetcher& module_prefetcher();
+
+    /**
+     * Replaces the module prefetcher of the runtime, for example with one
+     * which loads the modules in a thread pool of it's own.
+     */
+    inline void set_module_prefetcher(
+      const std::shared_ptr<ModulePrefetcher>& module_prefetcher
+    )
+    {
+      m_module_prefetcher = module_prefetcher;
+    }
+#endif
+
+    inline const Budget& budget() const
+    {
+      return m_budget;
+    }
+
+    /**
+     * Replaces the budget of the runtime. See also BudgetScope, which
+     * applies a budget for the duration of a single invocation.
+     */
+    void set_budget(const Budget& budget);
+
+    /**
+     * Requests the script currently being executed by the runtime to be
+     * aborted with an error at the next checkpoint. Unlike everything else
+     * in the runtime, this can be called from any thread.
+     */
+    inline void Interrupt()
+    {
+      m_interrupt_flag->store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the flag which is set when the runtime is interrupted.
+     */
+    inline std::atomic<bool>& interrupt_flag() const
+    {
+      return *m_interrupt_flag;
+    }
+
+    /**
+     * Makes the runtime share interrupt flag of given runtime, so that
+     * interrupting that runtime interrupts this one as well. Used by worker
+     * contexts of parallel operations.
+     */
+    inline void ForwardInterrupts(const Runtime& runtime)
+    {
+      m_interrupt_flag = runtime.m_interrupt_flag;
+    }
+
+    /**
+     * Returns the task currently running in the runtime, or null pointer if
+     * the runtime is not running a task.
+     */
+    inline Task* task() const
+    {
+      return m_task;
+    }
+
+    inline void set_task(Task* task)
+    {
+      m_task = task;
+    }
+
+    /**
+     * Called by the interpreter on every loop iteration and function call.
+     * Throws an error if the budget has been exhausted, the deadline has
+     * passed or an interrupt has been requested. Running task may be
+     * suspended here.
+     */
+    inline void Checkpoint()
+    {
+      if (
+        m_budget_enabled ||
+        m_task ||
+        m_interrupt_flag->load(std::memory_order_relaxed)
+      )
+      {
+        CheckBudget();
+      }
+    }
+
+  private:
+    void CheckBudget();
+
   private:
-    type::ptr m_any_type;
-    type::ptr m_boolean_type;
-    type::ptr m_float_type;
-    type::ptr m_function_type;
-    type::ptr m_int_type;
-    type::ptr m_list_type;
-    type::ptr m_number_type;
-    type::ptr m_record_type;
-    type::ptr m_string_type;
-    type::ptr m_void_type;
-
-    value::ptr m_object_prototype;
-    value::ptr m_number_prototype;
-    value::ptr m_boolean_prototype;
-    value::ptr m_float_prototype;
-    value::ptr m_function_prototype;
-    value::ptr m_int_prototype;
-    value::ptr m_list_prototype;
-    value::ptr m_record_prototype;
-    value::ptr m_string_prototype;
+    const Builtins* m_builtins;
 
     Scope::ptr m_root_scope;
 
@@ -240,13 +489,58 @@ namespace snek::interpreter
 
     module_importer_type m_module_importer;
     module_container_type m_imported_modules;
-
-#if defined(SNEK_ENABLE_BOOLEAN_CACHE)
-    value::ptr m_true_value;
-    value::ptr m_false_value;
+    std::shared_ptr<random_generator_type> m_random_generator;
+    std::shared_ptr<WorkStealingPool> m_worker_pool;
+    Profiler* m_profiler;
+    Budget m_budget;
+    bool m_budget_enabled;
+    std::uint32_t m_deadline_countdown;
+    std::atomic<bool> m_interrupted;
+    std::atomic<bool>* m_interrupt_flag;
+    Task* m_task;
+#if defined(SNEK_ENABLE_PROPERTY_CACHE)
+    mutable PropertyCache m_property_cache;
 #endif
-#if defined(SNEK_ENABLE_INT_CACHE)
-    value::ptr m_int_cache[kIntCacheSize];
+#if defined(SNEK_ENABLE_EVAL_CACHE)
+    ProgramCache m_program_cache;
+#endif
+#if defined(SNEK_ENABLE_STATISTICS)
+    mutable Statistics m_statistics;
 #endif
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+    std::shared_ptr<ModulePrefetcher> m_module_prefetcher;
+#endif
+  };
+
+  /**
+   * Applies a budget to a runtime for the lifetime of the object, for
+   * example for the duration of a single RunScript or Function::Call
+   * invocation. Budgets of enclosing scopes still apply, so the budget can
+   * only be tightened. When the scope ends, the previous budget is restored,
+   * minus the fuel consumed within the scope.
+   */
+  class BudgetScope final
+  {
+  public:
+    DISALLOW_COPY_AND_ASSIGN(BudgetScope);
+
+    explicit BudgetScope(Runtime& runtime, const Runtime::Budget& budget);
+
+    /**
+     * Limits the execution to given amount of fuel and given amount of time
+     * from now.
+     */
+    explicit BudgetScope(
+      Runtime& runtime,
+      const std::optional<std::uint64_t>& fuel,
+      const std::optional<Runtime::clock_type::duration>& timeout
+    );
+
+    ~BudgetScope();
+
+  private:
+    Runtime& m_runtime;
+    Runtime::Budget m_previous;
+    std::optional<std::uint64_t> m_initial_fuel;
   };
 }
@@ -25,11 +25,15 @@
  */
 #pragma once
 
+#include <cstdint>
+
 #include "snek/interpreter/type.hpp"
 #include "snek/interpreter/value.hpp"
 
 namespace snek::interpreter
 {
+  class Builtins;
+
   class Scope
   {
   public:
@@ -58,10 +62,35 @@ namespace snek::interpreter
       TypeDefinition
     >;
 
-    static ptr MakeRootScope(const Runtime* runtime);
+    /**
+     * Marks the current thread as running a callback of a parallel operation
+     * for the lifetime of the object. Scopes created outside of the section
+     * are shared with other threads, so their variables can be read but not
+     * assigned while the section is active.
+     */
+    class ParallelSection final
+    {
+    public:
+      DISALLOW_COPY_AND_ASSIGN(ParallelSection);
+
+      explicit ParallelSection();
+
+      ~ParallelSection();
+
+    private:
+      const std::uint64_t m_previous;
+    };
+
+    static ptr MakeRootScope(const Builtins* builtins);
 
     explicit Scope(const ptr& parent = nullptr)
-      : m_parent(parent) {}
+      : m_parent(parent)
+      , m_parallel_section(s_parallel_section)
+    {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+      AllocationTracker::TrackScope();
+#endif
+    }
 
     std::vector<std::pair<std::u32string, value::ptr>>
     GetExportedVariables() const;
@@ -100,7 +129,11 @@ namespace snek::interpreter
     );
 
   private:
+    /** Parallel section the current thread is in, or zero if none. */
+    static thread_local std::uint64_t s_parallel_section;
+
     ptr m_parent;
+    std::uint64_t m_parallel_section;
     variable_container_type m_variables;
     type_container_type m_types;
   };
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <functional>
+
+#include "snek/interpreter/value.hpp"
+
+namespace snek::interpreter
+{
+  class Runtime;
+}
+
+namespace snek::interpreter::sequence
+{
+  /**
+   * Produces elements of a sequence one at a time. Stores the next element
+   * into the given reference and returns true, or returns false once the
+   * sequence has been exhausted.
+   */
+  using generator_type = std::function<bool(Runtime&, value::ptr&)>;
+
+  /**
+   * Constructs new generator each time the sequence is consumed.
+   */
+  using source_type = std::function<generator_type(Runtime&)>;
+
+  /**
+   * Receives elements of a sequence along with their index. Returns false
+   * to stop consuming the sequence.
+   */
+  using sink_type = std::function<bool(const value::ptr&, std::size_t)>;
+
+  /**
+   * Constructs lazy sequence value from given source. The sequence is a
+   * record whose prototype, shared by all sequences, has `map`, `filter`,
+   * `skip` and `take` methods, which add stages to the sequence, and
+   * `forEach`, `reduce` and `toList` methods, which consume it. Stages are
+   * fused together and evaluated one element at a time.
+   */
+  value::ptr
+  Make(const Runtime& runtime, const source_type& source);
+
+  /**
+   * Returns source which generates elements of given list.
+   */
+  source_type
+  FromList(const std::shared_ptr<value::List>& list);
+
+  /**
+   * Determines whether given value is a lazy sequence.
+   */
+  bool
+  IsSequence(const value::ptr& value);
+
+  /**
+   * Passes elements of given lazy sequence, after they have gone through
+   * all stages of the sequence, to the sink.
+   */
+  void
+  Stream(Runtime& runtime, const value::ptr& sequence, const sink_type& sink);
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "snek/macros.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Stable merge sort which takes advantage of already sorted runs in the
+   * input, as described in Tim Peters' listsort.txt. Short runs are extended
+   * with binary insertion sort and runs are merged so that the lengths of
+   * pending runs stay balanced. Before each merge, elements which are
+   * already in their final positions are skipped with binary searches; the
+   * galloping mode of the merges themselves is not implemented.
+   *
+   * The comparison function is allowed to throw, in which case contents of
+   * the container are left unspecified. Inconsistent comparison functions
+   * result in unspecified order, but never in accesses outside of the
+   * container.
+   */
+  template<class T, class Less>
+  class TimSort final
+  {
+  public:
+    DISALLOW_COPY_AND_ASSIGN(TimSort);
+
+    static void Sort(std::vector<T>& elements, Less less)
+    {
+      TimSort(elements, less).Sort();
+    }
+
+  private:
+    static constexpr std::size_t kMinMerge = 32;
+
+    struct Run
+    {
+      std::size_t begin;
+      std::size_t length;
+    };
+
+    explicit TimSort(std::vector<T>& elements, Less less)
+      : m_elements(elements)
+      , m_less(less) {}
+
+    static std::size_t MinRunLength(std::size_t size)
+    {
+      std::size_t remainder = 0;
+
+      while (size >= kMinMerge)
+      {
+        remainder |= size & 1;
+        size >>= 1;
+      }
+
+      return size + remainder;
+    }
+
+    void Sort()
+    {
+      const auto size = m_elements.size();
+      const auto min_run_length = MinRunLength(size);
+
+      if (size < 2)
+      {
+        return;
+      }
+      for (std::size_t begin = 0; begin < size;)
+      {
+        auto length = CountRunAndMakeAscending(begin, size);
+
+        if (length < min_run_length)
+        {
+          const auto forced_length = std::min(min_run_length, size - begin);
+
+          BinaryInsertionSort(begin, begin + forced_length, begin + length);
+          length = forced_length;
+        }
+        m_runs.push_back({ begin, length });
+        MergeCollapse();
+        begin += length;
+      }
+      while (m_runs.size() > 1)
+      {
+        auto n = m_runs.size() - 2;
+
+        if (n > 0 && m_runs[n - 1].length < m_runs[n + 1].length)
+        {
+          --n;
+        }
+        MergeAt(n);
+      }
+    }
+
+    /**
+     * Returns length of the run which begins at given position, reversing it
+     * first if it's strictly descending.
+     */
+    std::size_t CountRunAndMakeAscending(std::size_t begin, std::size_t end)
+    {
+      auto run_end = begin + 1;
+
+      if (run_end == end)
+      {
+        return 1;
+      }
+      if (m_less(m_elements[run_end], m_elements[begin]))
+      {
+        ++run_end;
+        while (
+          run_end < end &&
+          m_less(m_elements[run_end], m_elements[run_end - 1])
+        )
+        {
+          ++run_end;
+        }
+        std::reverse(
+          std::begin(m_elements) + begin,
+          std::begin(m_elements) + run_end
+        );
+      } else {
+        ++run_end;
+        while (
+          run_end < end &&
+          !m_less(m_elements[run_end], m_elements[run_end - 1])
+        )
+        {
+          ++run_end;
+        }
+      }
+
+      return run_end - begin;
+    }
+
+    /**
+     * Sorts range [begin, end) of which range [begin, start) is already
+     * sorted.
+     */
+    void BinaryInsertionSort(
+      std::size_t begin,
+      std::size_t end,
+      std::size_t start
+    )
+    {
+      const auto first = std::begin(m_elements);
+
+      for (auto i = start; i < end; ++i)
+      {
+        auto pivot = std::move(m_elements[i]);
+        const auto position = std::upper_bound(
+          first + begin,
+          first + i,
+          pivot,
+          m_less
+        );
+
+        std::move_backward(position, first + i, first + i + 1);
+        *position = std::move(pivot);
+      }
+    }
+
+    /**
+     * Merges pending runs until lengths of the runs on top of the stack
+     * decrease faster than the Fibonacci sequence.
+     */
+    void MergeCollapse()
+    {
+      while (m_runs.size() > 1)
+      {
+        auto n = m_runs.size() - 2;
+
+        if (
+          (
+            n > 0 &&
+            m_runs[n - 1].length <= m_runs[n].length + m_runs[n + 1].length
+          ) ||
+          (
+            n > 1 &&
+            m_runs[n - 2].length <= m_runs[n - 1].length + m_runs[n].length
+          )
+        )
+        {
+          if (m_runs[n - 1].length < m_runs[n + 1].length)
+          {
+            --n;
+          }
+        }
+        else if (m_runs[n].length > m_runs[n + 1].length)
+        {
+          break;
+        }
+        MergeAt(n);
+      }
+    }
+
+    /**
+     * Merges pending runs at given index and the one following it.
+     */
+    void MergeAt(std::size_t index)
+    {
+      const auto first = std::begin(m_elements);
+      const auto left_begin = m_runs[index].begin;
+      const auto left_end = left_begin + m_runs[index].length;
+      const auto right_end = left_end + m_runs[index + 1].length;
+
+      m_runs[index].length += m_runs[index + 1].length;
+      m_runs.erase(std::begin(m_runs) + index + 1);
+
+      // Elements of the left run which are not greater than the first element
+      // of the right run are already in place, as are elements of the right
+      // run which are not less than the last element of the left run.
+      const auto begin = static_cast<std::size_t>(std::upper_bound(
+        first + left_begin,
+        first + left_end,
+        m_elements[left_end],
+        m_less
+      ) - first);
+
+      if (begin == left_end)
+      {
+        return;
+      }
+
+      const auto end = static_cast<std::size_t>(std::lower_bound(
+        first + left_end,
+        first + right_end,
+        m_elements[left_end - 1],
+        m_less
+      ) - first);
+
+      if (left_end - begin <= end - left_end)
+      {
+        MergeLow(begin, left_end, end);
+      } else {
+        MergeHigh(begin, left_end, end);
+      }
+    }
+
+    /**
+     * Merges adjacent sorted ranges [begin, middle) and [middle, end) by
+     * moving the left one into temporary buffer.
+     */
+    void MergeLow(std::size_t begin, std::size_t middle, std::size_t end)
+    {
+      const auto first = std::begin(m_elements);
+      std::size_t i = 0;
+      auto j = middle;
+      auto destination = begin;
+
+      m_buffer.assign(
+        std::make_move_iterator(first + begin),
+        std::make_move_iterator(first + middle)
+      );
+      while (i < m_buffer.size() && j < end)
+      {
+        if (m_less(m_elements[j], m_buffer[i]))
+        {
+          m_elements[destination++] = std::move(m_elements[j++]);
+        } else {
+          m_elements[destination++] = std::move(m_buffer[i++]);
+        }
+      }
+      std::move(
+        std::begin(m_buffer) + i,
+        std::end(m_buffer),
+        first + destination
+      );
+      m_buffer.clear();
+    }
+
+    /**
+     * Merges adjacent sorted ranges [begin, middle) and [middle, end) by
+     * moving the right one into temporary buffer.
+     */
+    void MergeHigh(std::size_t begin, std::size_t middle, std::size_t end)
+    {
+      const auto first = std::begin(m_elements);
+      auto i = middle;
+      auto j = end - middle;
+      auto destination = end;
+
+      m_buffer.assign(
+        std::make_move_iterator(first + middle),
+        std::make_move_iterator(first + end)
+      );
+      while (i > begin && j > 0)
+      {
+        if (m_less(m_buffer[j - 1], m_elements[i - 1]))
+        {
+          m_elements[--destination] = std::move(m_elements[--i]);
+        } else {
+          m_elements[--destination] = std::move(m_buffer[--j]);
+        }
+      }
+      std::move_backward(
+        std::begin(m_buffer),
+        std::begin(m_buffer) + j,
+        first + destination
+      );
+      m_buffer.clear();
+    }
+
+  private:
+    std::vector<T>& m_elements;
+    Less m_less;
+    std::vector<Run> m_runs;
+    std::vector<T> m_buffer;
+  };
+
+  /**
+   * Sorts given vector with TimSort, using given less than comparison
+   * function.
+   */
+  template<class T, class Less>
+  inline void
+  StableSort(std::vector<T>& elements, Less less)
+  {
+    TimSort<T, Less>::Sort(elements, less);
+  }
+}
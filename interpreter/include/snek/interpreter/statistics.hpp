@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "snek/parser/expression.hpp"
+#include "snek/parser/statement.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Execution counters of a runtime, which tell where the interpreter
+   * spends it's time. Counters are only updated when the interpreter has
+   * been built with SNEK_ENABLE_STATISTICS, and they are not thread safe, as
+   * each runtime is used from one thread only. Counters of worker contexts
+   * used by parallel operations are merged into the runtime which started
+   * the operation.
+   */
+  struct Statistics final
+  {
+    using counter_type = std::uint64_t;
+    using method_call_container_type = std::unordered_map<
+      std::u32string,
+      counter_type
+    >;
+
+    /**
+     * Maximum number of method name addresses remembered by
+     * CountMethodCall(), after which they are forgotten and collected again.
+     */
+    static constexpr std::size_t kMaxMethodNameAddresses = 1024;
+
+    static constexpr std::size_t kExpressionKindCount =
+      static_cast<std::size_t>(parser::expression::Kind::Unary) + 1;
+    static constexpr std::size_t kStatementKindCount =
+      static_cast<std::size_t>(parser::statement::Kind::While) + 1;
+
+    /** Number of expressions evaluated, by kind of the expression. */
+    std::array<counter_type, kExpressionKindCount> expressions = {};
+    /** Number of statements executed, by kind of the statement. */
+    std::array<counter_type, kStatementKindCount> statements = {};
+    /**
+     * Number of methods called by name, including operators. Entries must
+     * not be removed from here other than with Reset().
+     */
+    method_call_container_type method_calls;
+    /** Number of prototype property lookups found from the cache. */
+    counter_type property_cache_hits = 0;
+    /** Number of prototype property lookups not found from the cache. */
+    counter_type property_cache_misses = 0;
+    /** Number of native function invocations. */
+    counter_type native_calls = 0;
+    /** Number of scripted function invocations. */
+    counter_type scripted_calls = 0;
+    /** Number of values checked against parameter types. */
+    counter_type parameter_checks = 0;
+
+    inline void
+    CountExpression(parser::expression::Kind kind)
+    {
+      ++expressions[static_cast<std::size_t>(kind)];
+    }
+
+    inline void
+    CountStatement(parser::statement::Kind kind)
+    {
+      ++statements[static_cast<std::size_t>(kind)];
+    }
+
+    explicit Statistics() = default;
+
+    /**
+     * Copies the counters. Method name addresses remembered by
+     * CountMethodCall() are not copied.
+     */
+    Statistics(const Statistics& that);
+
+    Statistics& operator=(const Statistics& that);
+
+    /**
+     * Increments counter of method with given name. Method names are usually
+     * kept in static storage, so counter of the name is first looked up with
+     * it's address, and only if that fails, by hashing the name.
+     */
+    void CountMethodCall(const std::u32string& name);
+
+    /**
+     * Adds counters of given statistics into these ones.
+     */
+    void Merge(const Statistics& that);
+
+    /**
+     * Resets all counters to zero.
+     */
+    void Reset();
+
+    /**
+     * Writes human readable report of the counters into given stream. Zero
+     * counters are omitted, and the rest are sorted in descending order.
+     */
+    void Write(std::ostream& output) const;
+
+  private:
+    std::unordered_map<
+      const std::u32string*,
+      method_call_container_type::pointer
+    > m_method_name_addresses;
+  };
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "snek/interpreter/error.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Resumable execution of a script. Task runs on a stack of it's own,
+   * separate from the stack of the thread which resumes it, so that it can
+   * be suspended at any checkpoint of the interpreter and resumed later,
+   * which allows a single thread to interleave execution of many scripts.
+   *
+   * Task suspends itself after it has passed given number of checkpoints,
+   * or when it waits for a host provided asynchronous native function to
+   * complete. Call stack and budget of the runtime are saved into the task
+   * while it is suspended, so multiple tasks can share a runtime, but only
+   * one task can be running in a runtime at a time, and a task must be
+   * resumed from the thread that created it. Parallel list operations do
+   * not suspend.
+   *
+   * Tasks are only supported on POSIX platforms.
+   */
+  class Task final : public std::enable_shared_from_this<Task>
+  {
+  public:
+    using ptr = std::shared_ptr<Task>;
+    using body_type = std::function<value::ptr(Runtime&)>;
+    using start_type = std::function<void(const ptr&)>;
+
+    enum class State
+    {
+      /** Task has not been resumed yet, or has been suspended. */
+      Suspended,
+      /** Task is currently being executed. */
+      Running,
+      /** Task is waiting for an asynchronous function to complete. */
+      Waiting,
+      /** Task has finished and it's result is available. */
+      Finished,
+      /** Task has been terminated by an error. */
+      Failed,
+    };
+
+    /** Default size of the stack allocated for each task. */
+    static constexpr std::size_t kDefaultStackSize = 1024 * 1024;
+
+    DISALLOW_COPY_AND_ASSIGN(Task);
+
+    /**
+     * Creates a task which executes given function with the runtime. Task
+     * does not begin executing until it is resumed for the first time. The
+     * runtime must outlive the task.
+     */
+    static ptr Make(
+      Runtime& runtime,
+      const body_type& body,
+      std::size_t stack_size = kDefaultStackSize
+    );
+
+    /**
+     * Creates a task which runs given script in given scope.
+     */
+    static ptr MakeScript(
+      Runtime& runtime,
+      const Scope::ptr& scope,
+      const std::u32string& source,
+      const std::u32string& filename = U"<eval>"
+    );
+
+    /**
+     * Destroying a task which has not finished unwinds it's stack, releasing
+     * all values referenced by it.
+     */
+    ~Task();
+
+    inline State state() const
+    {
+      return m_state;
+    }
+
+    inline bool done() const
+    {
+      return m_state == State::Finished || m_state == State::Failed;
+    }
+
+    /**
+     * Value returned by the task, once it has finished.
+     */
+    inline const value::ptr& result() const
+    {
+      return m_result;
+    }
+
+    /**
+     * Error which terminated the task, if it has failed.
+     */
+    inline const std::optional<Error>& error() const
+    {
+      return m_error;
+    }
+
+    /**
+     * Number of checkpoints the task passes before it suspends itself, or
+     * empty if the task runs until it finishes or waits.
+     */
+    inline const std::optional<std::uint64_t>& slice() const
+    {
+      return m_slice;
+    }
+
+    inline void set_slice(const std::optional<std::uint64_t>& slice)
+    {
+      m_slice = slice;
+    }
+
+    /**
+     * Budget of the runtime while the task is running. Tasks begin without
+     * a budget, and budget of the code which resumes a task does not apply
+     * inside it.
+     */
+    inline const Runtime::Budget& budget() const
+    {
+      return m_budget;
+    }
+
+    inline void set_budget(const Runtime::Budget& budget)
+    {
+      m_budget = budget;
+    }
+
+    /**
+     * Executes the task until it finishes, fails, suspends itself or begins
+     * to wait. Returns true if the task is done. Resuming a waiting task
+     * does nothing until the asynchronous function has been completed.
+     * Exceptions which are not Snek errors are rethrown from here.
+     */
+    bool Resume();
+
+    /**
+     * Completes the asynchronous function the task is waiting for, with
+     * given return value. The task continues when it is resumed next time.
+     */
+    void Complete(const value::ptr& value);
+
+    /**
+     * Completes the asynchronous function the task is waiting for with an
+     * error, which is thrown in the task when it is resumed next time.
+     */
+    void Fail(const std::u32string& message);
+
+    /**
+     * Suspends the task running in given runtime, returning control to the
+     * caller of Resume(). Does nothing if the runtime is not running a task.
+     */
+    static void Yield(Runtime& runtime);
+
+    /**
+     * Called by asynchronous native functions. Passes the task running in
+     * given runtime to given function, which is expected to start an
+     * asynchronous operation that eventually calls Complete() or Fail() on
+     * the task, then suspends the task until that happens. Returns the value
+     * given to Complete(). Throws an error if the runtime is not running a
+     * task.
+     */
+    static value::ptr Await(Runtime& runtime, const start_type& start);
+
+    /**
+     * Called by the runtime on every checkpoint the task passes.
+     */
+    inline void Tick()
+    {
+      if (m_slice && ++m_ticks >= *m_slice)
+      {
+        m_ticks = 0;
+        Suspend();
+      }
+    }
+
+  private:
+    struct Context;
+
+    explicit Task(Runtime& runtime, const body_type& body);
+
+    static void Entry();
+
+    void Suspend();
+
+  private:
+    Runtime& m_runtime;
+    const body_type m_body;
+    std::unique_ptr<Context> m_context;
+    State m_state;
+    std::optional<std::uint64_t> m_slice;
+    std::uint64_t m_ticks;
+    Runtime::call_stack_type m_call_stack;
+    Runtime::Budget m_budget;
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    const std::optional<Position>* m_allocation_site;
+#endif
+    value::ptr m_result;
+    std::optional<Error> m_error;
+    std::exception_ptr m_exception;
+    value::ptr m_awaited_value;
+    std::optional<std::u32string> m_awaited_error;
+    bool m_started;
+    bool m_cancelled;
+  };
+}
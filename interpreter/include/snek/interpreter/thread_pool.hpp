@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "snek/macros.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Fixed size pool of worker threads which execute submitted tasks in the
+   * order they were submitted. Tasks which have not been started yet when
+   * the pool is destroyed are discarded.
+   */
+  class ThreadPool final
+  {
+  public:
+    using task_type = std::function<void()>;
+
+    DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+
+    /**
+     * Returns number of hardware threads available, or one if that cannot be
+     * determined.
+     */
+    static std::size_t DefaultSize();
+
+    /**
+     * Returns pool shared by the whole process, which is created when this
+     * method is called for the first time. Background work that is not tied
+     * to a single runtime should be submitted here, so that creating many
+     * runtimes does not create threads for each one of them.
+     */
+    static ThreadPool& Shared();
+
+    explicit ThreadPool(std::size_t size = DefaultSize());
+
+    ~ThreadPool();
+
+    inline std::size_t size() const
+    {
+      return m_workers.size();
+    }
+
+    void Submit(task_type task);
+
+  private:
+    void Work();
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<task_type> m_tasks;
+    bool m_stopping;
+    std::vector<std::thread> m_workers;
+  };
+}
@@ -27,6 +27,7 @@
 
 #include <functional>
 
+#include "snek/interpreter/allocation_tracker.hpp"
 #include "snek/interpreter/config.hpp"
 #include "snek/interpreter/parameter.hpp"
 #include "snek/parser/parameter.hpp"
@@ -57,13 +58,6 @@ namespace snek::interpreter::value
   public:
     DISALLOW_COPY_AND_ASSIGN(Base);
 
-  #if defined(SNEK_ENABLE_PROPERTY_CACHE)
-    using property_cache_type = std::unordered_map<
-      std::u32string,
-      std::shared_ptr<Base>
-    >;
-  #endif
-
     explicit Base() {}
 
     virtual Kind kind() const = 0;
@@ -73,16 +67,6 @@ namespace snek::interpreter::value
     virtual std::u32string ToString() const = 0;
 
     virtual std::u32string ToSource() const = 0;
-
-#if defined(SNEK_ENABLE_PROPERTY_CACHE)
-  private:
-    mutable property_cache_type m_property_cache;
-    friend std::optional<std::shared_ptr<Base>> GetProperty(
-      const Runtime&,
-      const std::shared_ptr<Base>&,
-      const std::u32string&
-    );
-#endif
   };
 
   using ptr = std::shared_ptr<Base>;
@@ -245,7 +229,12 @@ namespace snek::interpreter::value
     const value_type value;
 
     explicit Float(value_type value_)
-      : value(value_) {}
+      : value(value_)
+    {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+      AllocationTracker::Track(Kind::Float, sizeof(Float));
+#endif
+    }
 
     inline Kind kind() const override
     {
@@ -366,6 +355,10 @@ namespace snek::interpreter::value
     using value_type = ptr;
     using size_type = std::size_t;
 
+    /**
+     * Constructs list from given elements. If all of the elements are ints,
+     * or all of them are floats, the list stores them unboxed.
+     */
     static std::shared_ptr<List>
     Make(const std::vector<ptr>& elements);
 
@@ -380,6 +373,25 @@ namespace snek::interpreter::value
 
     virtual value_type At(size_type index) const = 0;
 
+    /**
+     * Returns kind of the elements if the list stores them unboxed, in which
+     * case the list is either IntList or FloatList.
+     */
+    virtual std::optional<Kind> GetUnboxedKind() const
+    {
+      return std::nullopt;
+    }
+
+    /**
+     * Stores the elements into given container as ints, without boxing them
+     * first, if the list computes it's elements and they are known to all be
+     * ints. Returns false otherwise.
+     */
+    virtual bool UnboxInts(std::vector<Int::value_type>&) const
+    {
+      return false;
+    }
+
     bool Equals(const Base& that) const override;
 
     std::u32string ToString() const override;
@@ -389,6 +401,80 @@ namespace snek::interpreter::value
     virtual std::vector<ptr> ToVector() const;
   };
 
+  /**
+   * List which stores ints unboxed in contiguous memory. Elements are boxed
+   * when they are accessed through the generic list interface.
+   */
+  class IntList final : public List
+  {
+  public:
+    using element_type = Int::value_type;
+    using container_type = std::vector<element_type>;
+
+    static std::shared_ptr<IntList>
+    Make(container_type elements);
+
+    explicit IntList(container_type elements)
+      : m_elements(std::move(elements)) {}
+
+    inline size_type GetSize() const override
+    {
+      return m_elements.size();
+    }
+
+    value_type At(size_type index) const override;
+
+    inline std::optional<Kind> GetUnboxedKind() const override
+    {
+      return Kind::Int;
+    }
+
+    inline const container_type& elements() const
+    {
+      return m_elements;
+    }
+
+  private:
+    const container_type m_elements;
+  };
+
+  /**
+   * List which stores floats unboxed in contiguous memory. Elements are boxed
+   * when they are accessed through the generic list interface.
+   */
+  class FloatList final : public List
+  {
+  public:
+    using element_type = Float::value_type;
+    using container_type = std::vector<element_type>;
+
+    static std::shared_ptr<FloatList>
+    Make(container_type elements);
+
+    explicit FloatList(container_type elements)
+      : m_elements(std::move(elements)) {}
+
+    inline size_type GetSize() const override
+    {
+      return m_elements.size();
+    }
+
+    value_type At(size_type index) const override;
+
+    inline std::optional<Kind> GetUnboxedKind() const override
+    {
+      return Kind::Float;
+    }
+
+    inline const container_type& elements() const
+    {
+      return m_elements;
+    }
+
+  private:
+    const container_type m_elements;
+  };
+
   class Record : public Base
   {
   public:
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "snek/macros.hpp"
+
+namespace snek::interpreter
+{
+  /**
+   * Pool of worker threads which split ranges of work between themselves.
+   * Each worker has a queue of chunks of it's own, and workers which run out
+   * of chunks steal them from the queues of other workers. The thread which
+   * submits the work participates in executing it, so the pool can also be
+   * used from inside of the tasks it's running.
+   */
+  class WorkStealingPool final
+  {
+  public:
+    /**
+     * Task which processes items in range [begin, end). The worker argument
+     * is index of the worker executing the task, or size of the pool when
+     * the task is executed by the thread which submitted the work.
+     */
+    using task_type = std::function<void(
+      std::size_t worker,
+      std::size_t begin,
+      std::size_t end
+    )>;
+
+    /**
+     * Thrown by Run() when chunks have been skipped because the work was
+     * cancelled and none of the tasks threw an exception of their own.
+     */
+    struct Cancelled {};
+
+    DISALLOW_COPY_AND_ASSIGN(WorkStealingPool);
+
+    /**
+     * Returns number of worker threads which a pool should have so that,
+     * together with the calling thread, all hardware threads are used.
+     */
+    static std::size_t DefaultSize();
+
+    /**
+     * Returns process wide pool of default size, which is created when this
+     * method is called for the first time.
+     */
+    static const std::shared_ptr<WorkStealingPool>& Default();
+
+    explicit WorkStealingPool(std::size_t size = DefaultSize());
+
+    ~WorkStealingPool();
+
+    inline std::size_t size() const
+    {
+      return m_workers.size();
+    }
+
+    /**
+     * Splits range [0, count) into chunks of at most grain_size items and
+     * executes given task for each one of them, returning once all of them
+     * have been processed. If a task throws an exception, rest of the chunks
+     * are skipped and the first exception is rethrown to the caller.
+     *
+     * If cancellation flag is given, rest of the chunks are also skipped once
+     * the flag has been set, and Cancelled is thrown unless a task threw an
+     * exception. The flag is not cleared by the pool, but a task may clear
+     * it, so the caller cannot rely on it to find out whether all of the
+     * chunks were processed.
+     */
+    void Run(
+      std::size_t count,
+      std::size_t grain_size,
+      const task_type& task,
+      const std::atomic<bool>* cancelled = nullptr
+    );
+
+  private:
+    struct Job;
+
+    void Work(std::size_t index);
+
+    void Detach(const std::shared_ptr<Job>& job);
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    bool m_stopping;
+    std::vector<std::thread> m_workers;
+  };
+}
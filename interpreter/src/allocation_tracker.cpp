@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/interpreter/allocation_tracker.hpp"
+#include "snek/interpreter/scope.hpp"
+
+namespace snek::interpreter
+{
+  static_assert(
+    static_cast<std::size_t>(value::Kind::String) + 2 ==
+    AllocationTracker::kKindCount
+  );
+
+  static constexpr std::size_t kScopeIndex = AllocationTracker::kKindCount - 1;
+
+  static thread_local AllocationTracker* current_tracker = nullptr;
+
+  static std::string
+  GetKindName(std::size_t index)
+  {
+    if (index == kScopeIndex)
+    {
+      return "Scope";
+    }
+
+    return peelo::unicode::encoding::utf8::encode(
+      value::ToString(static_cast<value::Kind>(index))
+    );
+  }
+
+  static std::string
+  GetSiteName(const AllocationTracker::site_key_type& key)
+  {
+    const auto filename = std::get<0>(key);
+
+    if (!filename)
+    {
+      return "<unknown>";
+    }
+
+    return peelo::unicode::encoding::utf8::encode(*filename)
+      + ':'
+      + std::to_string(std::get<1>(key))
+      + ':'
+      + std::to_string(std::get<2>(key));
+  }
+
+  AllocationTracker::AllocationTracker()
+    : m_running(false) {}
+
+  AllocationTracker::~AllocationTracker()
+  {
+    Stop();
+  }
+
+  bool
+  AllocationTracker::Start()
+  {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    if (m_running || current_tracker)
+    {
+      return false;
+    }
+    current_tracker = this;
+    m_running = true;
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void
+  AllocationTracker::Stop()
+  {
+    if (!m_running)
+    {
+      return;
+    }
+    if (current_tracker == this)
+    {
+      current_tracker = nullptr;
+    }
+    m_running = false;
+  }
+
+  AllocationTracker::Counter
+  AllocationTracker::total(value::Kind kind) const
+  {
+    const auto index = static_cast<std::size_t>(kind);
+    Counter result;
+
+    for (const auto& entry : m_sites)
+    {
+      result.count += entry.second.counters[index].count;
+      result.bytes += entry.second.counters[index].bytes;
+    }
+
+    return result;
+  }
+
+  AllocationTracker::Counter
+  AllocationTracker::scope_total() const
+  {
+    Counter result;
+
+    for (const auto& entry : m_sites)
+    {
+      result.count += entry.second.counters[kScopeIndex].count;
+      result.bytes += entry.second.counters[kScopeIndex].bytes;
+    }
+
+    return result;
+  }
+
+  void
+  AllocationTracker::WriteTable(std::ostream& output) const
+  {
+    struct Row
+    {
+      std::string site;
+      std::size_t kind;
+      Counter counter;
+    };
+    std::array<Counter, kKindCount> totals = {};
+    std::map<std::pair<std::string, std::size_t>, Counter> merged;
+    std::vector<Row> rows;
+    const auto sort_rows = [](std::vector<Row>& rows_to_sort)
+    {
+      std::sort(
+        std::begin(rows_to_sort),
+        std::end(rows_to_sort),
+        [](const Row& a, const Row& b)
+        {
+          if (a.counter.bytes != b.counter.bytes)
+          {
+            return a.counter.bytes > b.counter.bytes;
+          }
+          else if (a.counter.count != b.counter.count)
+          {
+            return a.counter.count > b.counter.count;
+          }
+
+          return a.site < b.site;
+        }
+      );
+    };
+    const auto write_row = [&output](const Row& row)
+    {
+      output << "  "
+             << std::setw(12) << row.counter.bytes << ' '
+             << std::setw(10) << row.counter.count << "  ";
+      if (row.site.empty())
+      {
+        output << GetKindName(row.kind);
+      } else {
+        output << std::left << std::setw(9) << GetKindName(row.kind)
+               << std::right << ' ' << row.site;
+      }
+      output << '\n';
+    };
+
+    // Sources which have been parsed more than once have distinct
+    // filenames, which are merged together here.
+    for (const auto& entry : m_sites)
+    {
+      const auto site = GetSiteName(entry.first);
+
+      for (std::size_t i = 0; i < kKindCount; ++i)
+      {
+        const auto& counter = entry.second.counters[i];
+
+        if (!counter.count)
+        {
+          continue;
+        }
+        totals[i].count += counter.count;
+        totals[i].bytes += counter.bytes;
+        merged[std::make_pair(site, i)].count += counter.count;
+        merged[std::make_pair(site, i)].bytes += counter.bytes;
+      }
+    }
+    rows.reserve(merged.size());
+    for (const auto& entry : merged)
+    {
+      rows.push_back({ entry.first.first, entry.first.second, entry.second });
+    }
+    sort_rows(rows);
+
+    std::vector<Row> total_rows;
+
+    for (std::size_t i = 0; i < kKindCount; ++i)
+    {
+      if (totals[i].count)
+      {
+        total_rows.push_back({ std::string(), i, totals[i] });
+      }
+    }
+    sort_rows(total_rows);
+
+    output << "Allocations by kind:\n"
+           << "  " << std::setw(12) << "Bytes" << ' '
+           << std::setw(10) << "Count" << "  Kind\n";
+    for (const auto& row : total_rows)
+    {
+      write_row(row);
+    }
+    output << "\nAllocations by site:\n"
+           << "  " << std::setw(12) << "Bytes" << ' '
+           << std::setw(10) << "Count" << "  Kind      Site\n";
+    for (const auto& row : rows)
+    {
+      write_row(row);
+    }
+  }
+
+  void
+  AllocationTracker::Clear()
+  {
+    m_sites.clear();
+  }
+
+  void
+  AllocationTracker::Track(value::Kind kind, std::size_t bytes)
+  {
+    if (const auto tracker = current_tracker)
+    {
+      tracker->Add(static_cast<std::size_t>(kind), bytes);
+    }
+  }
+
+  void
+  AllocationTracker::TrackScope()
+  {
+    if (const auto tracker = current_tracker)
+    {
+      tracker->Add(kScopeIndex, sizeof(Scope));
+    }
+  }
+
+  void
+  AllocationTracker::Add(std::size_t index, std::size_t bytes)
+  {
+    const auto position = s_position;
+    site_key_type key(nullptr, 0, 0);
+
+    if (position && *position && (*position)->filename)
+    {
+      key = site_key_type(
+        (*position)->filename.get(),
+        (*position)->line,
+        (*position)->column
+      );
+    }
+
+    auto& site = m_sites[key];
+    auto& counter = site.counters[index];
+
+    if (!site.filename && std::get<0>(key))
+    {
+      // Keep the filename alive for as long as the site is being referenced
+      // by it's address.
+      site.filename = (*position)->filename;
+    }
+    ++counter.count;
+    counter.bytes += bytes;
+  }
+}
@@ -23,11 +23,17 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <peelo/unicode/encoding/utf8.hpp>
 
+#include "snek/interpreter/error.hpp"
+#include "snek/interpreter/json.hpp"
 #include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/sequence.hpp"
 
 namespace snek::interpreter::api
 {
@@ -39,10 +45,24 @@ namespace snek::interpreter::api
   static value::ptr
   Eval(Runtime& runtime, const std::vector<value::ptr>& arguments)
   {
-    return runtime.RunScript(
-      std::make_shared<Scope>(runtime.root_scope()),
-      static_cast<const value::String*>(arguments[0].get())->ToString()
-    );
+    const auto scope = std::make_shared<Scope>(runtime.root_scope());
+    const auto source = static_cast<const value::String*>(
+      arguments[0].get()
+    )->ToString();
+#if defined(SNEK_ENABLE_EVAL_CACHE)
+    auto& cache = runtime.program_cache();
+    auto program = cache.Find(source);
+
+    if (!program)
+    {
+      program = runtime.Compile(source);
+      cache.Insert(source, program);
+    }
+
+    return runtime.Run(program, scope);
+#else
+    return runtime.RunScript(scope, source);
+#endif
   }
 
   /**
@@ -74,26 +94,419 @@ namespace snek::interpreter::api
     return nullptr;
   }
 
+  namespace
+  {
+    /**
+     * Arithmetic progression of ints which computes its elements on demand,
+     * so that ranges of any size use constant amount of memory.
+     */
+    class RangeList final : public value::List
+    {
+    public:
+      explicit RangeList(std::int64_t start, std::int64_t step, size_type size)
+        : m_start(start)
+        , m_step(step)
+        , m_size(size) {}
+
+      inline size_type GetSize() const override
+      {
+        return m_size;
+      }
+
+      value_type At(size_type index) const override
+      {
+        const auto value = Compute(index);
+
+#if defined(SNEK_ENABLE_INT_CACHE)
+        if (const auto cached = Builtins::Get().GetCachedInt(value))
+        {
+          return *cached;
+        }
+#endif
+
+        return std::make_shared<value::Int>(value);
+      }
+
+      bool UnboxInts(std::vector<std::int64_t>& output) const override
+      {
+        output.resize(m_size);
+        for (size_type i = 0; i < m_size; ++i)
+        {
+          output[i] = Compute(i);
+        }
+
+        return true;
+      }
+
+    private:
+      inline std::int64_t Compute(size_type index) const
+      {
+        // Computed in unsigned arithmetic, because the last element may be
+        // the only one in the range which does not overflow.
+        return static_cast<std::int64_t>(
+          static_cast<std::uint64_t>(m_start) +
+          static_cast<std::uint64_t>(index) *
+          static_cast<std::uint64_t>(m_step)
+        );
+      }
+
+    private:
+      const std::int64_t m_start;
+      const std::int64_t m_step;
+      const size_type m_size;
+    };
+
+    /**
+     * Reads lines from input stream in large chunks, so that only the chunk
+     * and the line being currently read are held in memory.
+     */
+    class LineReader final
+    {
+    public:
+      static constexpr std::size_t kChunkSize = 64 * 1024;
+
+      DISALLOW_COPY_AND_ASSIGN(LineReader);
+
+      explicit LineReader(std::unique_ptr<std::istream> stream)
+        : m_owned_stream(std::move(stream))
+        , m_stream(*m_owned_stream)
+        , m_buffer(new char[kChunkSize])
+        , m_position(0)
+        , m_size(0) {}
+
+      /**
+       * Returns reader of the standard input stream, which is shared by all
+       * sequences reading it, so that input already read into the buffer is
+       * not lost when one of them is discarded.
+       */
+      static const std::shared_ptr<LineReader>&
+      StandardInput()
+      {
+        static const std::shared_ptr<LineReader> reader(
+          new LineReader(std::cin)
+        );
+
+        return reader;
+      }
+
+      /**
+       * Reads next line from the stream, without the line terminator, and
+       * decodes it from UTF-8. Returns false if the end of the stream has
+       * been reached.
+       */
+      bool
+      ReadLine(std::u32string& line)
+      {
+        using peelo::unicode::encoding::utf8::decode;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::string bytes;
+        bool found = false;
+
+        for (;;)
+        {
+          const char* begin;
+          const char* end;
+
+          if (m_position >= m_size && !Fill())
+          {
+            break;
+          }
+          found = true;
+          begin = m_buffer.get() + m_position;
+          end = static_cast<const char*>(
+            std::memchr(begin, '\n', m_size - m_position)
+          );
+          if (end)
+          {
+            bytes.append(begin, end);
+            m_position += end - begin + 1;
+            break;
+          }
+          bytes.append(begin, m_size - m_position);
+          m_position = m_size;
+        }
+
+        if (!found)
+        {
+          return false;
+        }
+        if (!bytes.empty() && bytes.back() == '\r')
+        {
+          bytes.pop_back();
+        }
+        line = decode(bytes);
+
+        return true;
+      }
+
+    private:
+      explicit LineReader(std::istream& stream)
+        : m_stream(stream)
+        , m_buffer(new char[kChunkSize])
+        , m_position(0)
+        , m_size(0) {}
+
+      bool
+      Fill()
+      {
+        m_stream.read(m_buffer.get(), kChunkSize);
+        m_position = 0;
+        m_size = static_cast<std::size_t>(m_stream.gcount());
+        if (!m_size)
+        {
+          // Allow reading more after the end of interactive input.
+          m_stream.clear();
+        }
+
+        return m_size > 0;
+      }
+
+    private:
+      const std::unique_ptr<std::istream> m_owned_stream;
+      std::istream& m_stream;
+      std::mutex m_mutex;
+      const std::unique_ptr<char[]> m_buffer;
+      std::size_t m_position;
+      std::size_t m_size;
+    };
+  }
+
+  /**
+   * range(start: Int, stop: Int | null, step: Int) => Int[]
+   *
+   * Returns list of ints from start (inclusive) to stop (exclusive),
+   * incremented by step. If only one argument is given, it is used as the
+   * stop and the range starts from zero. Elements of the list are computed
+   * when they are accessed, instead of being stored in memory.
+   */
+  static value::ptr
+  Range(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    auto start = static_cast<const value::Int*>(arguments[0].get())->value;
+    std::int64_t stop;
+    const auto step = static_cast<const value::Int*>(arguments[2].get())->value;
+    std::uint64_t distance;
+    std::uint64_t magnitude;
+
+    if (value::IsInt(arguments[1]))
+    {
+      stop = static_cast<const value::Int*>(arguments[1].get())->value;
+    } else {
+      stop = start;
+      start = 0;
+    }
+
+    if (step > 0)
+    {
+      if (start >= stop)
+      {
+        return std::make_shared<RangeList>(start, step, 0);
+      }
+      distance = static_cast<std::uint64_t>(stop) -
+        static_cast<std::uint64_t>(start);
+      magnitude = static_cast<std::uint64_t>(step);
+    }
+    else if (step < 0)
+    {
+      if (start <= stop)
+      {
+        return std::make_shared<RangeList>(start, step, 0);
+      }
+      distance = static_cast<std::uint64_t>(start) -
+        static_cast<std::uint64_t>(stop);
+      magnitude = 0 - static_cast<std::uint64_t>(step);
+    } else {
+      throw runtime.MakeError(U"Range step cannot be zero.");
+    }
+
+    return std::make_shared<RangeList>(
+      start,
+      step,
+      static_cast<std::size_t>((distance - 1) / magnitude + 1)
+    );
+  }
+
+  /**
+   * readLines(path: String | null) => Record
+   *
+   * Returns lazy sequence of lines read from file in given path, or from
+   * standard input stream if no path is given. The input is read while the
+   * sequence is being consumed, so memory usage does not depend on the size
+   * of the input. Sequences of the standard input continue from where the
+   * previous one stopped.
+   */
+  static value::ptr
+  ReadLines(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    std::optional<std::u32string> path;
+
+    if (value::IsString(arguments[0]))
+    {
+      path = static_cast<const value::String*>(arguments[0].get())->ToString();
+    }
+
+    return sequence::Make(
+      runtime,
+      [path](Runtime& runtime) -> sequence::generator_type
+      {
+        std::shared_ptr<LineReader> reader;
+
+        if (path)
+        {
+          auto file = std::make_unique<std::ifstream>(
+            encode(*path),
+            std::ios_base::in | std::ios_base::binary
+          );
+
+          if (!file->good())
+          {
+            throw runtime.MakeError(U"Unable to open file `" + *path + U"'.");
+          }
+          reader = std::make_shared<LineReader>(std::move(file));
+        } else {
+          reader = LineReader::StandardInput();
+        }
+
+        return [reader](Runtime&, value::ptr& element)
+        {
+          std::u32string line;
+
+          if (!reader->ReadLine(line))
+          {
+            return false;
+          }
+          element = value::String::Make(line);
+
+          return true;
+        };
+      }
+    );
+  }
+
+  /**
+   * JSON.parse(text: String) => any
+   *
+   * Parses given JSON text into Snek value. The parser scans UTF-8 bytes
+   * several at a time, so the text is encoded once before parsing.
+   */
+  static value::ptr
+  JsonParse(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    return json::Parse(
+      runtime,
+      encode(static_cast<const value::String*>(arguments[0].get())->ToString())
+    );
+  }
+
+  /**
+   * JSON.stringify(value: any) => String
+   *
+   * Converts given value into JSON text.
+   */
+  static value::ptr
+  JsonStringify(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    // Output is written into buffer which is reused between calls, so that
+    // it does not have to grow from scratch every time. Buffer grown by an
+    // unusually large document is released afterwards.
+    static constexpr std::size_t kMaxRetainedCapacity = 64 * 1024;
+    static thread_local std::u32string buffer;
+    value::ptr result;
+
+    buffer.clear();
+    json::Stringify(runtime, arguments[0], buffer);
+    result = value::String::Make(buffer);
+    if (buffer.capacity() > kMaxRetainedCapacity)
+    {
+      std::u32string().swap(buffer);
+    }
+
+    return result;
+  }
+
   void
   AddGlobalVariables(
-    const Runtime* runtime,
+    const Builtins* builtins,
     Scope::variable_container_type& variables
   )
   {
     variables[U"eval"] =
     {
       value::Function::MakeNative(
-        { { U"source", runtime->string_type() } },
-        runtime->any_type(),
+        { { U"source", builtins->string_type() } },
+        builtins->any_type(),
         Eval
       ),
       true
     };
+    variables[U"readLines"] =
+    {
+      value::Function::MakeNative(
+        {
+          {
+            U"path",
+            type::MakeOptional(builtins->string_type()),
+            std::make_shared<parser::expression::Null>(std::nullopt)
+          },
+        },
+        builtins->record_type(),
+        ReadLines
+      ),
+      true
+    };
+    variables[U"range"] =
+    {
+      value::Function::MakeNative(
+        {
+          { U"start", builtins->int_type() },
+          {
+            U"stop",
+            type::MakeOptional(builtins->int_type()),
+            std::make_shared<parser::expression::Null>(std::nullopt)
+          },
+          {
+            U"step",
+            builtins->int_type(),
+            std::make_shared<parser::expression::Int>(std::nullopt, 1)
+          },
+        },
+        std::make_shared<type::List>(builtins->int_type()),
+        Range
+      ),
+      true
+    };
+    variables[U"JSON"] =
+    {
+      value::Record::Make({
+        {
+          U"parse",
+          value::Function::MakeNative(
+            { { U"text", builtins->string_type() } },
+            builtins->any_type(),
+            JsonParse
+          ),
+        },
+        {
+          U"stringify",
+          value::Function::MakeNative(
+            { { U"value", builtins->any_type() } },
+            builtins->string_type(),
+            JsonStringify
+          ),
+        },
+      }),
+      true
+    };
     variables[U"print"] =
     {
       value::Function::MakeNative(
-        { { U"objects", runtime->list_type(), nullptr, true } },
-        runtime->void_type(),
+        { { U"objects", builtins->list_type(), nullptr, true } },
+        builtins->void_type(),
         Print
       ),
       true
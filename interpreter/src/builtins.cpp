@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/interpreter/builtins.hpp"
+#include "snek/interpreter/type.hpp"
+
+namespace snek::interpreter
+{
+  using prototype_type = std::unordered_map<std::u32string, value::ptr>;
+  using prototype_constructor = void(*)(const Builtins*, prototype_type&);
+
+  namespace prototype
+  {
+    void MakeBoolean(const Builtins*, prototype_type&);
+    void MakeFloat(const Builtins*, prototype_type&);
+    void MakeFunction(const Builtins*, prototype_type&);
+    void MakeInt(const Builtins*, prototype_type&);
+    void MakeList(const Builtins*, prototype_type&);
+    void MakeNumber(const Builtins*, prototype_type&);
+    void MakeObject(const Builtins*, prototype_type&);
+    void MakeRecord(const Builtins*, prototype_type&);
+    void MakeSequence(const Builtins*, prototype_type&);
+    void MakeString(const Builtins*, prototype_type&);
+  }
+
+  static inline value::ptr
+  MakePrototype(
+    const Builtins* builtins,
+    const value::ptr& parent,
+    prototype_constructor constructor = nullptr
+  )
+  {
+    prototype_type fields;
+
+    fields[U"[[Prototype]]"] = parent;
+    if (constructor)
+    {
+      constructor(builtins, fields);
+    }
+
+    return value::Record::Make(fields);
+  }
+
+  const Builtins&
+  Builtins::Get()
+  {
+    static const Builtins builtins;
+
+    return builtins;
+  }
+
+  Builtins::Builtins()
+    : m_any_type(std::make_shared<type::Any>())
+    , m_boolean_type(std::make_shared<type::Builtin>(type::BuiltinKind::Boolean))
+    , m_float_type(std::make_shared<type::Builtin>(type::BuiltinKind::Float))
+    , m_function_type(std::make_shared<type::Builtin>(type::BuiltinKind::Function))
+    , m_int_type(std::make_shared<type::Builtin>(type::BuiltinKind::Int))
+    , m_list_type(std::make_shared<type::Builtin>(type::BuiltinKind::List))
+    , m_number_type(std::make_shared<type::Builtin>(type::BuiltinKind::Number))
+    , m_record_type(std::make_shared<type::Builtin>(type::BuiltinKind::Record))
+    , m_string_type(std::make_shared<type::Builtin>(type::BuiltinKind::String))
+    , m_void_type(std::make_shared<type::Builtin>(type::BuiltinKind::Void))
+
+    , m_object_prototype(MakePrototype(
+        this,
+        nullptr,
+        prototype::MakeObject
+      ))
+    , m_number_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeNumber
+      ))
+    , m_boolean_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeBoolean
+      ))
+    , m_float_prototype(MakePrototype(
+        this,
+        m_number_prototype,
+        prototype::MakeFloat
+      ))
+    , m_function_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeFunction
+      ))
+    , m_int_prototype(MakePrototype(
+        this,
+        m_number_prototype,
+        prototype::MakeInt
+      ))
+    , m_list_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeList
+      ))
+    , m_record_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeRecord
+      ))
+    , m_string_prototype(MakePrototype(
+        this,
+        m_object_prototype,
+        prototype::MakeString
+      ))
+    , m_sequence_prototype(MakePrototype(
+        this,
+        m_record_prototype,
+        prototype::MakeSequence
+      ))
+
+    , m_scope(Scope::MakeRootScope(this))
+#if defined(SNEK_ENABLE_BOOLEAN_CACHE)
+    , m_true_value(std::make_shared<value::Boolean>(true))
+    , m_false_value(std::make_shared<value::Boolean>(false))
+#endif
+  {
+#if defined(SNEK_ENABLE_INT_CACHE)
+    for (std::size_t i = 0; i < kIntCacheSize; ++i)
+    {
+      m_int_cache[i] = std::make_shared<value::Int>(kIntCacheMin + i);
+    }
+#endif
+  }
+}
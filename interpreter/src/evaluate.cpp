@@ -23,6 +23,8 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <array>
+
 #include "snek/interpreter/assign.hpp"
 #include "snek/interpreter/error.hpp"
 #include "snek/interpreter/evaluate.hpp"
@@ -55,6 +57,37 @@ namespace snek::interpreter
     return static_cast<const T*>(value.get());
   }
 
+  /**
+   * Values of binary and assignment operators are taken from token kinds, so
+   * tables indexed by them need this many slots.
+   */
+  static constexpr std::size_t kOperatorCount =
+    static_cast<std::size_t>(parser::Token::Kind::AssignNullCoalescing) + 1;
+
+  /**
+   * Returns name of the method which implements given binary or assignment
+   * operator. The names are kept in static storage, instead of being
+   * constructed again on every evaluation of an operator.
+   */
+  template<class T>
+  static const std::u32string&
+  GetMethodName(typename T::Operator op)
+  {
+    static const auto names = []()
+    {
+      std::array<std::u32string, kOperatorCount> names;
+
+      for (std::size_t i = 0; i < kOperatorCount; ++i)
+      {
+        names[i] = T::ToString(static_cast<typename T::Operator>(i));
+      }
+
+      return names;
+    }();
+
+    return names[static_cast<std::size_t>(op)];
+  }
+
   static void
   EvaluateElement(
     Runtime& runtime,
@@ -321,7 +354,7 @@ namespace snek::interpreter
           new_value = value::CallMethod(
             runtime,
             EvaluateExpression(runtime, scope, expression->variable),
-            Assign::ToString(*expression->op),
+            GetMethodName<Assign>(*expression->op),
             { EvaluateExpression(runtime, scope, expression->value) },
             expression->position
           );
@@ -366,7 +399,7 @@ namespace snek::interpreter
         return value::CallMethod(
           runtime,
           left,
-          Binary::ToString(expression->op),
+          GetMethodName<Binary>(expression->op),
           { EvaluateExpression(runtime, scope, expression->right) },
           expression->position,
           tail_call
@@ -466,11 +499,12 @@ namespace snek::interpreter
     bool tail_call
   )
   {
+    static const std::u32string method_name = U"-";
     auto value = EvaluateExpression(runtime, scope, expression->variable);
     const auto new_value = value::CallMethod(
       runtime,
       value,
-      U"-",
+      method_name,
       { runtime.MakeInt(1) },
       expression->position,
       tail_call
@@ -537,11 +571,12 @@ namespace snek::interpreter
     bool tail_call
   )
   {
+    static const std::u32string method_name = U"+";
     auto value = EvaluateExpression(runtime, scope, expression->variable);
     const auto new_value = value::CallMethod(
       runtime,
       value,
-      U"+",
+      method_name,
       { runtime.MakeInt(1) },
       expression->position,
       tail_call
@@ -631,6 +666,7 @@ namespace snek::interpreter
     bool tail_call
   )
   {
+    static const std::u32string method_name = U"[]";
     const auto value = EvaluateExpression(
       runtime,
       scope,
@@ -645,7 +681,7 @@ namespace snek::interpreter
     return value::CallMethod(
       runtime,
       value,
-      U"[]",
+      method_name,
       { EvaluateExpression(runtime, scope, expression->index) },
       expression->position,
       tail_call
@@ -672,22 +708,27 @@ namespace snek::interpreter
     );
   }
 
-  static std::u32string
+  static const std::u32string&
   GetMethodName(Unary::Operator op)
   {
+    static const std::u32string add = U"+@";
+    static const std::u32string bitwise_not = U"~";
+    static const std::u32string logical_not = U"!";
+    static const std::u32string sub = U"-@";
+
     switch (op)
     {
       case Unary::Operator::Add:
-        return U"+@";
+        return add;
 
       case Unary::Operator::BitwiseNot:
-        return U"~";
+        return bitwise_not;
 
       case Unary::Operator::Not:
-        return U"!";
+        return logical_not;
 
       case Unary::Operator::Sub:
-        return U"-@";
+        return sub;
     }
 
     throw Error{ {}, U"Unknown unary operator." };
@@ -735,6 +776,13 @@ namespace snek::interpreter
       return nullptr;
     }
 
+#if defined(SNEK_ENABLE_STATISTICS)
+    runtime.statistics().CountExpression(expression->kind());
+#endif
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::SiteScope site_scope(expression->position);
+#endif
+
     switch (expression->kind())
     {
       case Kind::Assign:
@@ -29,6 +29,7 @@
 #include "snek/interpreter/execute.hpp"
 #include "snek/interpreter/jump.hpp"
 #include "snek/interpreter/resolve.hpp"
+#include "snek/interpreter/sequence.hpp"
 #include "snek/parser/import.hpp"
 
 namespace snek::interpreter
@@ -96,6 +97,112 @@ namespace snek::interpreter
     return value;
   }
 
+  static value::ptr
+  ExecuteFor(
+    Runtime& runtime,
+    const Scope::ptr& scope,
+    const For* statement
+  )
+  {
+    const auto iterable = EvaluateExpression(
+      runtime,
+      scope,
+      statement->iterable
+    );
+    value::ptr value;
+    // Executes the loop body with given element and returns false if the
+    // loop should be terminated.
+    const auto iterate = [&](const value::ptr& element)
+    {
+      const auto iteration_scope = std::make_shared<Scope>(scope);
+
+      runtime.Checkpoint();
+      DeclareVar(
+        runtime,
+        iteration_scope,
+        statement->variable,
+        element,
+        false,
+        false
+      );
+      try
+      {
+        value = ExecuteStatement(runtime, iteration_scope, statement->body);
+      }
+      catch (const Jump& jump)
+      {
+        if (jump.kind() == JumpKind::Break)
+        {
+          return false;
+        }
+        else if (jump.kind() != JumpKind::Continue)
+        {
+          throw;
+        }
+      }
+
+      return true;
+    };
+
+    if (value::IsList(iterable))
+    {
+      const auto list = static_cast<const value::List*>(iterable.get());
+
+      for (std::size_t i = 0; i < list->GetSize(); ++i)
+      {
+        if (!iterate(list->At(i)))
+        {
+          break;
+        }
+      }
+    }
+    else if (value::IsString(iterable))
+    {
+      const auto string = static_cast<const value::String*>(iterable.get());
+
+      for (std::size_t i = 0; i < string->GetLength(); ++i)
+      {
+        if (!iterate(value::String::Make(std::u32string(1, string->At(i)))))
+        {
+          break;
+        }
+      }
+    }
+    else if (sequence::IsSequence(iterable))
+    {
+      sequence::Stream(
+        runtime,
+        iterable,
+        [&iterate](const value::ptr& element, std::size_t)
+        {
+          return iterate(element);
+        }
+      );
+    }
+    else if (value::IsRecord(iterable))
+    {
+      const auto keys = static_cast<const value::Record*>(
+        iterable.get()
+      )->GetOwnPropertyNames();
+
+      for (const auto& key : keys)
+      {
+        if (!iterate(value::String::Make(key)))
+        {
+          break;
+        }
+      }
+    } else {
+      throw runtime.MakeError(
+        U"Cannot iterate over " +
+        value::ToString(value::KindOf(iterable)) +
+        U"."
+      );
+    }
+
+    return value;
+  }
+
   static value::ptr
   ExecuteIf(
     Runtime& runtime,
@@ -250,6 +357,7 @@ namespace snek::interpreter
 
     for (;;)
     {
+      runtime.Checkpoint();
       try
       {
         const auto condition = value::ToBoolean(
@@ -312,6 +420,13 @@ namespace snek::interpreter
       return nullptr;
     }
 
+#if defined(SNEK_ENABLE_STATISTICS)
+    runtime.statistics().CountStatement(statement->kind());
+#endif
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::SiteScope site_scope(statement->position);
+#endif
+
     switch (statement->kind())
     {
       case Kind::Block:
@@ -334,6 +449,9 @@ namespace snek::interpreter
           As<Expression>(statement)->expression
         );
 
+      case Kind::For:
+        return ExecuteFor(runtime, scope, As<For>(statement));
+
       case Kind::If:
         return ExecuteIf(runtime, scope, As<If>(statement));
 
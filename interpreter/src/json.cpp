@@ -0,0 +1,856 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#  include <emmintrin.h>
+#  define SNEK_JSON_USE_SSE2 1
+#endif
+
+#include "snek/interpreter/error.hpp"
+#include "snek/interpreter/json.hpp"
+#include "snek/interpreter/runtime.hpp"
+#include "snek/parser/utils.hpp"
+
+namespace snek::interpreter::json
+{
+  /**
+   * Maximum nesting depth of arrays and objects, so that malicious input
+   * cannot exhaust the stack.
+   */
+  static constexpr std::size_t kMaxDepth = 512;
+
+  static inline bool
+  IsWhitespace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+  }
+
+  static inline bool
+  IsDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  /**
+   * Returns pointer to first byte in given range which is not whitespace.
+   * Indented documents contain long runs of whitespace, which are skipped
+   * 16 bytes at a time when SSE2 is available.
+   */
+  static inline const char*
+  SkipWhitespace(const char* current, const char* end)
+  {
+    if (current < end && !IsWhitespace(*current))
+    {
+      return current;
+    }
+#if defined(SNEK_JSON_USE_SSE2)
+    const auto space = _mm_set1_epi8(' ');
+    const auto newline = _mm_set1_epi8('\n');
+    const auto carriage_return = _mm_set1_epi8('\r');
+    const auto tab = _mm_set1_epi8('\t');
+
+    while (end - current >= 16)
+    {
+      const auto chunk = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(current)
+      );
+      const auto whitespace = _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, space),
+          _mm_cmpeq_epi8(chunk, newline)
+        ),
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, carriage_return),
+          _mm_cmpeq_epi8(chunk, tab)
+        )
+      );
+      const auto mask = ~_mm_movemask_epi8(whitespace) & 0xffff;
+
+      if (mask)
+      {
+        return current + __builtin_ctz(static_cast<unsigned>(mask));
+      }
+      current += 16;
+    }
+#endif
+    while (current < end && IsWhitespace(*current))
+    {
+      ++current;
+    }
+
+    return current;
+  }
+
+  /**
+   * Returns pointer to first byte in given range which either terminates
+   * a string, begins an escape sequence, is a control character or is not
+   * ASCII. Bytes before it can be copied into the string as they are.
+   */
+  static inline const char*
+  ScanString(const char* current, const char* end)
+  {
+#if defined(SNEK_JSON_USE_SSE2)
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto space = _mm_set1_epi8(' ');
+
+    while (end - current >= 16)
+    {
+      const auto chunk = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(current)
+      );
+      // Signed comparison against space catches both control characters and
+      // bytes with the high bit set.
+      const auto special = _mm_or_si128(
+        _mm_or_si128(
+          _mm_cmpeq_epi8(chunk, quote),
+          _mm_cmpeq_epi8(chunk, backslash)
+        ),
+        _mm_cmplt_epi8(chunk, space)
+      );
+      const auto mask = _mm_movemask_epi8(special);
+
+      if (mask)
+      {
+        return current + __builtin_ctz(static_cast<unsigned>(mask));
+      }
+      current += 16;
+    }
+#endif
+    while (current < end)
+    {
+      const auto c = static_cast<unsigned char>(*current);
+
+      if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80)
+      {
+        break;
+      }
+      ++current;
+    }
+
+    return current;
+  }
+
+  namespace
+  {
+    class Parser final
+    {
+    public:
+      DISALLOW_COPY_AND_ASSIGN(Parser);
+
+      explicit Parser(Runtime& runtime, const std::string& input)
+        : m_runtime(runtime)
+        , m_begin(input.data())
+        , m_current(input.data())
+        , m_end(input.data() + input.length()) {}
+
+      value::ptr
+      ParseDocument()
+      {
+        const auto value = ParseValue(0);
+
+        m_current = SkipWhitespace(m_current, m_end);
+        if (m_current < m_end)
+        {
+          throw MakeError(U"Unexpected data after JSON value");
+        }
+
+        return value;
+      }
+
+    private:
+      Error
+      MakeError(const std::u32string& message) const
+      {
+        return m_runtime.MakeError(
+          message +
+          U" at position " +
+          parser::utils::IntToString(m_current - m_begin) +
+          U"."
+        );
+      }
+
+      inline bool
+      PeekChar(char expected)
+      {
+        m_current = SkipWhitespace(m_current, m_end);
+
+        return m_current < m_end && *m_current == expected;
+      }
+
+      void
+      ReadChar(char expected)
+      {
+        if (!PeekChar(expected))
+        {
+          throw MakeError(
+            m_current < m_end
+              ? U"Unexpected character in JSON"
+              : U"Unexpected end of JSON input"
+          );
+        }
+        ++m_current;
+      }
+
+      value::ptr
+      ParseValue(std::size_t depth)
+      {
+        m_current = SkipWhitespace(m_current, m_end);
+        if (m_current >= m_end)
+        {
+          throw MakeError(U"Unexpected end of JSON input");
+        }
+        switch (*m_current)
+        {
+          case '{':
+            return ParseObject(depth + 1);
+
+          case '[':
+            return ParseArray(depth + 1);
+
+          case '"':
+            return value::String::Make(ParseString());
+
+          case 't':
+            ParseLiteral("true");
+            return m_runtime.MakeBoolean(true);
+
+          case 'f':
+            ParseLiteral("false");
+            return m_runtime.MakeBoolean(false);
+
+          case 'n':
+            ParseLiteral("null");
+            return nullptr;
+
+          default:
+            if (*m_current == '-' || IsDigit(*m_current))
+            {
+              return ParseNumber();
+            }
+            throw MakeError(U"Unexpected character in JSON");
+        }
+      }
+
+      value::ptr
+      ParseObject(std::size_t depth)
+      {
+        std::unordered_map<std::u32string, value::ptr> fields;
+
+        if (depth > kMaxDepth)
+        {
+          throw MakeError(U"JSON input is nested too deeply");
+        }
+        ++m_current;
+        if (PeekChar('}'))
+        {
+          ++m_current;
+
+          return value::Record::Make(fields);
+        }
+        for (;;)
+        {
+          std::u32string key;
+
+          if (!PeekChar('"'))
+          {
+            throw MakeError(U"Expected string as JSON object key");
+          }
+          key = ParseString();
+          ReadChar(':');
+          fields[key] = ParseValue(depth);
+          if (!PeekChar(','))
+          {
+            break;
+          }
+          ++m_current;
+        }
+        ReadChar('}');
+
+        return value::Record::Make(fields);
+      }
+
+      value::ptr
+      ParseArray(std::size_t depth)
+      {
+        std::vector<value::ptr> elements;
+
+        if (depth > kMaxDepth)
+        {
+          throw MakeError(U"JSON input is nested too deeply");
+        }
+        ++m_current;
+        if (PeekChar(']'))
+        {
+          ++m_current;
+
+          return value::List::Make(elements);
+        }
+        for (;;)
+        {
+          elements.push_back(ParseValue(depth));
+          if (!PeekChar(','))
+          {
+            break;
+          }
+          ++m_current;
+        }
+        ReadChar(']');
+
+        return value::List::Make(elements);
+      }
+
+      void
+      ParseLiteral(const char* literal)
+      {
+        const auto length = std::strlen(literal);
+
+        if (static_cast<std::size_t>(m_end - m_current) < length ||
+            std::memcmp(m_current, literal, length))
+        {
+          throw MakeError(U"Unexpected character in JSON");
+        }
+        m_current += length;
+      }
+
+      value::ptr
+      ParseNumber()
+      {
+        const auto start = m_current;
+        const bool negative = *m_current == '-';
+        bool integer = true;
+        std::uint64_t magnitude = 0;
+        bool overflow = false;
+
+        if (negative)
+        {
+          ++m_current;
+        }
+        if (m_current < m_end && *m_current == '0')
+        {
+          ++m_current;
+        }
+        else if (m_current < m_end && IsDigit(*m_current))
+        {
+          do
+          {
+            const auto digit = static_cast<std::uint64_t>(*m_current - '0');
+
+            if (magnitude > (UINT64_MAX - digit) / 10)
+            {
+              overflow = true;
+            } else {
+              magnitude = magnitude * 10 + digit;
+            }
+            ++m_current;
+          }
+          while (m_current < m_end && IsDigit(*m_current));
+        } else {
+          throw MakeError(U"Invalid number in JSON");
+        }
+        if (m_current < m_end && *m_current == '.')
+        {
+          integer = false;
+          ++m_current;
+          SkipDigits();
+        }
+        if (m_current < m_end && (*m_current == 'e' || *m_current == 'E'))
+        {
+          integer = false;
+          ++m_current;
+          if (m_current < m_end && (*m_current == '+' || *m_current == '-'))
+          {
+            ++m_current;
+          }
+          SkipDigits();
+        }
+
+        if (integer && !overflow)
+        {
+          if (!negative && magnitude <= INT64_MAX)
+          {
+            return m_runtime.MakeInt(static_cast<std::int64_t>(magnitude));
+          }
+          else if (negative && magnitude <= 0x8000000000000000ULL)
+          {
+            return m_runtime.MakeInt(
+              static_cast<std::int64_t>(0 - magnitude)
+            );
+          }
+        }
+
+        return std::make_shared<value::Float>(ParseFloat(start, m_current));
+      }
+
+      /**
+       * Converts already validated number into a float independent of the
+       * current locale. Numbers beyond the range of double become infinity
+       * or zero, like they would with strtod.
+       */
+      static double
+      ParseFloat(const char* start, const char* end)
+      {
+        double value = 0.0;
+        const auto result = std::from_chars(start, end, value);
+
+        if (result.ec == std::errc::result_out_of_range)
+        {
+          const auto exponent = std::find_if(
+            start,
+            end,
+            [](char c) { return c == 'e' || c == 'E'; }
+          );
+
+          value = exponent + 1 < end && exponent[1] == '-'
+            ? 0.0
+            : HUGE_VAL;
+          if (*start == '-')
+          {
+            value = -value;
+          }
+        }
+
+        return value;
+      }
+
+      void
+      SkipDigits()
+      {
+        if (m_current >= m_end || !IsDigit(*m_current))
+        {
+          throw MakeError(U"Invalid number in JSON");
+        }
+        do
+        {
+          ++m_current;
+        }
+        while (m_current < m_end && IsDigit(*m_current));
+      }
+
+      std::u32string
+      ParseString()
+      {
+        std::u32string result;
+
+        ++m_current;
+        for (;;)
+        {
+          const auto run_end = ScanString(m_current, m_end);
+
+          result.append(m_current, run_end);
+          m_current = run_end;
+          if (m_current >= m_end)
+          {
+            throw MakeError(U"Unterminated string in JSON");
+          }
+
+          const auto c = static_cast<unsigned char>(*m_current);
+
+          if (c == '"')
+          {
+            ++m_current;
+
+            return result;
+          }
+          else if (c == '\\')
+          {
+            result.append(1, ParseEscape());
+          }
+          else if (c < 0x20)
+          {
+            throw MakeError(U"Control character in JSON string");
+          } else {
+            result.append(1, DecodeSequence());
+          }
+        }
+      }
+
+      char32_t
+      ParseEscape()
+      {
+        char32_t c;
+
+        if (m_end - m_current < 2)
+        {
+          throw MakeError(U"Unterminated string in JSON");
+        }
+        m_current += 2;
+        switch (m_current[-1])
+        {
+          case '"':
+          case '\\':
+          case '/':
+            return m_current[-1];
+
+          case 'b':
+            return 010;
+
+          case 'f':
+            return 014;
+
+          case 'n':
+            return 012;
+
+          case 'r':
+            return 015;
+
+          case 't':
+            return 011;
+
+          case 'u':
+            break;
+
+          default:
+            throw MakeError(U"Invalid escape sequence in JSON string");
+        }
+        c = ParseHex();
+        if (c >= 0xd800 && c <= 0xdbff)
+        {
+          char32_t low;
+
+          if (m_end - m_current < 2 || m_current[0] != '\\' ||
+              m_current[1] != 'u')
+          {
+            throw MakeError(U"Unpaired surrogate in JSON string");
+          }
+          m_current += 2;
+          low = ParseHex();
+          if (low < 0xdc00 || low > 0xdfff)
+          {
+            throw MakeError(U"Unpaired surrogate in JSON string");
+          }
+          c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+        }
+        else if (c >= 0xdc00 && c <= 0xdfff)
+        {
+          throw MakeError(U"Unpaired surrogate in JSON string");
+        }
+
+        return c;
+      }
+
+      char32_t
+      ParseHex()
+      {
+        char32_t result = 0;
+
+        if (m_end - m_current < 4)
+        {
+          throw MakeError(U"Invalid escape sequence in JSON string");
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+          const auto c = *m_current++;
+
+          result <<= 4;
+          if (IsDigit(c))
+          {
+            result |= c - '0';
+          }
+          else if (c >= 'a' && c <= 'f')
+          {
+            result |= c - 'a' + 10;
+          }
+          else if (c >= 'A' && c <= 'F')
+          {
+            result |= c - 'A' + 10;
+          } else {
+            throw MakeError(U"Invalid escape sequence in JSON string");
+          }
+        }
+
+        return result;
+      }
+
+      /**
+       * Decodes single multibyte UTF-8 sequence, rejecting overlong
+       * encodings, surrogates and code points beyond Unicode range.
+       */
+      char32_t
+      DecodeSequence()
+      {
+        const auto lead = static_cast<unsigned char>(*m_current);
+        std::size_t length;
+        char32_t result;
+        char32_t minimum;
+
+        if ((lead & 0xe0) == 0xc0)
+        {
+          length = 2;
+          result = lead & 0x1f;
+          minimum = 0x80;
+        }
+        else if ((lead & 0xf0) == 0xe0)
+        {
+          length = 3;
+          result = lead & 0x0f;
+          minimum = 0x800;
+        }
+        else if ((lead & 0xf8) == 0xf0)
+        {
+          length = 4;
+          result = lead & 0x07;
+          minimum = 0x10000;
+        } else {
+          throw MakeError(U"Invalid UTF-8 in JSON input");
+        }
+        if (static_cast<std::size_t>(m_end - m_current) < length)
+        {
+          throw MakeError(U"Invalid UTF-8 in JSON input");
+        }
+        for (std::size_t i = 1; i < length; ++i)
+        {
+          const auto c = static_cast<unsigned char>(m_current[i]);
+
+          if ((c & 0xc0) != 0x80)
+          {
+            throw MakeError(U"Invalid UTF-8 in JSON input");
+          }
+          result = (result << 6) | (c & 0x3f);
+        }
+        if (result < minimum ||
+            result > 0x10ffff ||
+            (result >= 0xd800 && result <= 0xdfff))
+        {
+          throw MakeError(U"Invalid UTF-8 in JSON input");
+        }
+        m_current += length;
+
+        return result;
+      }
+
+    private:
+      Runtime& m_runtime;
+      const char* const m_begin;
+      const char* m_current;
+      const char* const m_end;
+    };
+  }
+
+  value::ptr
+  Parse(Runtime& runtime, const std::string& input)
+  {
+    return Parser(runtime, input).ParseDocument();
+  }
+
+  static void
+  StringifyString(const std::u32string& input, std::u32string& output)
+  {
+    static const char32_t hex_digits[] = U"0123456789abcdef";
+
+    output.push_back(U'"');
+    for (const auto c : input)
+    {
+      if (c == U'"' || c == U'\\')
+      {
+        output.push_back(U'\\');
+        output.push_back(c);
+      }
+      else if (c < 0x20)
+      {
+        switch (c)
+        {
+          case 010:
+            output.append(U"\\b");
+            break;
+
+          case 011:
+            output.append(U"\\t");
+            break;
+
+          case 012:
+            output.append(U"\\n");
+            break;
+
+          case 014:
+            output.append(U"\\f");
+            break;
+
+          case 015:
+            output.append(U"\\r");
+            break;
+
+          default:
+            output.append(U"\\u00");
+            output.push_back(hex_digits[c >> 4]);
+            output.push_back(hex_digits[c & 0xf]);
+            break;
+        }
+      }
+      else if ((c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff)
+      {
+        // Lone surrogates and code points beyond Unicode range cannot be
+        // encoded in UTF-8 when the output is written somewhere.
+        output.append(U"\\ufffd");
+      } else {
+        output.push_back(c);
+      }
+    }
+    output.push_back(U'"');
+  }
+
+  static void
+  StringifyFloat(double value, std::u32string& output)
+  {
+    char buffer[32];
+
+    if (!std::isfinite(value))
+    {
+      output.append(U"null");
+      return;
+    }
+    // Shortest representation which parses back into the same value,
+    // independent of the current locale.
+    const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+
+    output.append(buffer, end);
+    // Keep floats as floats when the output is parsed again.
+    if (std::find_if(buffer, end, [](char c) { return c == '.' || c == 'e'; })
+        == end)
+    {
+      output.append(U".0");
+    }
+  }
+
+  static void
+  StringifyValue(
+    const Runtime& runtime,
+    const value::ptr& value,
+    std::u32string& output,
+    std::size_t depth
+  )
+  {
+    switch (value::KindOf(value))
+    {
+      case value::Kind::Null:
+        output.append(U"null");
+        break;
+
+      case value::Kind::Boolean:
+        output.append(
+          static_cast<const value::Boolean*>(value.get())->value
+            ? U"true"
+            : U"false"
+        );
+        break;
+
+      case value::Kind::Int:
+        {
+          char buffer[24];
+          const auto result = std::to_chars(
+            buffer,
+            buffer + sizeof(buffer),
+            static_cast<const value::Int*>(value.get())->value
+          );
+
+          output.append(buffer, result.ptr);
+        }
+        break;
+
+      case value::Kind::Float:
+        StringifyFloat(
+          static_cast<const value::Float*>(value.get())->value,
+          output
+        );
+        break;
+
+      case value::Kind::String:
+        StringifyString(value->ToString(), output);
+        break;
+
+      case value::Kind::List:
+        {
+          const auto list = static_cast<const value::List*>(value.get());
+          const auto size = list->GetSize();
+
+          if (depth > kMaxDepth)
+          {
+            throw runtime.MakeError(U"Value is nested too deeply for JSON.");
+          }
+          output.push_back(U'[');
+          for (std::size_t i = 0; i < size; ++i)
+          {
+            if (i > 0)
+            {
+              output.push_back(U',');
+            }
+            StringifyValue(runtime, list->At(i), output, depth + 1);
+          }
+          output.push_back(U']');
+        }
+        break;
+
+      case value::Kind::Record:
+        {
+          const auto record = static_cast<const value::Record*>(value.get());
+          bool first = true;
+
+          if (depth > kMaxDepth)
+          {
+            throw runtime.MakeError(U"Value is nested too deeply for JSON.");
+          }
+          output.push_back(U'{');
+          for (const auto& name : record->GetOwnPropertyNames())
+          {
+            if (first)
+            {
+              first = false;
+            } else {
+              output.push_back(U',');
+            }
+            StringifyString(name, output);
+            output.push_back(U':');
+            StringifyValue(
+              runtime,
+              *record->GetOwnProperty(name),
+              output,
+              depth + 1
+            );
+          }
+          output.push_back(U'}');
+        }
+        break;
+
+      case value::Kind::Function:
+        throw runtime.MakeError(U"Cannot convert Function to JSON.");
+    }
+  }
+
+  void
+  Stringify(
+    const Runtime& runtime,
+    const value::ptr& value,
+    std::u32string& output
+  )
+  {
+    StringifyValue(runtime, value, output, 0);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#if defined(_WIN32)
+#  include <fstream>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "snek/interpreter/mapped_file.hpp"
+
+namespace snek::interpreter
+{
+  MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+  {
+#if defined(_WIN32)
+    std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
+
+    if (ifs.good())
+    {
+      m_storage.append(
+        std::istreambuf_iterator<char>(ifs),
+        std::istreambuf_iterator<char>()
+      );
+      if (!m_storage.empty())
+      {
+        m_data = m_storage.data();
+        m_size = m_storage.length();
+      }
+    }
+#else
+    const auto fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+
+    if (fd < 0)
+    {
+      return;
+    }
+    if (!fstat(fd, &st) && st.st_size > 0)
+    {
+      const auto address = mmap(
+        nullptr,
+        st.st_size,
+        PROT_READ,
+        MAP_PRIVATE,
+        fd,
+        0
+      );
+
+      if (address != MAP_FAILED)
+      {
+        m_data = static_cast<const char*>(address);
+        m_size = st.st_size;
+      }
+    }
+    close(fd);
+#endif
+  }
+
+  MappedFile::~MappedFile()
+  {
+#if !defined(_WIN32)
+    if (m_data)
+    {
+      munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+  }
+}
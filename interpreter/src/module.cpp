@@ -23,36 +23,535 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <optional>
+#include <random>
 
 #include <peelo/unicode/encoding/utf8.hpp>
 
 #include "snek/interpreter/error.hpp"
+#include "snek/interpreter/mapped_file.hpp"
+#include "snek/interpreter/module.hpp"
 #include "snek/interpreter/runtime.hpp"
+#include "snek/parser/error.hpp"
+#include "snek/parser/serialize.hpp"
+#include "snek/parser/utils.hpp"
 
 namespace snek::interpreter
 {
-  Scope::ptr
-  ImportFilesystemModule(Runtime& runtime, const std::u32string& path)
+  namespace
   {
-    using peelo::unicode::encoding::utf8::encode;
+    using statement_container_type = std::vector<parser::statement::ptr>;
 
-    std::ifstream ifs(encode(path));
-    std::string source;
-    Scope::ptr module;
+    /**
+     * Header of compiled module file. Serialized syntax tree of the module
+     * follows immediately after it. Compiled module files are not meant to be
+     * portable between machines, so the header is stored in native byte order.
+     */
+    struct CompiledModuleHeader
+    {
+      char magic[4];
+      std::uint32_t version;
+      std::uint64_t source_size;
+      std::int64_t source_mtime;
+      std::uint64_t source_hash;
+    };
+
+    static constexpr char kCompiledModuleMagic[4] = { 'S', 'N', 'K', 'C' };
+  }
+
+  static std::uint64_t
+  HashSource(const std::string& source)
+  {
+    // 64-bit FNV-1a.
+    std::uint64_t hash = 0xcbf29ce484222325;
+
+    for (const auto c : source)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001b3;
+    }
+
+    return hash;
+  }
+
+  static std::optional<std::string>
+  ReadSource(const std::string& path)
+  {
+    std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
 
     if (!ifs.good())
     {
-      throw runtime.MakeError(U"Unable to find module `" + path + U"'.");
+      return std::nullopt;
     }
-    source.append(
+
+    return std::string(
       std::istreambuf_iterator<char>(ifs),
       std::istreambuf_iterator<char>()
     );
-    ifs.close();
-    module = std::make_shared<Scope>(runtime.root_scope());
+  }
+
+  static statement_container_type
+  ParseSource(const std::string& source, const std::u32string& path)
+  {
+    parser::Lexer lexer(source.data(), source.length(), path);
+    statement_container_type statements;
+
+    while (!lexer.PeekToken(parser::Token::Kind::Eof))
+    {
+      statements.push_back(parser::statement::Parse(lexer, true));
+    }
+
+    return statements;
+  }
+
+  static inline std::string
+  GetCompiledModulePath(const std::string& path)
+  {
+    return path + "c";
+  }
+
+  static std::int64_t
+  GetModificationTime(const std::string& path, std::error_code& ec)
+  {
+    return static_cast<std::int64_t>(
+      std::filesystem::last_write_time(path, ec).time_since_epoch().count()
+    );
+  }
+
+  /**
+   * Writes given data into a file. The data is first written under temporary
+   * name and then renamed, so that concurrent processes, including ones which
+   * have the previous version of the file mapped into memory, never see a
+   * partially written file.
+   */
+  static bool
+  WriteFileAtomically(const std::string& path, const std::string& data)
+  {
+    const auto temporary_path = path
+      + ".tmp"
+      + std::to_string(std::random_device()());
+    std::error_code ec;
+
+    {
+      std::ofstream ofs(
+        temporary_path,
+        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc
+      );
+
+      if (!ofs.good() || !ofs.write(data.data(), data.length()))
+      {
+        ofs.close();
+        std::filesystem::remove(temporary_path, ec);
+
+        return false;
+      }
+    }
+    std::filesystem::rename(temporary_path, path, ec);
+    if (ec)
+    {
+      std::filesystem::remove(temporary_path, ec);
+
+      return false;
+    }
+
+    return true;
+  }
+
+#if defined(SNEK_ENABLE_MODULE_CACHE)
+  /**
+   * Attempts to load syntax tree of an module from it's compiled module file.
+   * The compiled module is considered to be valid if size and modification
+   * time of the source file match those stored in the header. If only the
+   * modification time differs, the source file is read (and returned to the
+   * caller through the `source` argument) and it's hash is compared instead.
+   */
+  static std::optional<statement_container_type>
+  LoadCompiledModule(
+    const std::string& path,
+    const std::u32string& filename,
+    std::uint64_t source_size,
+    std::int64_t source_mtime,
+    std::optional<std::string>& source
+  )
+  {
+    const auto compiled_path = GetCompiledModulePath(path);
+    const MappedFile file(compiled_path);
+    CompiledModuleHeader header;
+    statement_container_type statements;
+
+    if (!file.data() || file.size() < sizeof(CompiledModuleHeader))
+    {
+      return std::nullopt;
+    }
+    std::memcpy(&header, file.data(), sizeof(CompiledModuleHeader));
+    if (
+      std::memcmp(header.magic, kCompiledModuleMagic, 4) ||
+      header.version != parser::serialize::kVersion ||
+      header.source_size != source_size
+    )
+    {
+      return std::nullopt;
+    }
+    else if (
+      header.source_mtime != source_mtime &&
+      (
+        !(source = ReadSource(path)) ||
+        HashSource(*source) != header.source_hash
+      )
+    )
+    {
+      return std::nullopt;
+    }
+
+    try
+    {
+      statements = parser::serialize::Deserialize(
+        file.data() + sizeof(CompiledModuleHeader),
+        file.size() - sizeof(CompiledModuleHeader),
+        filename
+      );
+    }
+    catch (const parser::SyntaxError&)
+    {
+      return std::nullopt;
+    }
+
+    // Source file has been touched without modifying it's contents, so update
+    // the header to skip hashing of the source next time. The file is
+    // replaced instead of being modified in place, as other processes may
+    // have it mapped into memory.
+    if (header.source_mtime != source_mtime)
+    {
+      std::string output;
+
+      header.source_mtime = source_mtime;
+      output.reserve(file.size());
+      output.append(
+        reinterpret_cast<const char*>(&header),
+        sizeof(CompiledModuleHeader)
+      );
+      output.append(
+        file.data() + sizeof(CompiledModuleHeader),
+        file.size() - sizeof(CompiledModuleHeader)
+      );
+      WriteFileAtomically(compiled_path, output);
+    }
+
+    return statements;
+  }
+#endif
+
+  /**
+   * Writes compiled module file for given module.
+   */
+  static bool
+  WriteCompiledModule(
+    const std::string& path,
+    const statement_container_type& statements,
+    std::uint64_t source_size,
+    std::int64_t source_mtime,
+    std::uint64_t source_hash
+  )
+  {
+    CompiledModuleHeader header;
+    std::string output;
+
+    std::memcpy(header.magic, kCompiledModuleMagic, 4);
+    header.version = parser::serialize::kVersion;
+    header.source_size = source_size;
+    header.source_mtime = source_mtime;
+    header.source_hash = source_hash;
+    output.append(
+      reinterpret_cast<const char*>(&header),
+      sizeof(CompiledModuleHeader)
+    );
+    parser::serialize::Serialize(statements, output);
+
+    return WriteFileAtomically(GetCompiledModulePath(path), output);
+  }
+
+  static Scope::ptr
+  MakeModuleScope(const Runtime& runtime, const std::u32string& path)
+  {
+    const auto module = std::make_shared<Scope>(runtime.root_scope());
+
     module->DeclareVariable(U"__name__", value::String::Make(path));
-    runtime.RunScript(module, source, path);
+
+    return module;
+  }
+
+  LoadedModule
+  LoadFilesystemModule(const std::u32string& path, bool write_compiled)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    const auto native_path = encode(path);
+    LoadedModule module;
+#if defined(SNEK_ENABLE_MODULE_CACHE)
+    std::error_code ec;
+    const auto source_size = std::filesystem::file_size(native_path, ec);
+    const auto source_mtime = ec
+      ? 0
+      : GetModificationTime(native_path, ec);
+
+    if (!ec && (module.statements = LoadCompiledModule(
+      native_path,
+      path,
+      source_size,
+      source_mtime,
+      module.source
+    )))
+    {
+      module.source.reset();
+
+      return module;
+    }
+#endif
+    if (!module.source && !(module.source = ReadSource(native_path)))
+    {
+      return module;
+    }
+    try
+    {
+      module.statements = ParseSource(*module.source, path);
+    }
+    catch (const parser::SyntaxError&)
+    {
+      return module;
+    }
+#if defined(SNEK_ENABLE_MODULE_CACHE)
+    if (!ec)
+    {
+      module.source_size = source_size;
+      module.source_mtime = source_mtime;
+      module.source_hash = HashSource(*module.source);
+      if (write_compiled)
+      {
+        WriteCompiledModule(path, module);
+      }
+    }
+#endif
+    module.source.reset();
+
+    return module;
+  }
+
+  void
+  WriteCompiledModule(const std::u32string& path, LoadedModule& module)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    if (!module.source_size || !module.statements)
+    {
+      return;
+    }
+    WriteCompiledModule(
+      encode(path),
+      *module.statements,
+      *module.source_size,
+      module.source_mtime,
+      module.source_hash
+    );
+    module.source_size.reset();
+  }
+
+  Scope::ptr
+  ImportFilesystemModule(Runtime& runtime, const std::u32string& path)
+  {
+    Scope::ptr module;
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+    auto& prefetcher = runtime.module_prefetcher();
+    const auto loaded = prefetcher.Load(path);
+#else
+    const auto loaded = LoadFilesystemModule(path);
+#endif
+
+    if (loaded.statements)
+    {
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+      // Start loading modules imported by this one while it's being executed.
+      prefetcher.Prefetch(*loaded.statements);
+#endif
+      module = MakeModuleScope(runtime, path);
+      runtime.RunStatements(module, *loaded.statements, path);
+    }
+    else if (loaded.source)
+    {
+      // Let the module run until the syntax error, so that the error is
+      // reported in the usual way.
+      module = MakeModuleScope(runtime, path);
+      runtime.RunScript(module, *loaded.source, path);
+    } else {
+      throw runtime.MakeError(U"Unable to find module `" + path + U"'.");
+    }
+
+    return module;
+  }
+
+  void
+  CompileFilesystemModule(Runtime& runtime, const std::u32string& path)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    const auto native_path = encode(path);
+    const auto source = ReadSource(native_path);
+    std::error_code ec;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+    statement_container_type statements;
+
+    if (!source)
+    {
+      throw runtime.MakeError(U"Unable to find module `" + path + U"'.");
+    }
+    source_size = std::filesystem::file_size(native_path, ec);
+    if (!ec)
+    {
+      source_mtime = GetModificationTime(native_path, ec);
+    }
+    if (ec)
+    {
+      throw runtime.MakeError(U"Unable to stat module `" + path + U"'.");
+    }
+    try
+    {
+      statements = ParseSource(*source, path);
+    }
+    catch (const parser::SyntaxError& e)
+    {
+      throw runtime.MakeError(e.ToString());
+    }
+    if (!WriteCompiledModule(
+      native_path,
+      statements,
+      source_size,
+      source_mtime,
+      HashSource(*source)
+    ))
+    {
+      throw runtime.MakeError(
+        U"Unable to write compiled module for `" + path + U"'."
+      );
+    }
+  }
+
+  ModulePrefetcher::ModulePrefetcher(ThreadPool& pool)
+    : m_pool(pool)
+    , m_state(std::make_shared<State>()) {}
+
+  void
+  ModulePrefetcher::Prefetch(const std::u32string& path)
+  {
+    Prefetch(m_pool, m_state, path);
+  }
+
+  void
+  ModulePrefetcher::Prefetch(
+    const std::vector<parser::statement::ptr>& statements
+  )
+  {
+    Prefetch(m_pool, m_state, statements);
+  }
+
+  void
+  ModulePrefetcher::Prefetch(
+    ThreadPool& pool,
+    const std::shared_ptr<State>& state,
+    const std::u32string& path
+  )
+  {
+    const auto entry = std::make_shared<Entry>();
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+
+      if (
+        parser::utils::IsBlank(path) ||
+        !state->requested.insert(path).second
+      )
+      {
+        return;
+      }
+      state->pending[path] = entry;
+    }
+    pool.Submit([&pool, weak_state = std::weak_ptr<State>(state), path, entry]()
+    {
+      // Nobody is going to import the module if the prefetcher is already
+      // gone.
+      const auto state = weak_state.lock();
+
+      if (!state || entry->claimed.exchange(true))
+      {
+        return;
+      }
+      try
+      {
+        // Compiled module file is written only once the module is actually
+        // imported.
+        auto module = LoadFilesystemModule(path, false);
+
+        if (module.statements)
+        {
+          Prefetch(pool, state, *module.statements);
+        }
+        entry->promise.set_value(std::move(module));
+      }
+      catch (...)
+      {
+        entry->promise.set_exception(std::current_exception());
+      }
+    });
+  }
+
+  void
+  ModulePrefetcher::Prefetch(
+    ThreadPool& pool,
+    const std::shared_ptr<State>& state,
+    const std::vector<parser::statement::ptr>& statements
+  )
+  {
+    for (const auto& statement : statements)
+    {
+      if (statement && statement->kind() == parser::statement::Kind::Import)
+      {
+        Prefetch(pool, state, static_cast<const parser::statement::Import*>(
+          statement.get()
+        )->path);
+      }
+    }
+  }
+
+  LoadedModule
+  ModulePrefetcher::Load(const std::u32string& path)
+  {
+    std::shared_ptr<Entry> entry;
+    LoadedModule module;
+
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      const auto pending = m_state->pending.find(path);
+
+      m_state->requested.insert(path);
+      if (pending != std::end(m_state->pending))
+      {
+        entry = pending->second;
+        m_state->pending.erase(pending);
+      }
+    }
+
+    // If no background thread has started loading the module yet, it's
+    // faster to load it here than to wait for one to become available.
+    if (!entry || !entry->claimed.exchange(true))
+    {
+      return LoadFilesystemModule(path);
+    }
+    module = entry->promise.get_future().get();
+    WriteCompiledModule(path, module);
 
     return module;
   }
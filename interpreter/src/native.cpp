@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/interpreter/evaluate.hpp"
+#include "snek/interpreter/native.hpp"
+
+namespace snek::interpreter::native
+{
+  value::ptr
+  GetDefaultArgument(
+    Runtime& runtime,
+    const interpreter::Parameter& parameter
+  )
+  {
+    if (!parameter.default_value)
+    {
+      throw runtime.MakeError(U"Too few arguments.");
+    }
+
+    return EvaluateExpression(
+      runtime,
+      runtime.root_scope(),
+      parameter.default_value
+    );
+  }
+
+  void
+  ThrowArgumentError(
+    Runtime& runtime,
+    const interpreter::Parameter& parameter,
+    const value::ptr& argument
+  )
+  {
+    throw runtime.MakeError(
+      value::ToString(argument) +
+      U" cannot be assigned to " +
+      parameter.ToString()
+    );
+  }
+}
@@ -24,6 +24,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "snek/interpreter/parameter.hpp"
+#include "snek/interpreter/runtime.hpp"
 #include "snek/interpreter/type.hpp"
 
 namespace snek::interpreter
@@ -31,6 +32,10 @@ namespace snek::interpreter
   bool
   Parameter::Accepts(const Runtime& runtime, const value::ptr& value) const
   {
+#if defined(SNEK_ENABLE_STATISTICS)
+    ++runtime.statistics().parameter_checks;
+#endif
+
     return type ? type->Accepts(runtime, value) : true;
   }
 
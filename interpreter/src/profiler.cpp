@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <vector>
+
+#if !defined(_WIN32)
+#  include <csignal>
+#  include <sys/time.h>
+#endif
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/interpreter/profiler.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+namespace snek::interpreter
+{
+  namespace
+  {
+    /**
+     * std::stack does not allow iterating over it's elements, but the
+     * underlying container is accessible to derived classes.
+     */
+    struct CallStackAccess : Runtime::call_stack_type
+    {
+      static const container_type&
+      Frames(const Runtime::call_stack_type& stack)
+      {
+        return stack.*&CallStackAccess::c;
+      }
+    };
+  }
+
+  static std::atomic<Profiler*> active_profiler(nullptr);
+
+  static std::string
+  GetFrameName(const Frame& frame)
+  {
+    auto name = peelo::unicode::encoding::utf8::encode(frame.ToString());
+
+    // Semicolons separate frames and newlines separate call stacks in the
+    // collapsed stack format.
+    std::replace(std::begin(name), std::end(name), ';', ',');
+    std::replace(std::begin(name), std::end(name), '\n', ' ');
+
+    return name;
+  }
+
+  Profiler::Profiler()
+    : m_runtime(nullptr)
+    , m_sample_pending(false)
+    , m_sampling(false)
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0) {}
+
+  Profiler::~Profiler()
+  {
+    Stop();
+  }
+
+  void
+  Profiler::HandleSignal(int)
+  {
+    if (const auto profiler = active_profiler.load(std::memory_order_relaxed))
+    {
+      profiler->m_sample_pending.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  bool
+  Profiler::Start(Runtime& runtime, const interval_type& interval)
+  {
+#if defined(SNEK_ENABLE_PROFILER) && !defined(_WIN32)
+    static std::once_flag handler_installed;
+    Profiler* expected = nullptr;
+    struct itimerval timer = {};
+
+    if (running() || interval.count() <= 0)
+    {
+      return false;
+    }
+    else if (!active_profiler.compare_exchange_strong(expected, this))
+    {
+      return false;
+    }
+    if (!m_buffer)
+    {
+      m_buffer = std::make_unique<Sample[]>(kBufferSize);
+    }
+    m_runtime = &runtime;
+    runtime.set_profiler(this);
+
+    // The handler is left installed after the profiling has been stopped,
+    // so that a signal still pending at that point does not terminate the
+    // process. It does nothing when no profiler is active.
+    std::call_once(handler_installed, []()
+    {
+      struct sigaction action = {};
+
+      action.sa_handler = HandleSignal;
+      action.sa_flags = SA_RESTART;
+      sigemptyset(&action.sa_mask);
+      sigaction(SIGPROF, &action, nullptr);
+    });
+
+    timer.it_interval.tv_sec = static_cast<time_t>(interval.count() / 1000000);
+    timer.it_interval.tv_usec = static_cast<suseconds_t>(
+      interval.count() % 1000000
+    );
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr))
+    {
+      runtime.set_profiler(nullptr);
+      m_runtime = nullptr;
+      active_profiler.store(nullptr);
+
+      return false;
+    }
+
+    return true;
+#else
+    static_cast<void>(runtime);
+    static_cast<void>(interval);
+
+    return false;
+#endif
+  }
+
+  void
+  Profiler::Stop()
+  {
+    if (!running())
+    {
+      return;
+    }
+#if !defined(_WIN32)
+    struct itimerval timer = {};
+
+    setitimer(ITIMER_PROF, &timer, nullptr);
+#endif
+    active_profiler.store(nullptr);
+    m_runtime->set_profiler(nullptr);
+    m_runtime = nullptr;
+    m_sample_pending.store(false, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_drain_mutex);
+
+    Drain();
+  }
+
+  Profiler::count_container_type
+  Profiler::counts()
+  {
+    std::lock_guard<std::mutex> lock(m_drain_mutex);
+
+    Drain();
+
+    return m_counts;
+  }
+
+  void
+  Profiler::WriteFolded(std::ostream& output)
+  {
+    std::lock_guard<std::mutex> lock(m_drain_mutex);
+    std::vector<count_container_type::const_pointer> entries;
+
+    Drain();
+    entries.reserve(m_counts.size());
+    for (const auto& entry : m_counts)
+    {
+      entries.push_back(&entry);
+    }
+    std::sort(
+      std::begin(entries),
+      std::end(entries),
+      [](const auto a, const auto b)
+      {
+        return a->first < b->first;
+      }
+    );
+    for (const auto entry : entries)
+    {
+      output << entry->first << ' ' << entry->second << '\n';
+    }
+  }
+
+  void
+  Profiler::Clear()
+  {
+    std::lock_guard<std::mutex> lock(m_drain_mutex);
+
+    Drain();
+    m_counts.clear();
+    m_dropped.store(0, std::memory_order_relaxed);
+  }
+
+  void
+  Profiler::TakeSample(const Runtime& runtime)
+  {
+    const auto& frames = CallStackAccess::Frames(runtime.call_stack());
+    const auto size = frames.size();
+    const auto start = size > kMaxDepth ? size - kMaxDepth : 0;
+
+    // Only one thread at a time can write into the buffer.
+    if (m_sampling.exchange(true, std::memory_order_acquire))
+    {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    const auto head = m_head.load(std::memory_order_relaxed);
+
+    if (head - m_tail.load(std::memory_order_acquire) >= kBufferSize)
+    {
+      // Aggregate the buffered samples to make room, unless some other
+      // thread is already doing that.
+      std::unique_lock<std::mutex> lock(m_drain_mutex, std::try_to_lock);
+
+      if (!lock.owns_lock())
+      {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_sampling.store(false, std::memory_order_release);
+        return;
+      }
+      Drain();
+    }
+
+    auto& sample = m_buffer[head % kBufferSize];
+
+    sample.depth = size - start;
+    sample.truncated = start > 0;
+    for (std::size_t i = start; i < size; ++i)
+    {
+      auto& frame = sample.frames[i - start];
+
+      frame.position = frames[i].position;
+      frame.function = frames[i].function;
+    }
+    m_head.store(head + 1, std::memory_order_release);
+    m_sampling.store(false, std::memory_order_release);
+  }
+
+  void
+  Profiler::Drain()
+  {
+    const auto head = m_head.load(std::memory_order_acquire);
+    auto tail = m_tail.load(std::memory_order_relaxed);
+
+    for (; tail != head; ++tail)
+    {
+      auto& sample = m_buffer[tail % kBufferSize];
+      std::string stack;
+
+      if (sample.truncated)
+      {
+        stack.append("[truncated]");
+      }
+      for (std::size_t i = 0; i < sample.depth; ++i)
+      {
+        auto& frame = sample.frames[i];
+
+        if (!stack.empty())
+        {
+          stack.append(1, ';');
+        }
+        stack.append(GetFrameName(frame));
+        // Release the references so that the buffer does not keep values
+        // alive.
+        frame.position.reset();
+        frame.function.reset();
+      }
+      ++m_counts[stack];
+    }
+    m_tail.store(tail, std::memory_order_release);
+  }
+}
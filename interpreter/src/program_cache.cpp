@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/interpreter/program_cache.hpp"
+
+namespace snek::interpreter
+{
+  ProgramCache::ProgramCache(std::size_t capacity)
+    : m_capacity(capacity)
+    , m_hits(0)
+    , m_misses(0) {}
+
+  Program::ptr
+  ProgramCache::Find(const std::u32string& source)
+  {
+    const auto index = m_index.find(source);
+
+    if (index == std::end(m_index))
+    {
+      ++m_misses;
+
+      return nullptr;
+    }
+    ++m_hits;
+    m_entries.splice(std::begin(m_entries), m_entries, index->second);
+
+    return index->second->program;
+  }
+
+  void
+  ProgramCache::Insert(
+    const std::u32string& source,
+    const Program::ptr& program
+  )
+  {
+    if (!m_capacity || source.length() > kMaxSourceLength)
+    {
+      return;
+    }
+
+    const auto index = m_index.find(source);
+
+    if (index != std::end(m_index))
+    {
+      index->second->program = program;
+      m_entries.splice(std::begin(m_entries), m_entries, index->second);
+
+      return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+      m_index.erase(m_entries.back().source);
+      m_entries.pop_back();
+    }
+    m_entries.push_front({ source, program });
+    m_index[m_entries.front().source] = std::begin(m_entries);
+  }
+
+  void
+  ProgramCache::Clear()
+  {
+    m_index.clear();
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdint>
+
+#include "snek/interpreter/property_cache.hpp"
+
+namespace snek::interpreter
+{
+  PropertyCache::PropertyCache()
+    : m_size(0) {}
+
+  std::size_t
+  PropertyCache::IndexOf(
+    const value::ptr& prototype,
+    const std::u32string& name
+  ) const
+  {
+    const auto address = reinterpret_cast<std::uintptr_t>(prototype.get());
+    const auto hash = std::hash<std::u32string>()(name);
+
+    return (hash ^ (address >> 4) * 0x9e3779b97f4a7c15ULL) % kSize;
+  }
+
+  std::optional<value::ptr>
+  PropertyCache::Find(
+    const value::ptr& prototype,
+    const std::u32string& name
+  ) const
+  {
+    if (m_size > 0)
+    {
+      const auto& entry = m_entries[IndexOf(prototype, name)];
+
+      if (entry.prototype == prototype && entry.name == name)
+      {
+        return entry.property;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  void
+  PropertyCache::Insert(
+    const value::ptr& prototype,
+    const std::u32string& name,
+    const value::ptr& holder,
+    const value::ptr& property
+  )
+  {
+    if (!prototype)
+    {
+      return;
+    }
+    if (m_entries.empty())
+    {
+      m_entries.resize(kSize);
+    }
+
+    auto& entry = m_entries[IndexOf(prototype, name)];
+
+    if (!entry.prototype)
+    {
+      ++m_size;
+    }
+    entry.prototype = prototype;
+    entry.name = name;
+    entry.holder = holder;
+    entry.property = property;
+  }
+
+  void
+  PropertyCache::Invalidate(const value::ptr& prototype)
+  {
+    if (!prototype || m_size == 0)
+    {
+      return;
+    }
+    for (auto& entry : m_entries)
+    {
+      if (
+        entry.prototype &&
+        (entry.prototype == prototype || entry.holder == prototype)
+      )
+      {
+        entry = Entry();
+        --m_size;
+      }
+    }
+  }
+
+  void
+  PropertyCache::Clear()
+  {
+    m_entries.clear();
+    m_size = 0;
+  }
+}
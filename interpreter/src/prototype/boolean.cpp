@@ -37,19 +37,16 @@ namespace snek::interpreter::prototype
   static value::ptr
   Random(Runtime& runtime, const std::vector<value::ptr>& arguments)
   {
-    thread_local static std::random_device device;
-    thread_local static std::mt19937 generator(device());
-
     std::bernoulli_distribution d(
       static_cast<const value::Float*>(arguments[0].get())->value
     );
 
-    return runtime.MakeBoolean(d(generator));
+    return runtime.MakeBoolean(d(runtime.random_generator()));
   }
 
   void
   MakeBoolean(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
@@ -57,11 +54,11 @@ namespace snek::interpreter::prototype
       {
         {
           U"distribution",
-          runtime->float_type(),
+          builtins->float_type(),
           std::make_shared<parser::expression::Float>(std::nullopt, 0.5)
         }
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       Random
     );
   }
@@ -70,11 +70,8 @@ namespace snek::interpreter::prototype
    * maximum values can be given.
    */
   static value::ptr
-  Random(Runtime&, const std::vector<value::ptr>& arguments)
+  Random(Runtime& runtime, const std::vector<value::ptr>& arguments)
   {
-    thread_local static std::random_device device;
-    thread_local static std::mt19937 generator(device());
-
     const auto min =
       value::IsNull(arguments[0])
         ? DBL_MIN
@@ -85,23 +82,23 @@ namespace snek::interpreter::prototype
         : AsFloat(arguments[1]);
     std::uniform_real_distribution<double> d(min ,max);
 
-    return std::make_shared<value::Float>(d(generator));
+    return std::make_shared<value::Float>(d(runtime.random_generator()));
   }
 
   void
   MakeFloat(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
-    const auto optional_float = type::MakeOptional(runtime->float_type());
+    const auto optional_float = type::MakeOptional(builtins->float_type());
     const auto null_expression = std::make_shared<parser::expression::Null>(
       std::nullopt
     );
 
     fields[U"parse"] = value::Function::MakeNative(
-      { { U"input", runtime->string_type() } },
-      runtime->float_type(),
+      { { U"input", builtins->string_type() } },
+      builtins->float_type(),
       Parse
     );
     fields[U"random"] = value::Function::MakeNative(
@@ -109,7 +106,7 @@ namespace snek::interpreter::prototype
         { U"min", optional_float, null_expression },
         { U"max", optional_float, null_expression },
       },
-      runtime->float_type(),
+      builtins->float_type(),
       Random
     );
   }
@@ -44,16 +44,16 @@ namespace snek::interpreter::prototype
 
   void
   MakeFunction(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
     fields[U"call"] = value::Function::MakeNative(
       {
-        { U"function", runtime->function_type() },
-        { U"arguments", runtime->list_type(), nullptr, true },
+        { U"function", builtins->function_type() },
+        { U"arguments", builtins->list_type(), nullptr, true },
       },
-      runtime->any_type(),
+      builtins->any_type(),
       Call
     );
   }
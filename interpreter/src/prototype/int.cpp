@@ -31,37 +31,35 @@
 #include <peelo/unicode/encoding/utf8.hpp>
 
 #include "snek/interpreter/error.hpp"
+#include "snek/interpreter/native.hpp"
 #include "snek/interpreter/runtime.hpp"
 
 namespace snek::interpreter::prototype
 {
-  static inline std::int64_t
-  AsInt(const value::ptr& value)
-  {
-    return static_cast<const value::Int*>(value.get())->value;
-  }
-
   /**
    * Int#parse(input: String, base: Int = 10) => Int
    *
    * Parses given string as integer and returns result.
    */
-  static value::ptr
-  Parse(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  static std::int64_t
+  Parse(Runtime& runtime, const std::u32string& input, std::int64_t base)
   {
     using peelo::unicode::encoding::utf8::encode;
 
-    const auto input = encode(ToString(arguments[0]));
-    const auto base = static_cast<int>(AsInt(arguments[1]));
+    const auto encoded_input = encode(input);
     // TODO: Implement Unicode version of std::strtoll.
-    const auto result = std::strtoll(input.c_str(), nullptr, base);
+    const auto result = std::strtoll(
+      encoded_input.c_str(),
+      nullptr,
+      static_cast<int>(base)
+    );
 
     if (errno == ERANGE)
     {
       throw runtime.MakeError(U"Integer out of range.");
     }
 
-    return runtime.MakeInt(result);
+    return result;
   }
 
   /**
@@ -70,55 +68,47 @@ namespace snek::interpreter::prototype
    * Generates random integer number. Optional minimum and maximum values can
    * be given.
    */
-  static value::ptr
-  Random(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  static std::int64_t
+  Random(
+    Runtime& runtime,
+    std::optional<std::int64_t> min,
+    std::optional<std::int64_t> max
+  )
   {
-    thread_local static std::random_device device;
-    thread_local static std::mt19937 generator(device());
-
-    const auto min =
-      value::IsNull(arguments[0])
-        ? INT64_MIN
-        : AsInt(arguments[0]);
-    const auto max =
-      value::IsNull(arguments[1])
-        ? INT64_MAX
-        : AsInt(arguments[1]);
-    std::uniform_int_distribution<std::int64_t> d(min ,max);
+    std::uniform_int_distribution<std::int64_t> d(
+      min.value_or(INT64_MIN),
+      max.value_or(INT64_MAX)
+    );
 
-    return runtime.MakeInt(d(generator));
+    return d(runtime.random_generator());
   }
 
   void
   MakeInt(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
-    const auto optional_int = type::MakeOptional(runtime->int_type());
     const auto null_expression = std::make_shared<parser::expression::Null>(
       std::nullopt
     );
 
-    fields[U"parse"] = value::Function::MakeNative(
+    fields[U"parse"] = native::Bind<Parse>(
+      builtins,
       {
-        { U"input", runtime->string_type() },
+        { U"input" },
         {
           U"base",
-          runtime->int_type(),
           std::make_shared<parser::expression::Int>(std::nullopt, 10)
         },
-      },
-      runtime->int_type(),
-      Parse
+      }
     );
-    fields[U"random"] = value::Function::MakeNative(
+    fields[U"random"] = native::Bind<Random>(
+      builtins,
       {
-        { U"min", optional_int, null_expression },
-        { U"max", optional_int, null_expression },
-      },
-      runtime->int_type(),
-      Random
+        { U"min", null_expression },
+        { U"max", null_expression },
+      }
     );
   }
 }
@@ -23,8 +23,17 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
 #include "snek/interpreter/error.hpp"
 #include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/sequence.hpp"
+#include "snek/interpreter/sort.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
 
 namespace snek::interpreter::prototype
 {
@@ -324,6 +333,345 @@ namespace snek::interpreter::prototype
     return result;
   }
 
+  /**
+   * Lists shorter than this are processed sequentially by the parallel list
+   * methods, as splitting them between threads would cost more than it
+   * saves.
+   */
+  static constexpr std::size_t kParallelThreshold = 2048;
+  static constexpr std::size_t kParallelGrainSize = 256;
+
+  static inline bool
+  ShouldRunInParallel(Runtime& runtime, std::size_t size)
+  {
+    return size >= kParallelThreshold && runtime.worker_pool().size() > 0;
+  }
+
+  static inline std::size_t
+  GetGrainSize(Runtime& runtime, std::size_t size)
+  {
+    // Aim for several chunks per thread, so that there is something left to
+    // steal for threads which finish early.
+    const auto chunk_count = (runtime.worker_pool().size() + 1) * 8;
+
+    return std::max(kParallelGrainSize, size / chunk_count);
+  }
+
+  /**
+   * Creates runtime context in which a worker thread calls callbacks of an
+   * parallel operation started by given runtime. The context gets the budget
+   * the runtime had when the operation started, and interrupting the runtime
+   * interrupts the context as well.
+   */
+  static std::unique_ptr<Runtime>
+  MakeWorkerContext(const Runtime& runtime, const Runtime::Budget& budget)
+  {
+    auto context = std::make_unique<Runtime>(runtime.module_importer());
+
+    context->set_profiler(runtime.profiler());
+    context->set_budget(budget);
+    context->ForwardInterrupts(runtime);
+
+    return context;
+  }
+
+  /**
+   * Splits range [0, size) into chunks of given size and calls given
+   * callback for each one of them in the worker pool of the runtime. Runtime
+   * cannot be used from multiple threads at once, so each worker thread is
+   * given a runtime context of it's own, in which the callback is called.
+   *
+   * Scopes captured by the callback are shared between the threads, so the
+   * callback is run in an parallel section in which variables declared
+   * outside of it cannot be assigned.
+   */
+  template<class Callback>
+  static void
+  ParallelFor(
+    Runtime& runtime,
+    std::size_t size,
+    std::size_t grain_size,
+    Callback callback
+  )
+  {
+    auto& pool = runtime.worker_pool();
+    // Suspending a task in the middle of a parallel operation would leave
+    // the worker threads waiting for it, so tasks run parallel operations to
+    // completion.
+    struct DetachedTask
+    {
+      Runtime& runtime;
+      Task* task;
+
+      ~DetachedTask()
+      {
+        runtime.set_task(task);
+      }
+    } detached = { runtime, runtime.task() };
+    // Each worker context may consume all of the fuel the runtime had left
+    // when the operation started. Fuel consumed by them is charged from the
+    // runtime once the operation is over, so that a budget cannot be evaded
+    // by running the work in parallel. Execution counters of the worker
+    // contexts are added to the runtime as well.
+    struct WorkerContexts
+    {
+      Runtime& runtime;
+      const Runtime::Budget budget;
+      std::vector<std::unique_ptr<Runtime>> contexts;
+
+      ~WorkerContexts()
+      {
+        auto remaining = runtime.budget();
+        std::uint64_t consumed = 0;
+
+        for (const auto& context : contexts)
+        {
+          if (!context)
+          {
+            continue;
+          }
+#if defined(SNEK_ENABLE_STATISTICS)
+          runtime.statistics().Merge(context->statistics());
+#endif
+          if (budget.fuel)
+          {
+            consumed += *budget.fuel - context->budget().fuel.value_or(0);
+          }
+        }
+        if (remaining.fuel && consumed > 0)
+        {
+          *remaining.fuel -= std::min(*remaining.fuel, consumed);
+          runtime.set_budget(remaining);
+        }
+      }
+    } workers = {
+      runtime,
+      runtime.budget(),
+      std::vector<std::unique_ptr<Runtime>>(pool.size())
+    };
+
+    runtime.set_task(nullptr);
+    try
+    {
+      pool.Run(
+        size,
+        grain_size,
+        [&](std::size_t worker, std::size_t begin, std::size_t end)
+        {
+          Scope::ParallelSection section;
+          auto& contexts = workers.contexts;
+
+          if (worker >= contexts.size())
+          {
+            callback(runtime, begin, end);
+            return;
+          }
+          if (!contexts[worker])
+          {
+            contexts[worker] = MakeWorkerContext(runtime, workers.budget);
+          }
+          callback(*contexts[worker], begin, end);
+        },
+        &runtime.interrupt_flag()
+      );
+    }
+    catch (const WorkStealingPool::Cancelled&)
+    {
+      // Chunks were skipped once the runtime had been interrupted, so the
+      // results are incomplete even if a callback has already consumed the
+      // interrupt.
+      runtime.interrupt_flag().store(false, std::memory_order_relaxed);
+
+      throw runtime.MakeError(U"Execution has been interrupted.");
+    }
+
+    // The interrupt may still be pending if it arrived after the last chunk
+    // had been taken and none of the callbacks reached a checkpoint after
+    // it.
+    if (runtime.interrupt_flag().load(std::memory_order_relaxed))
+    {
+      runtime.Checkpoint();
+    }
+  }
+
+  /**
+   * List#parallelFilter(this: List, callback: Function) => List
+   *
+   * Like List#filter, but splits the list between multiple threads. The
+   * callback function cannot assign variables declared outside of
+   * itself.
+   */
+  static value::ptr
+  ParallelFilter(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto list = As<value::List>(arguments[0]);
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+    const auto size = list->GetSize();
+    std::vector<char> matches;
+    std::vector<value::ptr> result;
+
+    if (!ShouldRunInParallel(runtime, size))
+    {
+      return Filter(runtime, arguments);
+    }
+    matches.resize(size);
+    ParallelFor(
+      runtime,
+      size,
+      GetGrainSize(runtime, size),
+      [&](Runtime& context, std::size_t begin, std::size_t end)
+      {
+        for (auto i = begin; i < end; ++i)
+        {
+          matches[i] = value::ToBoolean(
+            value::Function::Call(
+              context,
+              callback,
+              {
+                list->At(i),
+                context.MakeInt(static_cast<std::int64_t>(i)),
+              }
+            )
+          );
+        }
+      }
+    );
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      if (matches[i])
+      {
+        result.push_back(list->At(i));
+      }
+    }
+
+    return value::List::Make(result);
+  }
+
+  /**
+   * List#parallelMap(this: List, callback: Function) => List
+   *
+   * Like List#map, but splits the list between multiple threads. The
+   * callback function cannot assign variables declared outside of
+   * itself.
+   */
+  static value::ptr
+  ParallelMap(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto list = As<value::List>(arguments[0]);
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+    const auto size = list->GetSize();
+    std::vector<value::ptr> result;
+
+    if (!ShouldRunInParallel(runtime, size))
+    {
+      return Map(runtime, arguments);
+    }
+    result.resize(size);
+    ParallelFor(
+      runtime,
+      size,
+      GetGrainSize(runtime, size),
+      [&](Runtime& context, std::size_t begin, std::size_t end)
+      {
+        for (auto i = begin; i < end; ++i)
+        {
+          result[i] = value::Function::Call(
+            context,
+            callback,
+            {
+              list->At(i),
+              context.MakeInt(static_cast<std::int64_t>(i)),
+            }
+          );
+        }
+      }
+    );
+
+    return value::List::Make(result);
+  }
+
+  /**
+   * List#parallelReduce(
+   *   this: List,
+   *   callback: Function,
+   *   initial: any = null
+   * ) => any
+   *
+   * Like List#reduce, but splits the list between multiple threads, reduces
+   * each part separately and then combines the partial results in order
+   * with the same callback function. The callback function must therefore
+   * be associative, and it cannot assign variables declared outside of
+   * itself.
+   */
+  static value::ptr
+  ParallelReduce(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto list = As<value::List>(arguments[0]);
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+    const auto size = list->GetSize();
+    std::size_t grain_size;
+    std::vector<value::ptr> partial_results;
+    value::ptr result;
+
+    if (!ShouldRunInParallel(runtime, size))
+    {
+      return Reduce(runtime, arguments);
+    }
+    grain_size = GetGrainSize(runtime, size);
+    partial_results.resize((size + grain_size - 1) / grain_size);
+    ParallelFor(
+      runtime,
+      size,
+      grain_size,
+      [&](Runtime& context, std::size_t begin, std::size_t end)
+      {
+        auto& partial_result = partial_results[begin / grain_size];
+        auto i = begin;
+
+        // Initial value is only used once, by the first part of the list.
+        if (begin == 0 && !value::IsNull(arguments[2]))
+        {
+          partial_result = arguments[2];
+        } else {
+          partial_result = list->At(i++);
+        }
+        for (; i < end; ++i)
+        {
+          partial_result = value::Function::Call(
+            context,
+            callback,
+            {
+              partial_result,
+              list->At(i),
+              context.MakeInt(static_cast<std::int64_t>(i)),
+            }
+          );
+        }
+      }
+    );
+    result = partial_results[0];
+    for (std::size_t i = 1; i < partial_results.size(); ++i)
+    {
+      result = value::Function::Call(
+        runtime,
+        callback,
+        {
+          result,
+          partial_results[i],
+          runtime.MakeInt(static_cast<std::int64_t>(i * grain_size)),
+        }
+      );
+    }
+
+    return result;
+  }
+
   namespace
   {
     class ReverseList final : public value::List
@@ -371,6 +719,581 @@ namespace snek::interpreter::prototype
     return runtime.MakeInt(As<value::List>(arguments[0])->GetSize());
   }
 
+  /**
+   * Returns kind shared by all of the given values, or null if the values are
+   * of different kinds.
+   */
+  static std::optional<value::Kind>
+  GetCommonKind(const std::vector<value::ptr>& values)
+  {
+    std::optional<value::Kind> kind;
+
+    for (const auto& value : values)
+    {
+      const auto value_kind = value::KindOf(value);
+
+      if (!kind)
+      {
+        kind = value_kind;
+      }
+      else if (*kind != value_kind)
+      {
+        return std::nullopt;
+      }
+    }
+
+    return kind;
+  }
+
+  /**
+   * Sorts elements by given keys, which have already been converted into
+   * native type that can be compared without calling any methods.
+   */
+  template<class Key, class Converter>
+  static std::vector<value::ptr>
+  SortByNativeKeys(
+    const std::vector<value::ptr>& keys,
+    const std::vector<value::ptr>& elements,
+    Converter converter
+  )
+  {
+    const auto size = elements.size();
+    std::vector<std::pair<Key, std::size_t>> entries;
+    std::vector<value::ptr> result;
+
+    entries.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      entries.emplace_back(converter(keys[i]), i);
+    }
+    StableSort(
+      entries,
+      [](const auto& a, const auto& b) { return a.first < b.first; }
+    );
+    result.reserve(size);
+    for (const auto& entry : entries)
+    {
+      result.push_back(elements[entry.second]);
+    }
+
+    return result;
+  }
+
+  /**
+   * Sorts elements by given keys into ascending order. Lists of only ints,
+   * only floats or only strings are compared directly; anything else is
+   * compared with the `<` method of the keys.
+   */
+  static std::vector<value::ptr>
+  SortByKeys(
+    Runtime& runtime,
+    const std::vector<value::ptr>& keys,
+    const std::vector<value::ptr>& elements
+  )
+  {
+    const auto kind = GetCommonKind(keys);
+    std::vector<std::pair<value::ptr, std::size_t>> entries;
+    std::vector<value::ptr> result;
+
+    if (kind == value::Kind::Int)
+    {
+      return SortByNativeKeys<value::Int::value_type>(
+        keys,
+        elements,
+        [](const value::ptr& key) { return As<value::Int>(key)->value; }
+      );
+    }
+    else if (kind == value::Kind::Float)
+    {
+      return SortByNativeKeys<value::Float::value_type>(
+        keys,
+        elements,
+        [](const value::ptr& key) { return As<value::Float>(key)->value; }
+      );
+    }
+    else if (kind == value::Kind::String)
+    {
+      return SortByNativeKeys<std::u32string>(
+        keys,
+        elements,
+        [](const value::ptr& key) { return value::ToString(key); }
+      );
+    }
+    entries.reserve(elements.size());
+    for (std::size_t i = 0; i < elements.size(); ++i)
+    {
+      entries.emplace_back(keys[i], i);
+    }
+    StableSort(
+      entries,
+      [&runtime](const auto& a, const auto& b)
+      {
+        static const std::u32string method_name = U"<";
+
+        return value::ToBoolean(
+          value::CallMethod(runtime, a.first, method_name, { b.first })
+        );
+      }
+    );
+    result.reserve(elements.size());
+    for (const auto& entry : entries)
+    {
+      result.push_back(elements[entry.second]);
+    }
+
+    return result;
+  }
+
+  /**
+   * List#sort(this: List, comparator: Function | null = null) => List
+   *
+   * Returns sorted copy of the list. The sort is stable. If comparator
+   * function is given, it's called with two elements and it should return
+   * negative number if the first one should be sorted before the second
+   * one, positive number if the second one should be sorted before the
+   * first one and zero if their order does not matter. Without a comparator
+   * function the elements are sorted into ascending order.
+   */
+  static value::ptr
+  Sort(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto list = As<value::List>(arguments[0]);
+    std::vector<value::ptr> elements;
+
+    if (value::IsNull(arguments[1]))
+    {
+      const auto unboxed_kind = list->GetUnboxedKind();
+
+      if (unboxed_kind == value::Kind::Int)
+      {
+        auto ints = static_cast<const value::IntList*>(list)->elements();
+
+        StableSort(ints, std::less<value::IntList::element_type>());
+
+        return value::IntList::Make(std::move(ints));
+      }
+      else if (unboxed_kind == value::Kind::Float)
+      {
+        auto floats = static_cast<const value::FloatList*>(list)->elements();
+
+        StableSort(floats, std::less<value::FloatList::element_type>());
+
+        return value::FloatList::Make(std::move(floats));
+      }
+      elements = list->ToVector();
+
+      return value::List::Make(SortByKeys(runtime, elements, elements));
+    }
+    elements = list->ToVector();
+
+    const auto comparator = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+
+    StableSort(
+      elements,
+      [&runtime, &comparator](const value::ptr& a, const value::ptr& b)
+      {
+        const auto result = value::Function::Call(
+          runtime,
+          comparator,
+          { a, b }
+        );
+
+        if (!value::IsNumber(result))
+        {
+          throw runtime.MakeError(
+            U"Comparator function must return a number."
+          );
+        }
+
+        return As<value::Number>(result)->ToFloat() < 0;
+      }
+    );
+
+    return value::List::Make(elements);
+  }
+
+  /**
+   * List#sortBy(this: List, callback: Function) => List
+   *
+   * Returns copy of the list sorted into ascending order by keys returned
+   * by given callback function for each element. The callback function is
+   * called only once for each element. The sort is stable.
+   */
+  static value::ptr
+  SortBy(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto elements = As<value::List>(arguments[0])->ToVector();
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+    std::vector<value::ptr> keys;
+
+    keys.reserve(elements.size());
+    for (const auto& element : elements)
+    {
+      keys.push_back(value::Function::Call(runtime, callback, { element }));
+    }
+
+    return value::List::Make(SortByKeys(runtime, keys, elements));
+  }
+
+  /**
+   * Returns given list as a list which stores it's elements unboxed. Lists
+   * of only ints, including ranges, are converted into IntList and other
+   * lists of numbers into FloatList. If the list contains something else
+   * than numbers, an exception is thrown.
+   */
+  static std::shared_ptr<value::List>
+  ToNumericList(Runtime& runtime, const value::ptr& value)
+  {
+    const auto list = std::static_pointer_cast<value::List>(value);
+    const auto size = list->GetSize();
+    bool all_ints = true;
+    std::vector<value::ptr> elements;
+    value::IntList::container_type unboxed;
+
+    if (list->GetUnboxedKind())
+    {
+      return list;
+    }
+    else if (list->UnboxInts(unboxed))
+    {
+      return value::IntList::Make(std::move(unboxed));
+    }
+    elements.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      auto element = list->At(i);
+
+      if (!value::IsNumber(element))
+      {
+        throw runtime.MakeError(U"List contains non-numeric values.");
+      }
+      else if (!value::IsInt(element))
+      {
+        all_ints = false;
+      }
+      elements.push_back(std::move(element));
+    }
+    if (all_ints)
+    {
+      value::IntList::container_type ints;
+
+      ints.reserve(size);
+      for (const auto& element : elements)
+      {
+        ints.push_back(As<value::Int>(element)->value);
+      }
+
+      return value::IntList::Make(std::move(ints));
+    } else {
+      value::FloatList::container_type floats;
+
+      floats.reserve(size);
+      for (const auto& element : elements)
+      {
+        floats.push_back(As<value::Number>(element)->ToFloat());
+      }
+
+      return value::FloatList::Make(std::move(floats));
+    }
+  }
+
+  static inline const value::IntList::container_type&
+  IntsOf(const std::shared_ptr<value::List>& list)
+  {
+    return static_cast<const value::IntList*>(list.get())->elements();
+  }
+
+  /**
+   * Returns elements of numeric list as floats. If the list stores ints,
+   * they are converted into floats in given storage.
+   */
+  static const value::FloatList::container_type&
+  FloatsOf(
+    const std::shared_ptr<value::List>& list,
+    value::FloatList::container_type& storage
+  )
+  {
+    if (list->GetUnboxedKind() == value::Kind::Int)
+    {
+      const auto& ints = IntsOf(list);
+
+      storage.assign(std::begin(ints), std::end(ints));
+
+      return storage;
+    }
+
+    return static_cast<const value::FloatList*>(list.get())->elements();
+  }
+
+  /**
+   * Computes sum of given floats. Multiple accumulators are used, so that
+   * consecutive additions do not have to wait for each other.
+   */
+  template<class Product>
+  static double
+  SumFloats(std::size_t size, Product product)
+  {
+    double sums[4] = { 0, 0, 0, 0 };
+    std::size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+      sums[0] += product(i);
+      sums[1] += product(i + 1);
+      sums[2] += product(i + 2);
+      sums[3] += product(i + 3);
+    }
+    for (; i < size; ++i)
+    {
+      sums[0] += product(i);
+    }
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+  }
+
+  /**
+   * Computes sum of products of given pairs of integers, with the same
+   * results as reducing the list with Number#+ would give. Like with the
+   * operators, the sum becomes a float once the result of an addition does
+   * not fit into an int, and otherwise wraps around in integer precision.
+   * Product callback stores the product into either it's second or third
+   * argument, returning true if the product is an int.
+   */
+  template<class Product>
+  static value::ptr
+  SumInts(Runtime& runtime, std::size_t size, Product product)
+  {
+    std::int64_t sum = 0;
+    double float_sum = 0;
+    bool is_float = false;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      std::int64_t int_term = 0;
+      double float_term = 0;
+
+      if (!product(i, int_term, float_term))
+      {
+        if (!is_float)
+        {
+          float_sum = static_cast<double>(sum);
+          is_float = true;
+        }
+        float_sum += float_term;
+      }
+      else if (is_float)
+      {
+        float_sum += static_cast<double>(int_term);
+      } else {
+        const auto result = static_cast<double>(sum) +
+          static_cast<double>(int_term);
+
+        if (std::fabs(result) <= static_cast<double>(INT64_MAX))
+        {
+          sum = static_cast<std::int64_t>(
+            static_cast<std::uint64_t>(sum) +
+            static_cast<std::uint64_t>(int_term)
+          );
+        } else {
+          float_sum = result;
+          is_float = true;
+        }
+      }
+    }
+    if (is_float)
+    {
+      return std::make_shared<value::Float>(float_sum);
+    }
+
+    return runtime.MakeInt(sum);
+  }
+
+  template<class Container, class Compare>
+  static std::optional<typename Container::value_type>
+  FindExtreme(const Container& elements, Compare compare)
+  {
+    if (elements.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto result = elements[0];
+
+    for (const auto element : elements)
+    {
+      result = compare(element, result) ? element : result;
+    }
+
+    return result;
+  }
+
+  template<class Compare>
+  static value::ptr
+  DoExtreme(Runtime& runtime, const value::ptr& value, Compare compare)
+  {
+    const auto list = ToNumericList(runtime, value);
+
+    if (list->GetUnboxedKind() == value::Kind::Int)
+    {
+      const auto result = FindExtreme(IntsOf(list), compare);
+
+      return result ? runtime.MakeInt(*result) : nullptr;
+    } else {
+      value::FloatList::container_type storage;
+      const auto result = FindExtreme(FloatsOf(list, storage), compare);
+
+      return result ? std::make_shared<value::Float>(*result) : nullptr;
+    }
+  }
+
+  /**
+   * List#sum(this: List) => Number
+   *
+   * Returns sum of numbers in the list. Sum of ints follows the rules of
+   * Number#+, so it's the same as reducing the list with the operator.
+   */
+  static value::ptr
+  Sum(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto list = ToNumericList(runtime, arguments[0]);
+
+    if (list->GetUnboxedKind() == value::Kind::Int)
+    {
+      const auto& ints = IntsOf(list);
+
+      return SumInts(
+        runtime,
+        ints.size(),
+        [&ints](std::size_t i, std::int64_t& result, double&)
+        {
+          result = ints[i];
+
+          return true;
+        }
+      );
+    }
+
+    value::FloatList::container_type storage;
+    const auto& floats = FloatsOf(list, storage);
+
+    return std::make_shared<value::Float>(
+      SumFloats(floats.size(), [&floats](std::size_t i) { return floats[i]; })
+    );
+  }
+
+  /**
+   * List#min(this: List) => Number | null
+   *
+   * Returns smallest number in the list, or null if the list is empty.
+   */
+  static value::ptr
+  Min(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    return DoExtreme(
+      runtime,
+      arguments[0],
+      [](auto a, auto b) { return a < b; }
+    );
+  }
+
+  /**
+   * List#max(this: List) => Number | null
+   *
+   * Returns largest number in the list, or null if the list is empty.
+   */
+  static value::ptr
+  Max(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    return DoExtreme(
+      runtime,
+      arguments[0],
+      [](auto a, auto b) { return a > b; }
+    );
+  }
+
+  /**
+   * List#mean(this: List) => Float | null
+   *
+   * Returns arithmetic mean of numbers in the list, or null if the list is
+   * empty.
+   */
+  static value::ptr
+  Mean(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto size = As<value::List>(arguments[0])->GetSize();
+    const auto sum = Sum(runtime, arguments);
+
+    if (!size)
+    {
+      return nullptr;
+    }
+
+    return std::make_shared<value::Float>(
+      As<value::Number>(sum)->ToFloat() / static_cast<double>(size)
+    );
+  }
+
+  /**
+   * List#dot(this: List, other: List) => Number
+   *
+   * Returns dot product of two lists of numbers, which must be of same
+   * size.
+   */
+  static value::ptr
+  Dot(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto a = ToNumericList(runtime, arguments[0]);
+    const auto b = ToNumericList(runtime, arguments[1]);
+    const auto size = a->GetSize();
+
+    if (size != b->GetSize())
+    {
+      throw runtime.MakeError(U"Lists must be of same size.");
+    }
+    if (
+      a->GetUnboxedKind() == value::Kind::Int &&
+      b->GetUnboxedKind() == value::Kind::Int
+    )
+    {
+      const auto& x = IntsOf(a);
+      const auto& y = IntsOf(b);
+
+      return SumInts(
+        runtime,
+        size,
+        [&x, &y](std::size_t i, std::int64_t& result, double& float_result)
+        {
+          // Same as what Number#* gives for the two ints.
+          float_result = static_cast<double>(x[i]) *
+            static_cast<double>(y[i]);
+          if (std::fabs(float_result) > static_cast<double>(INT64_MAX))
+          {
+            return false;
+          }
+          result = static_cast<std::int64_t>(
+            static_cast<std::uint64_t>(x[i]) *
+            static_cast<std::uint64_t>(y[i])
+          );
+
+          return true;
+        }
+      );
+    }
+
+    value::FloatList::container_type x_storage;
+    value::FloatList::container_type y_storage;
+    const auto& x = FloatsOf(a, x_storage);
+    const auto& y = FloatsOf(b, y_storage);
+
+    return std::make_shared<value::Float>(
+      SumFloats(size, [&x, &y](std::size_t i) { return x[i] * y[i]; })
+    );
+  }
+
   /**
    * List#[](this: List, index: Number) => any
    *
@@ -451,12 +1374,7 @@ namespace snek::interpreter::prototype
 
       inline value_type At(size_type index) const override
       {
-        while (index >= m_size)
-        {
-          index -= m_size;
-        }
-
-        return m_list->At(index);
+        return m_list->At(index % m_size);
       }
 
     private:
@@ -489,80 +1407,98 @@ namespace snek::interpreter::prototype
     );
   }
 
+  /**
+   * List#lazy(this: List) => Record
+   *
+   * Returns lazy sequence over elements of the list. Stages added to the
+   * sequence with its `map`, `filter`, `skip` and `take` methods are fused
+   * together and evaluated one element at a time only when the sequence is
+   * consumed with `forEach`, `reduce` or `toList`, so that no intermediate
+   * lists are constructed.
+   */
+  static value::ptr
+  Lazy(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    return sequence::Make(
+      runtime,
+      sequence::FromList(std::static_pointer_cast<value::List>(arguments[0]))
+    );
+  }
+
   void
   MakeList(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
-    const auto optional_int = type::MakeOptional(runtime->int_type());
+    const auto optional_int = type::MakeOptional(builtins->int_type());
 
     fields[U"filter"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         {
           U"callback",
           std::make_shared<type::Function>(
             std::vector<Parameter>{
               { U"element" },
-              { U"index", runtime->int_type() },
+              { U"index", builtins->int_type() },
             },
-            runtime->boolean_type()
+            builtins->boolean_type()
           )
         },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Filter
     );
     fields[U"forEach"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         {
           U"callback",
           std::make_shared<type::Function>(
             std::vector<Parameter>{
               { U"element" },
-              { U"index", runtime->int_type() },
+              { U"index", builtins->int_type() },
             },
-            runtime->any_type()
+            builtins->any_type()
           )
         },
       },
-      runtime->void_type(),
+      builtins->void_type(),
       ForEach
     );
     fields[U"indexOf"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         { U"element" },
         {
           U"start",
-          runtime->int_type(),
+          builtins->int_type(),
           std::make_shared<parser::expression::Int>(std::nullopt, 0)
         },
       },
-      type::MakeOptional(runtime->int_type()),
+      type::MakeOptional(builtins->int_type()),
       IndexOf
     );
     fields[U"includes"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         { U"element" },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       Includes
     );
     fields[U"join"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
-        { U"separator", runtime->string_type() },
+        { U"this", builtins->list_type() },
+        { U"separator", builtins->string_type() },
       },
-      runtime->string_type(),
+      builtins->string_type(),
       Join
     );
     fields[U"lastIndexOf"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         { U"element" },
         {
           U"start",
@@ -570,86 +1506,220 @@ namespace snek::interpreter::prototype
           std::make_shared<parser::expression::Null>()
         },
       },
-      type::MakeOptional(runtime->int_type()),
+      type::MakeOptional(builtins->int_type()),
       LastIndexOf
     );
+    fields[U"lazy"] = value::Function::MakeNative(
+      { { U"this", builtins->list_type() } },
+      builtins->record_type(),
+      Lazy
+    );
     fields[U"map"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         {
           U"callback",
           std::make_shared<type::Function>(
             std::vector<Parameter>{
               { U"element" },
-              { U"index", runtime->int_type() },
+              { U"index", builtins->int_type() },
             },
-            runtime->any_type()
+            builtins->any_type()
           )
         },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Map
     );
+    fields[U"parallelFilter"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        {
+          U"callback",
+          std::make_shared<type::Function>(
+            std::vector<Parameter>{
+              { U"element" },
+              { U"index", builtins->int_type() },
+            },
+            builtins->boolean_type()
+          )
+        },
+      },
+      builtins->list_type(),
+      ParallelFilter
+    );
+    fields[U"parallelMap"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        {
+          U"callback",
+          std::make_shared<type::Function>(
+            std::vector<Parameter>{
+              { U"element" },
+              { U"index", builtins->int_type() },
+            },
+            builtins->any_type()
+          )
+        },
+      },
+      builtins->list_type(),
+      ParallelMap
+    );
+    fields[U"parallelReduce"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        {
+          U"callback",
+          std::make_shared<type::Function>(
+            std::vector<Parameter>{
+              { U"accumulator" },
+              { U"current" },
+              { U"index", builtins->int_type() },
+            },
+            builtins->any_type()
+          )
+        },
+        {
+          U"initial",
+          builtins->any_type(),
+          std::make_shared<parser::expression::Null>(std::nullopt)
+        },
+      },
+      builtins->any_type(),
+      ParallelReduce
+    );
     fields[U"reduce"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
         {
           U"callback",
           std::make_shared<type::Function>(
             std::vector<Parameter>{
               { U"accumulator" },
               { U"current" },
-              { U"index", runtime->int_type() },
+              { U"index", builtins->int_type() },
             },
-            runtime->any_type()
+            builtins->any_type()
           )
         },
         {
           U"initial",
-          runtime->any_type(),
+          builtins->any_type(),
           std::make_shared<parser::expression::Null>(std::nullopt)
         },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Reduce
     );
     fields[U"reverse"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Reverse
     );
     fields[U"size"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
+        { U"this", builtins->list_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       Size
     );
+    fields[U"sort"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        {
+          U"comparator",
+          type::MakeOptional(
+            std::make_shared<type::Function>(
+              std::vector<Parameter>{
+                { U"a" },
+                { U"b" },
+              },
+              builtins->number_type()
+            )
+          ),
+          std::make_shared<parser::expression::Null>(std::nullopt)
+        },
+      },
+      builtins->list_type(),
+      Sort
+    );
+    fields[U"sortBy"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        {
+          U"callback",
+          std::make_shared<type::Function>(
+            std::vector<Parameter>{
+              { U"element" },
+            },
+            builtins->any_type()
+          )
+        },
+      },
+      builtins->list_type(),
+      SortBy
+    );
+    fields[U"dot"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+        { U"other", builtins->list_type() },
+      },
+      builtins->number_type(),
+      Dot
+    );
+    fields[U"max"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+      },
+      type::MakeOptional(builtins->number_type()),
+      Max
+    );
+    fields[U"mean"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+      },
+      type::MakeOptional(builtins->float_type()),
+      Mean
+    );
+    fields[U"min"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+      },
+      type::MakeOptional(builtins->number_type()),
+      Min
+    );
+    fields[U"sum"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->list_type() },
+      },
+      builtins->number_type(),
+      Sum
+    );
 
     fields[U"[]"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
-        { U"index", runtime->number_type() },
+        { U"this", builtins->list_type() },
+        { U"index", builtins->number_type() },
       },
-      runtime->any_type(),
+      builtins->any_type(),
       At
     );
     fields[U"+"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
-        { U"other", runtime->list_type() },
+        { U"this", builtins->list_type() },
+        { U"other", builtins->list_type() },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Concat
     );
     fields[U"*"] = value::Function::MakeNative(
       {
-        { U"this", runtime->list_type() },
-        { U"count", runtime->int_type() },
+        { U"this", builtins->list_type() },
+        { U"count", builtins->int_type() },
       },
-      runtime->list_type(),
+      builtins->list_type(),
       Repeat
     );
   }
@@ -26,6 +26,7 @@
 #include <climits>
 #include <cmath>
 
+#include "snek/interpreter/native.hpp"
 #include "snek/interpreter/runtime.hpp"
 
 namespace snek::interpreter::prototype
@@ -36,12 +37,6 @@ namespace snek::interpreter::prototype
     return static_cast<value::Number*>(value.get());
   }
 
-  static inline double
-  AsFloat(const value::ptr& value)
-  {
-    return AsNumber(value)->ToFloat();
-  }
-
   static inline std::int64_t
   AsInt(const value::ptr& value)
   {
@@ -104,12 +99,10 @@ namespace snek::interpreter::prototype
    *
    * Rounds the number to nearest integer value.
    */
-  static value::ptr
-  Round(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  static std::int64_t
+  Round(double value)
   {
-    return runtime.MakeInt(
-      static_cast<std::int64_t>(std::round(AsFloat(arguments[0])))
-    );
+    return static_cast<std::int64_t>(std::round(value));
   }
 
   /**
@@ -117,12 +110,10 @@ namespace snek::interpreter::prototype
    *
    * Computes the smallest integer value not less than given number.
    */
-  static value::ptr
-  Ceil(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  static std::int64_t
+  Ceil(double value)
   {
-    return runtime.MakeInt(
-      static_cast<std::int64_t>(std::ceil(AsFloat(arguments[0])))
-    );
+    return static_cast<std::int64_t>(std::ceil(value));
   }
 
   /**
@@ -130,12 +121,10 @@ namespace snek::interpreter::prototype
    *
    * Computes the largest integer value not greater than given number.
    */
-  static value::ptr
-  Floor(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  static std::int64_t
+  Floor(double value)
   {
-    return runtime.MakeInt(
-      static_cast<std::int64_t>(std::floor(AsFloat(arguments[0])))
-    );
+    return static_cast<std::int64_t>(std::floor(value));
   }
 
   /**
@@ -374,153 +363,141 @@ namespace snek::interpreter::prototype
 
   void
   MakeNumber(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
-    fields[U"round"] = value::Function::MakeNative(
-      { { U"this", runtime->number_type() } },
-      runtime->int_type(),
-      Round
-    );
-    fields[U"ceil"] = value::Function::MakeNative(
-      { { U"this", runtime->number_type() } },
-      runtime->int_type(),
-      Ceil
-    );
-    fields[U"floor"] = value::Function::MakeNative(
-      { { U"this", runtime->number_type() } },
-      runtime->int_type(),
-      Floor
-    );
+    fields[U"round"] = native::Bind<Round>(builtins, { { U"this" } });
+    fields[U"ceil"] = native::Bind<Ceil>(builtins, { { U"this" } });
+    fields[U"floor"] = native::Bind<Floor>(builtins, { { U"this" } });
 
     fields[U"+"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->number_type(),
+      builtins->number_type(),
       Add
     );
     fields[U"-"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->number_type(),
+      builtins->number_type(),
       Sub
     );
     fields[U"*"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->number_type(),
+      builtins->number_type(),
       Mul
     );
     fields[U"/"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->number_type(),
+      builtins->number_type(),
       Div
     );
     fields[U"%"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->number_type(),
+      builtins->number_type(),
       Mod
     );
     fields[U"&"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       BitwiseAnd
     );
     fields[U"|"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       BitwiseOr
     );
     fields[U"^"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       BitwiseXor
     );
     fields[U"~"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
+        { U"this", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       BitwiseNot
     );
     fields[U"<<"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       LeftShift
     );
     fields[U">>"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       RightShift
     );
     fields[U"<"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       LessThan
     );
     fields[U">"] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       GreaterThan
     );
     fields[U"<="] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       LessThanOrEqual
     );
     fields[U">="] = value::Function::MakeNative(
       {
-        { U"this", runtime->number_type() },
-        { U"other", runtime->number_type() },
+        { U"this", builtins->number_type() },
+        { U"other", builtins->number_type() },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       GreaterThanOrEqual
     );
     fields[U"+@"] = value::Function::MakeNative(
-      { { U"this", runtime->number_type() } },
-      runtime->number_type(),
+      { { U"this", builtins->number_type() } },
+      builtins->number_type(),
       UnaryPlus
     );
     fields[U"-@"] = value::Function::MakeNative(
-      { { U"this", runtime->number_type() } },
-      runtime->number_type(),
+      { { U"this", builtins->number_type() } },
+      builtins->number_type(),
       UnaryMinus
     );
   }
@@ -63,11 +63,13 @@ namespace snek::interpreter::prototype
   static value::ptr
   NotEquals(Runtime& runtime, const std::vector<value::ptr>& arguments)
   {
+    static const std::u32string method_name = U"==";
+
     return runtime.MakeBoolean(!value::ToBoolean(
       value::CallMethod(
         runtime,
         arguments[0],
-        U"==",
+        method_name,
         { arguments[1] }
       )
     ));
@@ -75,24 +77,24 @@ namespace snek::interpreter::prototype
 
   void
   MakeObject(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
     fields[U"toString"] = value::Function::MakeNative(
       { { U"this" } },
-      runtime->string_type(),
+      builtins->string_type(),
       ToString
     );
 
     fields[U"=="] = value::Function::MakeNative(
       { { U"this" }, { U"other" } },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       Equals
     );
     fields[U"!="] = value::Function::MakeNative(
       { { U"this" }, { U"other" } },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       NotEquals
     );
   }
@@ -280,51 +280,51 @@ namespace snek::interpreter::prototype
 
   void
   MakeRecord(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
     fields[U"entries"] = value::Function::MakeNative(
-      { { U"this", runtime->record_type() } },
+      { { U"this", builtins->record_type() } },
       std::make_shared<type::List>(std::make_shared<type::Tuple>(
-        std::vector<type::ptr>{ runtime->string_type(), runtime->any_type() })
+        std::vector<type::ptr>{ builtins->string_type(), builtins->any_type() })
       ),
       Entries
     );
     fields[U"keys"] = value::Function::MakeNative(
-      { { U"this", runtime->record_type() } },
-      std::make_shared<type::List>(runtime->string_type()),
+      { { U"this", builtins->record_type() } },
+      std::make_shared<type::List>(builtins->string_type()),
       Keys
     );
     fields[U"values"] = value::Function::MakeNative(
-      { { U"this", runtime->record_type() } },
-      runtime->list_type(),
+      { { U"this", builtins->record_type() } },
+      builtins->list_type(),
       Values
     );
 
     fields[U"+"] = value::Function::MakeNative(
       {
-        { U"this", runtime->record_type() },
-        { U"other", runtime->record_type() },
+        { U"this", builtins->record_type() },
+        { U"other", builtins->record_type() },
       },
-      runtime->record_type(),
+      builtins->record_type(),
       Concat
     );
     fields[U"-"] = value::Function::MakeNative(
       {
-        { U"this", runtime->record_type() },
-        { U"field", runtime->string_type() },
+        { U"this", builtins->record_type() },
+        { U"field", builtins->string_type() },
       },
-      runtime->record_type(),
+      builtins->record_type(),
       Remove
     );
 
     fields[U"[]"] = value::Function::MakeNative(
       {
-        { U"this", runtime->record_type() },
-        { U"name", runtime->string_type() },
+        { U"this", builtins->record_type() },
+        { U"name", builtins->string_type() },
       },
-      runtime->any_type(),
+      builtins->any_type(),
       At
     );
   }
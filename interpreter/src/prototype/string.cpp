@@ -461,27 +461,27 @@ namespace snek::interpreter::prototype
 
   void
   MakeString(
-    const Runtime* runtime,
+    const Builtins* builtins,
     std::unordered_map<std::u32string, value::ptr>& fields
   )
   {
-    const auto optional_int = type::MakeOptional(runtime->int_type());
+    const auto optional_int = type::MakeOptional(builtins->int_type());
 
     fields[U"codePointAt"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"index", runtime->int_type() },
+        { U"this", builtins->string_type() },
+        { U"index", builtins->int_type() },
       },
-      runtime->int_type(),
+      builtins->int_type(),
       CodePointAt
     );
     fields[U"indexOf"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"other", runtime->string_type() },
+        { U"this", builtins->string_type() },
+        { U"other", builtins->string_type() },
         {
           U"start",
-          runtime->int_type(),
+          builtins->int_type(),
           std::make_shared<parser::expression::Int>(std::nullopt, 0)
         },
       },
@@ -490,16 +490,16 @@ namespace snek::interpreter::prototype
     );
     fields[U"includes"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"other", runtime->string_type() },
+        { U"this", builtins->string_type() },
+        { U"other", builtins->string_type() },
       },
-      runtime->boolean_type(),
+      builtins->boolean_type(),
       Includes
     );
     fields[U"lastIndexOf"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"other", runtime->string_type() },
+        { U"this", builtins->string_type() },
+        { U"other", builtins->string_type() },
         {
           U"start",
           optional_int,
@@ -510,48 +510,48 @@ namespace snek::interpreter::prototype
       LastIndexOf
     );
     fields[U"length"] = value::Function::MakeNative(
-      { { U"this", runtime->string_type() } },
-      runtime->int_type(),
+      { { U"this", builtins->string_type() } },
+      builtins->int_type(),
       Length
     );
     fields[U"reverse"] = value::Function::MakeNative(
-      { { U"this", runtime->string_type() } },
-      runtime->string_type(),
+      { { U"this", builtins->string_type() } },
+      builtins->string_type(),
       Reverse
     );
     fields[U"toLower"] = value::Function::MakeNative(
-      { { U"this", runtime->string_type() } },
-      runtime->string_type(),
+      { { U"this", builtins->string_type() } },
+      builtins->string_type(),
       ToLower
     );
     fields[U"toUpper"] = value::Function::MakeNative(
-      { { U"this", runtime->string_type() } },
-      runtime->string_type(),
+      { { U"this", builtins->string_type() } },
+      builtins->string_type(),
       ToUpper
     );
 
     fields[U"+"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"other", runtime->string_type() }
+        { U"this", builtins->string_type() },
+        { U"other", builtins->string_type() }
       },
-      runtime->string_type(),
+      builtins->string_type(),
       Concatenate
     );
     fields[U"*"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"count", runtime->int_type() },
+        { U"this", builtins->string_type() },
+        { U"count", builtins->int_type() },
       },
-      runtime->string_type(),
+      builtins->string_type(),
       Repeat
     );
     fields[U"[]"] = value::Function::MakeNative(
       {
-        { U"this", runtime->string_type() },
-        { U"index", runtime->int_type() },
+        { U"this", builtins->string_type() },
+        { U"index", builtins->int_type() },
       },
-      runtime->string_type(),
+      builtins->string_type(),
       At
     );
   }
@@ -99,6 +99,10 @@ namespace snek::interpreter
         FindReturnValuesFromBlock(As<Block>(statement), values);
         break;
 
+      case Kind::For:
+        FindReturnValues(As<For>(statement)->body, values);
+        break;
+
       case Kind::If:
         FindReturnValuesFromIf(As<If>(statement), values);
         break;
@@ -167,6 +171,7 @@ namespace snek::interpreter
     switch (statement->kind())
     {
       case Kind::Block:
+      case Kind::For:
       case Kind::If:
       case Kind::Jump:
       case Kind::While:
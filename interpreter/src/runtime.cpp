@@ -23,10 +23,15 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
+
 #include "snek/interpreter/error.hpp"
 #include "snek/interpreter/execute.hpp"
 #include "snek/interpreter/jump.hpp"
+#include "snek/interpreter/module.hpp"
 #include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/task.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
 #include "snek/parser/error.hpp"
 #include "snek/parser/statement.hpp"
 #include "snek/parser/utils.hpp"
@@ -34,153 +39,180 @@
 
 namespace snek::interpreter
 {
-  using prototype_type = std::unordered_map<std::u32string, value::ptr>;
-  using prototype_constructor = void(*)(const Runtime*, prototype_type&);
+  Runtime::Runtime(const module_importer_type& module_importer)
+    : m_builtins(&Builtins::Get())
+    , m_root_scope(std::make_shared<Scope>(m_builtins->scope()))
+    , m_module_importer(module_importer)
+    , m_profiler(nullptr)
+    , m_budget_enabled(false)
+    , m_deadline_countdown(0)
+    , m_interrupted(false)
+    , m_interrupt_flag(&m_interrupted)
+    , m_task(nullptr) {}
 
-  namespace prototype
+  value::ptr
+  Runtime::MakeInt(std::int64_t value)
   {
-    void MakeBoolean(const Runtime*, prototype_type&);
-    void MakeFloat(const Runtime*, prototype_type&);
-    void MakeFunction(const Runtime*, prototype_type&);
-    void MakeInt(const Runtime*, prototype_type&);
-    void MakeList(const Runtime*, prototype_type&);
-    void MakeNumber(const Runtime*, prototype_type&);
-    void MakeObject(const Runtime*, prototype_type&);
-    void MakeRecord(const Runtime*, prototype_type&);
-    void MakeString(const Runtime*, prototype_type&);
+#if defined(SNEK_ENABLE_INT_CACHE)
+    if (const auto cached = m_builtins->GetCachedInt(value))
+    {
+      return *cached;
+    }
+#endif
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(value::Kind::Int, sizeof(value::Int));
+#endif
+
+    return std::make_shared<value::Int>(value);
   }
 
-  static inline value::ptr
-  MakePrototype(
-    const Runtime* runtime,
-    const value::ptr& parent,
-    prototype_constructor constructor = nullptr
-  )
+  Runtime::random_generator_type&
+  Runtime::random_generator()
+  {
+    if (!m_random_generator)
+    {
+      std::random_device device;
+
+      m_random_generator = std::make_shared<random_generator_type>(device());
+    }
+
+    return *m_random_generator;
+  }
+
+  void
+  Runtime::set_budget(const Budget& budget)
   {
-    prototype_type fields;
+    m_budget = budget;
+    m_budget_enabled = budget.fuel || budget.deadline;
+    m_deadline_countdown = 0;
+  }
 
-    fields[U"[[Prototype]]"] = parent;
-    if (constructor)
+  void
+  Runtime::CheckBudget()
+  {
+    if (m_interrupt_flag->exchange(false, std::memory_order_relaxed))
+    {
+      throw MakeError(U"Execution has been interrupted.");
+    }
+    if (m_budget.fuel)
+    {
+      if (!*m_budget.fuel)
+      {
+        throw MakeError(U"Execution budget has been exhausted.");
+      }
+      --*m_budget.fuel;
+    }
+    if (m_budget.deadline && !m_deadline_countdown--)
+    {
+      m_deadline_countdown = kDeadlineCheckInterval - 1;
+      if (clock_type::now() >= *m_budget.deadline)
+      {
+        throw MakeError(U"Execution deadline has been exceeded.");
+      }
+    }
+    if (m_task)
+    {
+      m_task->Tick();
+    }
+  }
+
+  template<class T>
+  static std::optional<T>
+  Tighten(const std::optional<T>& outer, const std::optional<T>& inner)
+  {
+    if (!outer)
+    {
+      return inner;
+    }
+    else if (!inner)
     {
-      constructor(runtime, fields);
+      return outer;
     }
 
-    return value::Record::Make(fields);
+    return std::min(*outer, *inner);
   }
 
-  Runtime::Runtime(const module_importer_type& module_importer)
-    : m_any_type(std::make_shared<type::Any>())
-    , m_boolean_type(std::make_shared<type::Builtin>(type::BuiltinKind::Boolean))
-    , m_float_type(std::make_shared<type::Builtin>(type::BuiltinKind::Float))
-    , m_function_type(std::make_shared<type::Builtin>(type::BuiltinKind::Function))
-    , m_int_type(std::make_shared<type::Builtin>(type::BuiltinKind::Int))
-    , m_list_type(std::make_shared<type::Builtin>(type::BuiltinKind::List))
-    , m_number_type(std::make_shared<type::Builtin>(type::BuiltinKind::Number))
-    , m_record_type(std::make_shared<type::Builtin>(type::BuiltinKind::Record))
-    , m_string_type(std::make_shared<type::Builtin>(type::BuiltinKind::String))
-    , m_void_type(std::make_shared<type::Builtin>(type::BuiltinKind::Void))
-
-    , m_object_prototype(MakePrototype(
-        this,
-        nullptr,
-        prototype::MakeObject
-      ))
-    , m_number_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeNumber
-      ))
-    , m_boolean_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeBoolean
-      ))
-    , m_float_prototype(MakePrototype(
-        this,
-        m_number_prototype,
-        prototype::MakeFloat
-      ))
-    , m_function_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeFunction
-      ))
-    , m_int_prototype(MakePrototype(
-        this,
-        m_number_prototype,
-        prototype::MakeInt
-      ))
-    , m_list_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeList
-      ))
-    , m_record_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeRecord
-      ))
-    , m_string_prototype(MakePrototype(
-        this,
-        m_object_prototype,
-        prototype::MakeString
-      ))
-
-    , m_root_scope(Scope::MakeRootScope(this))
-    , m_module_importer(module_importer)
-#if defined(SNEK_ENABLE_BOOLEAN_CACHE)
-    , m_true_value(std::make_shared<value::Boolean>(true))
-    , m_false_value(std::make_shared<value::Boolean>(false))
-#endif
+  BudgetScope::BudgetScope(Runtime& runtime, const Runtime::Budget& budget)
+    : m_runtime(runtime)
+    , m_previous(runtime.budget())
   {
-#if defined(SNEK_ENABLE_INT_CACHE)
-    for (std::size_t i = 0; i < kIntCacheSize; ++i)
+    Runtime::Budget tightened;
+
+    tightened.fuel = Tighten(m_previous.fuel, budget.fuel);
+    tightened.deadline = Tighten(m_previous.deadline, budget.deadline);
+    m_initial_fuel = tightened.fuel;
+    runtime.set_budget(tightened);
+  }
+
+  BudgetScope::BudgetScope(
+    Runtime& runtime,
+    const std::optional<std::uint64_t>& fuel,
+    const std::optional<Runtime::clock_type::duration>& timeout
+  )
+    : BudgetScope(
+      runtime,
+      Runtime::Budget{
+        fuel,
+        timeout
+          ? std::make_optional(Runtime::clock_type::now() + *timeout)
+          : std::nullopt
+      }
+    ) {}
+
+  BudgetScope::~BudgetScope()
+  {
+    auto restored = m_previous;
+    const auto& remaining = m_runtime.budget().fuel;
+
+    if (restored.fuel && m_initial_fuel && remaining)
     {
-      m_int_cache[i] = std::make_shared<value::Int>(kIntCacheMin + i);
+      restored.fuel = *restored.fuel - std::min(
+        *restored.fuel,
+        *m_initial_fuel - std::min(*m_initial_fuel, *remaining)
+      );
     }
-#endif
+    m_runtime.set_budget(restored);
   }
 
-  value::ptr
-  Runtime::MakeInt(std::int64_t value)
+  WorkStealingPool&
+  Runtime::worker_pool()
   {
-#if defined(SNEK_ENABLE_INT_CACHE)
-    if (value >= kIntCacheMin && value < kIntCacheMax)
+    if (!m_worker_pool)
     {
-      return m_int_cache[value + -kIntCacheMin];
+      m_worker_pool = WorkStealingPool::Default();
     }
-#endif
 
-    return std::make_shared<value::Int>(value);
+    return *m_worker_pool;
   }
 
+  template<class NextStatement>
   static value::ptr
-  ParseAndRunScript(
+  RunStatements(
     Runtime& runtime,
     const Scope::ptr& scope,
-    parser::Lexer& lexer,
     const std::u32string& filename,
     int line,
-    int column
+    int column,
+    NextStatement next_statement
   )
   {
     auto& call_stack = runtime.call_stack();
     value::ptr value;
 
     call_stack.push({
-      std::make_optional<Position>({ filename, line, column }),
+      std::make_optional<Position>({
+        std::make_shared<const std::u32string>(filename),
+        line,
+        column
+      }),
       nullptr,
       {}
     });
     try
     {
-      while (!lexer.PeekToken(parser::Token::Kind::Eof))
+      while (const auto statement = next_statement())
       {
-        value = ExecuteStatement(
-          runtime,
-          scope,
-          parser::statement::Parse(lexer, true)
-        );
+        value = ExecuteStatement(runtime, scope, statement);
       }
     }
     catch (const Jump& jump)
@@ -210,6 +242,34 @@ namespace snek::interpreter
     return value;
   }
 
+  static value::ptr
+  ParseAndRunScript(
+    Runtime& runtime,
+    const Scope::ptr& scope,
+    parser::Lexer& lexer,
+    const std::u32string& filename,
+    int line,
+    int column
+  )
+  {
+    return RunStatements(
+      runtime,
+      scope,
+      filename,
+      line,
+      column,
+      [&lexer]() -> parser::statement::ptr
+      {
+        if (lexer.PeekToken(parser::Token::Kind::Eof))
+        {
+          return nullptr;
+        }
+
+        return parser::statement::Parse(lexer, true);
+      }
+    );
+  }
+
   value::ptr
   Runtime::RunScript(
     const Scope::ptr& scope,
@@ -219,7 +279,14 @@ namespace snek::interpreter
     int column
   )
   {
-    parser::Lexer lexer(source, filename, line, column);
+    // Source code outlives the lexer, so there is no need to copy it.
+    parser::Lexer lexer(
+      source.data(),
+      source.length(),
+      filename,
+      line,
+      column
+    );
 
     return ParseAndRunScript(*this, scope, lexer, filename, line, column);
   }
@@ -238,6 +305,138 @@ namespace snek::interpreter
     return ParseAndRunScript(*this, scope, lexer, filename, line, column);
   }
 
+  static Program::ptr
+  ParseProgram(
+    const Runtime& runtime,
+    parser::Lexer& lexer,
+    const std::u32string& filename,
+    int line,
+    int column
+  )
+  {
+    Program::statement_container_type statements;
+
+    try
+    {
+      while (!lexer.PeekToken(parser::Token::Kind::Eof))
+      {
+        statements.push_back(parser::statement::Parse(lexer, true));
+      }
+    }
+    catch (const parser::SyntaxError& e)
+    {
+      auto error = runtime.MakeError(e.message);
+
+      // Program is not being executed yet, so the position of the syntax
+      // error is the only frame there is to report.
+      error.stack_trace.push({ e.position, nullptr, {} });
+
+      throw error;
+    }
+
+    return std::make_shared<Program>(
+      filename,
+      line,
+      column,
+      std::move(statements)
+    );
+  }
+
+  Program::ptr
+  Runtime::Compile(
+    const std::string& source,
+    const std::u32string& filename,
+    int line,
+    int column
+  )
+  {
+    parser::Lexer lexer(
+      source.data(),
+      source.length(),
+      filename,
+      line,
+      column
+    );
+
+    return ParseProgram(*this, lexer, filename, line, column);
+  }
+
+  Program::ptr
+  Runtime::Compile(
+    const std::u32string& source,
+    const std::u32string& filename,
+    int line,
+    int column
+  )
+  {
+    parser::Lexer lexer(source, filename, line, column);
+
+    return ParseProgram(*this, lexer, filename, line, column);
+  }
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+  static bool
+  ImportsFilesystemModules(const Runtime::module_importer_type& importer)
+  {
+    using function_type = Scope::ptr(*)(Runtime&, const std::u32string&);
+    const auto function = importer.target<function_type>();
+
+    return function && *function == ImportFilesystemModule;
+  }
+#endif
+
+  value::ptr
+  Runtime::Run(const Program::ptr& program, const Scope::ptr& scope)
+  {
+    const auto& statements = program->statements();
+    auto it = std::begin(statements);
+    const auto end = std::end(statements);
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+    // Whole program has already been parsed, so modules imported by it can be
+    // loaded while the statements before the imports are being executed.
+    if (ImportsFilesystemModules(m_module_importer))
+    {
+      module_prefetcher().Prefetch(statements);
+    }
+#endif
+
+    return interpreter::RunStatements(
+      *this,
+      scope,
+      program->filename(),
+      program->line(),
+      program->column(),
+      [&it, &end]() -> parser::statement::ptr
+      {
+        return it != end ? *it++ : nullptr;
+      }
+    );
+  }
+
+  value::ptr
+  Runtime::RunStatements(
+    const Scope::ptr& scope,
+    const std::vector<parser::statement::ptr>& statements,
+    const std::u32string& filename
+  )
+  {
+    auto it = std::begin(statements);
+    const auto end = std::end(statements);
+
+    return interpreter::RunStatements(
+      *this,
+      scope,
+      filename,
+      1,
+      1,
+      [&it, &end]() -> parser::statement::ptr
+      {
+        return it != end ? *it++ : nullptr;
+      }
+    );
+  }
+
   Scope::ptr
   Runtime::ImportModule(const std::u32string& path)
   {
@@ -260,4 +459,17 @@ namespace snek::interpreter
 
     return module;
   }
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+  ModulePrefetcher&
+  Runtime::module_prefetcher()
+  {
+    if (!m_module_prefetcher)
+    {
+      m_module_prefetcher = std::make_shared<ModulePrefetcher>();
+    }
+
+    return *m_module_prefetcher;
+  }
+#endif
 }
@@ -23,6 +23,8 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <atomic>
+
 #include "snek/interpreter/error.hpp"
 #include "snek/interpreter/runtime.hpp"
 
@@ -30,35 +32,50 @@ namespace snek::interpreter
 {
   namespace api
   {
-    void AddGlobalVariables(const Runtime*, Scope::variable_container_type&);
+    void AddGlobalVariables(const Builtins*, Scope::variable_container_type&);
+  }
+
+  thread_local std::uint64_t Scope::s_parallel_section = 0;
+
+  Scope::ParallelSection::ParallelSection()
+    : m_previous(s_parallel_section)
+  {
+    static std::atomic<std::uint64_t> counter(0);
+
+    s_parallel_section = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  Scope::ParallelSection::~ParallelSection()
+  {
+    s_parallel_section = m_previous;
   }
 
   Scope::ptr
-  Scope::MakeRootScope(const Runtime* runtime)
+  Scope::MakeRootScope(const Builtins* builtins)
   {
     auto scope = std::make_shared<Scope>();
 
-    scope->m_types[U"Boolean"] = { runtime->boolean_type() };
-    scope->m_types[U"Float"] = { runtime->float_type() };
-    scope->m_types[U"Function"] = { runtime->function_type() };
-    scope->m_types[U"Int"] = { runtime->int_type() };
-    scope->m_types[U"List"] = { runtime->list_type() };
-    scope->m_types[U"Number"] = { runtime->number_type() };
-    scope->m_types[U"Object"] = { runtime->any_type() };
-    scope->m_types[U"Record"] = { runtime->record_type() };
-    scope->m_types[U"String"] = { runtime->string_type() };
-
-    scope->m_variables[U"Boolean"] = { runtime->boolean_prototype(), true };
-    scope->m_variables[U"Float"] = { runtime->float_prototype(), true };
-    scope->m_variables[U"Function"] = { runtime->function_prototype(), true };
-    scope->m_variables[U"Int"] = { runtime->int_prototype(), true };
-    scope->m_variables[U"Number"] = { runtime->number_prototype(), true };
-    scope->m_variables[U"List"] = { runtime->list_prototype(), true };
-    scope->m_variables[U"Object"] = { runtime->object_prototype(), true };
-    scope->m_variables[U"Record"] = { runtime->record_prototype(), true };
-    scope->m_variables[U"String"] = { runtime->string_prototype(), true };
-
-    api::AddGlobalVariables(runtime, scope->m_variables);
+    scope->m_types[U"Boolean"] = { builtins->boolean_type() };
+    scope->m_types[U"Float"] = { builtins->float_type() };
+    scope->m_types[U"Function"] = { builtins->function_type() };
+    scope->m_types[U"Int"] = { builtins->int_type() };
+    scope->m_types[U"List"] = { builtins->list_type() };
+    scope->m_types[U"Number"] = { builtins->number_type() };
+    scope->m_types[U"Object"] = { builtins->any_type() };
+    scope->m_types[U"Record"] = { builtins->record_type() };
+    scope->m_types[U"String"] = { builtins->string_type() };
+
+    scope->m_variables[U"Boolean"] = { builtins->boolean_prototype(), true };
+    scope->m_variables[U"Float"] = { builtins->float_prototype(), true };
+    scope->m_variables[U"Function"] = { builtins->function_prototype(), true };
+    scope->m_variables[U"Int"] = { builtins->int_prototype(), true };
+    scope->m_variables[U"Number"] = { builtins->number_prototype(), true };
+    scope->m_variables[U"List"] = { builtins->list_prototype(), true };
+    scope->m_variables[U"Object"] = { builtins->object_prototype(), true };
+    scope->m_variables[U"Record"] = { builtins->record_prototype(), true };
+    scope->m_variables[U"String"] = { builtins->string_prototype(), true };
+
+    api::AddGlobalVariables(builtins, scope->m_variables);
 
     return scope;
   }
@@ -160,6 +177,17 @@ namespace snek::interpreter
           U"' has been declared as read only."
         };
       }
+      else if (s_parallel_section && m_parallel_section != s_parallel_section)
+      {
+        // TODO: Include stack trace.
+        throw Error{
+          {},
+          U"Variable `" +
+          name +
+          U"' is shared between threads of an parallel operation and "
+          U"cannot be assigned."
+        };
+      }
       it->second.value = value;
     }
     else if (m_parent)
@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/interpreter/builtins.hpp"
+#include "snek/interpreter/error.hpp"
+#include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/sequence.hpp"
+
+namespace snek::interpreter::sequence
+{
+  namespace
+  {
+    /**
+     * Single stage of lazy sequence pipeline.
+     */
+    struct Stage
+    {
+      enum class Kind
+      {
+        Filter,
+        Map,
+        Skip,
+        Take,
+      };
+
+      Kind kind;
+      std::shared_ptr<value::Function> callback;
+      std::size_t count;
+    };
+
+    /**
+     * Pipeline consists of source and stages which are applied to the
+     * elements produced by the source one element at a time, so that no
+     * intermediate lists are constructed between the stages.
+     */
+    struct Pipeline
+    {
+      source_type source;
+      std::vector<Stage> stages;
+    };
+
+    using pipeline_ptr = std::shared_ptr<const Pipeline>;
+
+    /**
+     * Record which exposes pipeline to scripts. Methods of the sequence are
+     * in the shared sequence prototype, so the record itself only holds the
+     * pipeline and a reference to the prototype.
+     */
+    class SequenceRecord final : public value::Record
+    {
+    public:
+      explicit SequenceRecord(
+        const pipeline_ptr& pipeline,
+        const value::ptr& prototype
+      )
+        : m_pipeline(pipeline)
+        , m_prototype(prototype) {}
+
+      inline const pipeline_ptr& pipeline() const
+      {
+        return m_pipeline;
+      }
+
+      inline size_type
+      GetSize() const override
+      {
+        return 1;
+      }
+
+      std::optional<value::ptr>
+      GetOwnProperty(const key_type& name) const override
+      {
+        if (!name.compare(U"[[Prototype]]"))
+        {
+          return m_prototype;
+        }
+
+        return std::nullopt;
+      }
+
+      std::vector<key_type>
+      GetOwnPropertyNames() const override
+      {
+        return { U"[[Prototype]]" };
+      }
+
+    private:
+      const pipeline_ptr m_pipeline;
+      const value::ptr m_prototype;
+    };
+  }
+
+  static void
+  StreamPipeline(
+    Runtime& runtime,
+    const Pipeline& pipeline,
+    const sink_type& sink
+  )
+  {
+    const auto& stages = pipeline.stages;
+    const auto stage_count = stages.size();
+    std::vector<std::size_t> counters(stage_count + 1, 0);
+    generator_type generator;
+    value::ptr element;
+
+    for (const auto& stage : stages)
+    {
+      if (stage.kind == Stage::Kind::Take && !stage.count)
+      {
+        return;
+      }
+    }
+
+    generator = pipeline.source(runtime);
+    while (generator(runtime, element))
+    {
+      bool accepted = true;
+      bool done = false;
+
+      for (std::size_t i = 0; accepted && i < stage_count; ++i)
+      {
+        const auto& stage = stages[i];
+        const auto index = counters[i]++;
+
+        switch (stage.kind)
+        {
+          case Stage::Kind::Filter:
+            accepted = value::ToBoolean(
+              value::Function::Call(
+                runtime,
+                stage.callback,
+                {
+                  element,
+                  runtime.MakeInt(static_cast<std::int64_t>(index)),
+                }
+              )
+            );
+            break;
+
+          case Stage::Kind::Map:
+            element = value::Function::Call(
+              runtime,
+              stage.callback,
+              {
+                element,
+                runtime.MakeInt(static_cast<std::int64_t>(index)),
+              }
+            );
+            break;
+
+          case Stage::Kind::Skip:
+            accepted = index >= stage.count;
+            break;
+
+          case Stage::Kind::Take:
+            // No element can make it past this stage after the last one has
+            // been taken, so the whole pipeline can be stopped.
+            if (index + 1 >= stage.count)
+            {
+              done = true;
+            }
+            break;
+        }
+      }
+
+      if (accepted && !sink(element, counters[stage_count]++))
+      {
+        break;
+      }
+      if (done)
+      {
+        break;
+      }
+    }
+  }
+
+  static value::ptr
+  MakeSequence(const Runtime& runtime, const pipeline_ptr& pipeline)
+  {
+    return std::make_shared<SequenceRecord>(
+      pipeline,
+      runtime.sequence_prototype()
+    );
+  }
+
+  static const pipeline_ptr&
+  PipelineOf(const Runtime& runtime, const value::ptr& value)
+  {
+    const auto sequence = dynamic_cast<const SequenceRecord*>(value.get());
+
+    if (!sequence)
+    {
+      throw runtime.MakeError(U"Sequence expected.");
+    }
+
+    return sequence->pipeline();
+  }
+
+  static value::ptr
+  AddStage(
+    const Runtime& runtime,
+    const value::ptr& sequence,
+    const Stage& stage
+  )
+  {
+    auto result = std::make_shared<Pipeline>(*PipelineOf(runtime, sequence));
+
+    result->stages.push_back(stage);
+
+    return MakeSequence(runtime, result);
+  }
+
+  static std::size_t
+  AsCount(const Runtime& runtime, const value::ptr& value)
+  {
+    const auto count = static_cast<const value::Int*>(value.get())->value;
+
+    if (count < 0)
+    {
+      throw runtime.MakeError(U"Count cannot be negative.");
+    }
+
+    return static_cast<std::size_t>(count);
+  }
+
+  template<Stage::Kind kind>
+  static value::ptr
+  AddCallbackStage(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    return AddStage(
+      runtime,
+      arguments[0],
+      {
+        kind,
+        std::static_pointer_cast<value::Function>(arguments[1]),
+        0,
+      }
+    );
+  }
+
+  template<Stage::Kind kind>
+  static value::ptr
+  AddCountStage(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    return AddStage(
+      runtime,
+      arguments[0],
+      { kind, nullptr, AsCount(runtime, arguments[1]) }
+    );
+  }
+
+  /**
+   * Sequence#forEach(this: Record, callback: Function) => null
+   */
+  static value::ptr
+  ForEach(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+
+    StreamPipeline(
+      runtime,
+      *PipelineOf(runtime, arguments[0]),
+      [&](const value::ptr& element, std::size_t index)
+      {
+        value::Function::Call(
+          runtime,
+          callback,
+          {
+            element,
+            runtime.MakeInt(static_cast<std::int64_t>(index)),
+          }
+        );
+
+        return true;
+      }
+    );
+
+    return nullptr;
+  }
+
+  /**
+   * Sequence#reduce(
+   *   this: Record,
+   *   callback: Function,
+   *   initial: any = null
+   * ) => any
+   */
+  static value::ptr
+  Reduce(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    const auto callback = std::static_pointer_cast<value::Function>(
+      arguments[1]
+    );
+    auto result = arguments[2];
+    bool has_result = !value::IsNull(result);
+
+    StreamPipeline(
+      runtime,
+      *PipelineOf(runtime, arguments[0]),
+      [&](const value::ptr& element, std::size_t index)
+      {
+        if (!has_result)
+        {
+          result = element;
+          has_result = true;
+        } else {
+          result = value::Function::Call(
+            runtime,
+            callback,
+            {
+              result,
+              element,
+              runtime.MakeInt(static_cast<std::int64_t>(index)),
+            }
+          );
+        }
+
+        return true;
+      }
+    );
+
+    return result;
+  }
+
+  /**
+   * Sequence#toList(this: Record) => List
+   */
+  static value::ptr
+  ToList(Runtime& runtime, const std::vector<value::ptr>& arguments)
+  {
+    std::vector<value::ptr> result;
+
+    StreamPipeline(
+      runtime,
+      *PipelineOf(runtime, arguments[0]),
+      [&result](const value::ptr& element, std::size_t)
+      {
+        result.push_back(element);
+
+        return true;
+      }
+    );
+
+    return value::List::Make(result);
+  }
+
+  value::ptr
+  Make(const Runtime& runtime, const source_type& source)
+  {
+    auto pipeline = std::make_shared<Pipeline>();
+
+    pipeline->source = source;
+
+    return MakeSequence(runtime, pipeline);
+  }
+
+  source_type
+  FromList(const std::shared_ptr<value::List>& list)
+  {
+    return [list](Runtime&) -> generator_type
+    {
+      std::size_t index = 0;
+
+      return [list, index](Runtime&, value::ptr& element) mutable
+      {
+        if (index >= list->GetSize())
+        {
+          return false;
+        }
+        element = list->At(index++);
+
+        return true;
+      };
+    };
+  }
+
+  bool
+  IsSequence(const value::ptr& value)
+  {
+    return dynamic_cast<const SequenceRecord*>(value.get()) != nullptr;
+  }
+
+  void
+  Stream(Runtime& runtime, const value::ptr& sequence, const sink_type& sink)
+  {
+    StreamPipeline(
+      runtime,
+      *static_cast<const SequenceRecord*>(sequence.get())->pipeline(),
+      sink
+    );
+  }
+}
+
+namespace snek::interpreter::prototype
+{
+  void
+  MakeSequence(
+    const Builtins* builtins,
+    std::unordered_map<std::u32string, value::ptr>& fields
+  )
+  {
+    using namespace sequence;
+
+    fields[U"filter"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"callback", builtins->function_type() },
+      },
+      builtins->record_type(),
+      AddCallbackStage<Stage::Kind::Filter>
+    );
+    fields[U"forEach"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"callback", builtins->function_type() },
+      },
+      builtins->void_type(),
+      ForEach
+    );
+    fields[U"map"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"callback", builtins->function_type() },
+      },
+      builtins->record_type(),
+      AddCallbackStage<Stage::Kind::Map>
+    );
+    fields[U"reduce"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"callback", builtins->function_type() },
+        {
+          U"initial",
+          builtins->any_type(),
+          std::make_shared<parser::expression::Null>(std::nullopt)
+        },
+      },
+      builtins->any_type(),
+      Reduce
+    );
+    fields[U"skip"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"count", builtins->int_type() },
+      },
+      builtins->record_type(),
+      AddCountStage<Stage::Kind::Skip>
+    );
+    fields[U"take"] = value::Function::MakeNative(
+      {
+        { U"this", builtins->record_type() },
+        { U"count", builtins->int_type() },
+      },
+      builtins->record_type(),
+      AddCountStage<Stage::Kind::Take>
+    );
+    fields[U"toList"] = value::Function::MakeNative(
+      { { U"this", builtins->record_type() } },
+      builtins->list_type(),
+      ToList
+    );
+  }
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/interpreter/statistics.hpp"
+
+namespace snek::interpreter
+{
+  using entry_type = std::pair<std::string, Statistics::counter_type>;
+
+  static const char* expression_kind_names[] =
+  {
+    "Assign",
+    "Binary",
+    "Boolean",
+    "Call",
+    "Decrement",
+    "Float",
+    "Function",
+    "Id",
+    "Increment",
+    "Int",
+    "List",
+    "Null",
+    "Property",
+    "Record",
+    "Spread",
+    "Subscript",
+    "String",
+    "Ternary",
+    "Unary",
+  };
+
+  static const char* statement_kind_names[] =
+  {
+    "Block",
+    "DeclareType",
+    "DeclareVar",
+    "Expression",
+    "For",
+    "If",
+    "Import",
+    "Jump",
+    "While",
+  };
+
+  static_assert(
+    sizeof(expression_kind_names) / sizeof(expression_kind_names[0]) ==
+    Statistics::kExpressionKindCount
+  );
+  static_assert(
+    sizeof(statement_kind_names) / sizeof(statement_kind_names[0]) ==
+    Statistics::kStatementKindCount
+  );
+
+  static void
+  WriteSection(
+    std::ostream& output,
+    const char* title,
+    std::vector<entry_type>& entries
+  )
+  {
+    std::size_t width = 0;
+
+    entries.erase(
+      std::remove_if(
+        std::begin(entries),
+        std::end(entries),
+        [](const entry_type& entry)
+        {
+          return !entry.second;
+        }
+      ),
+      std::end(entries)
+    );
+    if (entries.empty())
+    {
+      return;
+    }
+    std::sort(
+      std::begin(entries),
+      std::end(entries),
+      [](const entry_type& a, const entry_type& b)
+      {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+      }
+    );
+    for (const auto& entry : entries)
+    {
+      width = std::max(width, entry.first.length());
+    }
+    output << title << ':' << std::endl;
+    for (const auto& entry : entries)
+    {
+      output << "  "
+             << std::left << std::setw(static_cast<int>(width))
+             << entry.first
+             << "  "
+             << std::right << std::setw(12)
+             << entry.second
+             << std::endl;
+    }
+  }
+
+  template<std::size_t N>
+  static std::vector<entry_type>
+  MakeEntries(
+    const char* const* names,
+    const std::array<Statistics::counter_type, N>& counters
+  )
+  {
+    std::vector<entry_type> entries;
+
+    entries.reserve(N);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      entries.emplace_back(names[i], counters[i]);
+    }
+
+    return entries;
+  }
+
+  Statistics::Statistics(const Statistics& that)
+    : expressions(that.expressions)
+    , statements(that.statements)
+    , method_calls(that.method_calls)
+    , property_cache_hits(that.property_cache_hits)
+    , property_cache_misses(that.property_cache_misses)
+    , native_calls(that.native_calls)
+    , scripted_calls(that.scripted_calls)
+    , parameter_checks(that.parameter_checks) {}
+
+  Statistics&
+  Statistics::operator=(const Statistics& that)
+  {
+    if (this != &that)
+    {
+      Reset();
+      Merge(that);
+    }
+
+    return *this;
+  }
+
+  void
+  Statistics::CountMethodCall(const std::u32string& name)
+  {
+    auto& counter = m_method_name_addresses[&name];
+
+    // Same address may have been used by another name before, if the name
+    // is not in static storage.
+    if (!counter || counter->first != name)
+    {
+      if (m_method_name_addresses.size() > kMaxMethodNameAddresses)
+      {
+        m_method_name_addresses.clear();
+        CountMethodCall(name);
+        return;
+      }
+      counter = &*method_calls.try_emplace(name).first;
+    }
+    ++counter->second;
+  }
+
+  void
+  Statistics::Merge(const Statistics& that)
+  {
+    for (std::size_t i = 0; i < kExpressionKindCount; ++i)
+    {
+      expressions[i] += that.expressions[i];
+    }
+    for (std::size_t i = 0; i < kStatementKindCount; ++i)
+    {
+      statements[i] += that.statements[i];
+    }
+    for (const auto& entry : that.method_calls)
+    {
+      method_calls[entry.first] += entry.second;
+    }
+    property_cache_hits += that.property_cache_hits;
+    property_cache_misses += that.property_cache_misses;
+    native_calls += that.native_calls;
+    scripted_calls += that.scripted_calls;
+    parameter_checks += that.parameter_checks;
+  }
+
+  void
+  Statistics::Reset()
+  {
+    expressions.fill(0);
+    statements.fill(0);
+    method_calls.clear();
+    m_method_name_addresses.clear();
+    property_cache_hits = 0;
+    property_cache_misses = 0;
+    native_calls = 0;
+    scripted_calls = 0;
+    parameter_checks = 0;
+  }
+
+  void
+  Statistics::Write(std::ostream& output) const
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    auto expression_entries = MakeEntries(expression_kind_names, expressions);
+    auto statement_entries = MakeEntries(statement_kind_names, statements);
+    std::vector<entry_type> method_entries;
+    std::vector<entry_type> other_entries =
+    {
+      { "Native function calls", native_calls },
+      { "Scripted function calls", scripted_calls },
+      { "Parameter type checks", parameter_checks },
+      { "Property cache hits", property_cache_hits },
+      { "Property cache misses", property_cache_misses },
+    };
+
+    method_entries.reserve(method_calls.size());
+    for (const auto& entry : method_calls)
+    {
+      method_entries.emplace_back(encode(entry.first), entry.second);
+    }
+
+    WriteSection(output, "Expressions evaluated", expression_entries);
+    WriteSection(output, "Statements executed", statement_entries);
+    WriteSection(output, "Methods called", method_entries);
+    WriteSection(output, "Other", other_entries);
+  }
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <ucontext.h>
+#  include <unistd.h>
+#endif
+
+#include "snek/interpreter/task.hpp"
+
+namespace snek::interpreter
+{
+  namespace
+  {
+    /**
+     * Thrown in a suspended task which is being destroyed, in order to
+     * unwind it's stack. Not derived from Error, so that nothing in the
+     * interpreter catches it.
+     */
+    struct Cancellation {};
+  }
+
+#if !defined(_WIN32)
+  struct Task::Context
+  {
+    ucontext_t task;
+    ucontext_t caller;
+    void* stack = MAP_FAILED;
+    std::size_t stack_size = 0;
+
+    ~Context()
+    {
+      if (stack != MAP_FAILED)
+      {
+        munmap(stack, stack_size);
+      }
+    }
+  };
+#else
+  struct Task::Context {};
+#endif
+
+  /** Task which is about to begin executing on the current thread. */
+  static thread_local Task* starting_task = nullptr;
+
+  Task::Task(Runtime& runtime, const body_type& body)
+    : m_runtime(runtime)
+    , m_body(body)
+    , m_context(std::make_unique<Context>())
+    , m_state(State::Suspended)
+    , m_ticks(0)
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    , m_allocation_site(nullptr)
+#endif
+    , m_started(false)
+    , m_cancelled(false) {}
+
+  Task::~Task()
+  {
+    // Unwind the stack of a task which has been suspended in the middle of
+    // it's execution, so that the values referenced from it are released.
+    if (m_started && !done())
+    {
+      m_cancelled = true;
+      try
+      {
+        Resume();
+      }
+      catch (...)
+      {
+      }
+    }
+  }
+
+  Task::ptr
+  Task::Make(Runtime& runtime, const body_type& body, std::size_t stack_size)
+  {
+    ptr task(new Task(runtime, body));
+
+#if !defined(_WIN32)
+    auto& context = *task->m_context;
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+    // Round the stack up to whole pages, plus one inaccessible page below
+    // the stack which catches overflows.
+    context.stack_size = (stack_size + page_size - 1) / page_size * page_size
+      + page_size;
+    context.stack = mmap(
+      nullptr,
+      context.stack_size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+    );
+    if (context.stack == MAP_FAILED)
+    {
+      throw runtime.MakeError(U"Unable to allocate stack for a task.");
+    }
+    mprotect(context.stack, page_size, PROT_NONE);
+    getcontext(&context.task);
+    context.task.uc_stack.ss_sp = static_cast<char*>(context.stack)
+      + page_size;
+    context.task.uc_stack.ss_size = context.stack_size - page_size;
+    context.task.uc_link = &context.caller;
+    makecontext(&context.task, Entry, 0);
+#else
+    static_cast<void>(stack_size);
+
+    throw runtime.MakeError(
+      U"Resumable execution is not supported on this platform."
+    );
+#endif
+
+    return task;
+  }
+
+  Task::ptr
+  Task::MakeScript(
+    Runtime& runtime,
+    const Scope::ptr& scope,
+    const std::u32string& source,
+    const std::u32string& filename
+  )
+  {
+    return Make(runtime, [scope, source, filename](Runtime& runtime)
+    {
+      return runtime.RunScript(scope, source, filename);
+    });
+  }
+
+  void
+  Task::Entry()
+  {
+    const auto task = starting_task;
+
+    starting_task = nullptr;
+    try
+    {
+      task->m_result = task->m_body(task->m_runtime);
+      task->m_state = State::Finished;
+    }
+    catch (const Error& e)
+    {
+      task->m_error = e;
+      task->m_state = State::Failed;
+    }
+    catch (const Cancellation&)
+    {
+      task->m_state = State::Failed;
+    }
+    catch (...)
+    {
+      task->m_exception = std::current_exception();
+      task->m_state = State::Failed;
+    }
+    // Returning from here continues from the context given as uc_link,
+    // which is the caller of Resume().
+  }
+
+  bool
+  Task::Resume()
+  {
+#if !defined(_WIN32)
+    if (done() || m_state == State::Running)
+    {
+      return done();
+    }
+    else if (m_state == State::Waiting && !m_cancelled)
+    {
+      return false;
+    }
+    else if (m_runtime.task())
+    {
+      throw m_runtime.MakeError(
+        U"Task cannot be resumed while another task is running."
+      );
+    }
+    if (!m_started)
+    {
+      m_started = true;
+      starting_task = this;
+    }
+    // Budget of the caller is replaced with the budget of the task while it
+    // runs, so that budget scopes of interleaved tasks do not see each
+    // other.
+    const auto caller_budget = m_runtime.budget();
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    const auto caller_allocation_site = AllocationTracker::site();
+
+    AllocationTracker::set_site(m_allocation_site);
+#endif
+    std::swap(m_runtime.call_stack(), m_call_stack);
+    m_runtime.set_budget(m_budget);
+    m_runtime.set_task(this);
+    m_state = State::Running;
+    swapcontext(&m_context->caller, &m_context->task);
+    m_runtime.set_task(nullptr);
+    m_budget = m_runtime.budget();
+    m_runtime.set_budget(caller_budget);
+    std::swap(m_runtime.call_stack(), m_call_stack);
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    m_allocation_site = AllocationTracker::site();
+    AllocationTracker::set_site(caller_allocation_site);
+#endif
+    if (m_exception)
+    {
+      const auto exception = m_exception;
+
+      m_exception = nullptr;
+      std::rethrow_exception(exception);
+    }
+#endif
+
+    return done();
+  }
+
+  void
+  Task::Complete(const value::ptr& value)
+  {
+    if (m_state == State::Waiting)
+    {
+      m_awaited_value = value;
+      m_state = State::Suspended;
+    }
+  }
+
+  void
+  Task::Fail(const std::u32string& message)
+  {
+    if (m_state == State::Waiting)
+    {
+      m_awaited_error = message;
+      m_state = State::Suspended;
+    }
+  }
+
+  void
+  Task::Yield(Runtime& runtime)
+  {
+    if (const auto task = runtime.task())
+    {
+      task->Suspend();
+    }
+  }
+
+  value::ptr
+  Task::Await(Runtime& runtime, const start_type& start)
+  {
+    const auto task = runtime.task();
+    value::ptr value;
+
+    if (!task)
+    {
+      throw runtime.MakeError(
+        U"Asynchronous function cannot be called outside of a task."
+      );
+    }
+    task->m_awaited_value = nullptr;
+    task->m_awaited_error.reset();
+    task->m_state = State::Waiting;
+    start(task->shared_from_this());
+    // The operation may also have been completed already by the function.
+    while (task->m_state == State::Waiting)
+    {
+      task->Suspend();
+    }
+    task->m_state = State::Running;
+    if (task->m_awaited_error)
+    {
+      const auto message = *task->m_awaited_error;
+
+      task->m_awaited_error.reset();
+
+      throw runtime.MakeError(message);
+    }
+    std::swap(value, task->m_awaited_value);
+
+    return value;
+  }
+
+  void
+  Task::Suspend()
+  {
+#if !defined(_WIN32)
+    if (m_state == State::Running)
+    {
+      m_state = State::Suspended;
+    }
+    swapcontext(&m_context->task, &m_context->caller);
+    if (m_cancelled)
+    {
+      throw Cancellation();
+    }
+#endif
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "snek/interpreter/thread_pool.hpp"
+
+namespace snek::interpreter
+{
+  std::size_t
+  ThreadPool::DefaultSize()
+  {
+    const auto size = std::thread::hardware_concurrency();
+
+    return size > 0 ? size : 1;
+  }
+
+  ThreadPool&
+  ThreadPool::Shared()
+  {
+    static ThreadPool pool;
+
+    return pool;
+  }
+
+  ThreadPool::ThreadPool(std::size_t size)
+    : m_stopping(false)
+  {
+    m_workers.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      m_workers.emplace_back(&ThreadPool::Work, this);
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      m_stopping = true;
+      m_tasks.clear();
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+  }
+
+  void
+  ThreadPool::Submit(task_type task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+  }
+
+  void
+  ThreadPool::Work()
+  {
+    for (;;)
+    {
+      task_type task;
+
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(
+          lock,
+          [this]() { return m_stopping || !m_tasks.empty(); }
+        );
+        if (m_stopping)
+        {
+          return;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+}
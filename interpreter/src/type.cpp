@@ -63,7 +63,7 @@ namespace snek::interpreter::type
       }
 
       // TODO: Get rid of duplicates with equality comparison.
-      return std::make_shared<Union>(types);
+      return std::make_shared<Union>(result);
     }
   }
 }
@@ -76,6 +76,19 @@ namespace snek::interpreter::value
     }
   }
 
+  static inline ptr
+  BindProperty(const ptr& value, const ptr& property)
+  {
+    if (IsFunction(property))
+    {
+      return Function::Bind(
+        value,
+        std::static_pointer_cast<Function>(property)
+      );
+    }
+
+    return property;
+  }
 
   std::optional<ptr>
   GetProperty(
@@ -84,60 +97,42 @@ namespace snek::interpreter::value
     const std::u32string& name
   )
   {
-    const auto kind = KindOf(value);
-
-#if defined(SNEK_ENABLE_PROPERTY_CACHE)
-    if (value)
-    {
-      const auto cached_property = value->m_property_cache.find(name);
-
-      if (cached_property != std::end(value->m_property_cache))
-      {
-        return cached_property->second;
-      }
-    }
-#endif
-    if (kind == Kind::Record)
+    if (KindOf(value) == Kind::Record)
     {
       if (const auto property = As<Record>(value)->GetOwnProperty(name))
       {
         return *property;
       }
     }
+
+    const auto start = GetPrototypeOf(runtime, value);
+
+#if defined(SNEK_ENABLE_PROPERTY_CACHE)
+    if (const auto property = runtime.property_cache().Find(start, name))
+    {
+#  if defined(SNEK_ENABLE_STATISTICS)
+      ++runtime.statistics().property_cache_hits;
+#  endif
+
+      return BindProperty(value, *property);
+    }
+#  if defined(SNEK_ENABLE_STATISTICS)
+    ++runtime.statistics().property_cache_misses;
+#  endif
+#endif
     for (
-      auto prototype = GetPrototypeOf(runtime, value);
+      auto prototype = start;
       IsRecord(prototype);
       prototype = GetPrototypeOf(runtime, prototype)
     )
     {
-      const auto property = As<Record>(prototype)->GetOwnProperty(name);
-
-      if (property)
+      if (const auto property = As<Record>(prototype)->GetOwnProperty(name))
       {
-        if (IsFunction(*property))
-        {
-          const auto function = Function::Bind(
-            value,
-            std::static_pointer_cast<Function>(*property)
-          );
-
-#if defined(SNEK_ENABLE_PROPERTY_CACHE)
-          if (value)
-          {
-            value->m_property_cache[name] = function;
-          }
-#endif
-
-          return function;
-        }
 #if defined(SNEK_ENABLE_PROPERTY_CACHE)
-        if (value)
-        {
-          value->m_property_cache[name] = *property;
-        }
+        runtime.property_cache().Insert(start, name, prototype, *property);
 #endif
 
-        return *property;
+        return BindProperty(value, *property);
       }
     }
 
@@ -154,6 +149,10 @@ namespace snek::interpreter::value
     bool tail_call
   )
   {
+#if defined(SNEK_ENABLE_STATISTICS)
+    runtime.statistics().CountMethodCall(name);
+#endif
+
     const auto property = GetProperty(runtime, value, name);
 
     if (!property)
@@ -27,6 +27,7 @@
 #include "snek/interpreter/evaluate.hpp"
 #include "snek/interpreter/execute.hpp"
 #include "snek/interpreter/jump.hpp"
+#include "snek/interpreter/profiler.hpp"
 #include "snek/interpreter/value.hpp"
 
 namespace snek::interpreter::value
@@ -122,6 +123,9 @@ namespace snek::interpreter::value
       {
         std::vector<ptr> callback_arguments;
 
+#if defined(SNEK_ENABLE_STATISTICS)
+        ++runtime.statistics().native_calls;
+#endif
         callback_arguments.reserve(m_parameters.size());
         ProcessArguments(
           runtime,
@@ -182,6 +186,9 @@ namespace snek::interpreter::value
             : runtime.root_scope()
         );
 
+#if defined(SNEK_ENABLE_STATISTICS)
+        ++runtime.statistics().scripted_calls;
+#endif
         ProcessArguments(
           runtime,
           scope,
@@ -313,6 +320,10 @@ namespace snek::interpreter::value
     const std::shared_ptr<Function>& function
   )
   {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(Kind::Function, sizeof(BoundFunction));
+#endif
+
     return std::make_shared<BoundFunction>(this_value, function);
   }
 
@@ -329,6 +340,7 @@ namespace snek::interpreter::value
     const auto use_tail = tail_call && !call_stack.empty();
     ptr value;
 
+    runtime.Checkpoint();
     if (use_tail)
     {
       auto& frame = call_stack.top();
@@ -338,6 +350,12 @@ namespace snek::interpreter::value
     } else {
       call_stack.push({ position, function, arguments });
     }
+#if defined(SNEK_ENABLE_PROFILER)
+    if (const auto profiler = runtime.profiler())
+    {
+      profiler->Poll(runtime);
+    }
+#endif
     try
     {
       value = function->Call(runtime, arguments, position);
@@ -23,6 +23,7 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include "snek/interpreter/builtins.hpp"
 #include "snek/interpreter/value.hpp"
 
 namespace snek::interpreter::value
@@ -57,12 +58,114 @@ namespace snek::interpreter::value
     };
   }
 
+  /**
+   * Copies elements of given kind into unboxed container, or returns false
+   * if some of the elements are of different kind.
+   */
+  template<class T, class Container>
+  static bool
+  Unbox(Kind kind, const std::vector<ptr>& elements, Container& container)
+  {
+    for (const auto& element : elements)
+    {
+      if (KindOf(element) != kind)
+      {
+        return false;
+      }
+    }
+    container.reserve(elements.size());
+    for (const auto& element : elements)
+    {
+      container.push_back(static_cast<const T*>(element.get())->value);
+    }
+
+    return true;
+  }
+
   std::shared_ptr<List>
   List::Make(const std::vector<value_type>& elements)
   {
+    if (!elements.empty())
+    {
+      const auto kind = KindOf(elements[0]);
+
+      if (kind == Kind::Int)
+      {
+        IntList::container_type container;
+
+        if (Unbox<Int>(kind, elements, container))
+        {
+          return IntList::Make(std::move(container));
+        }
+      }
+      else if (kind == Kind::Float)
+      {
+        FloatList::container_type container;
+
+        if (Unbox<Float>(kind, elements, container))
+        {
+          return FloatList::Make(std::move(container));
+        }
+      }
+    }
+
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(
+      Kind::List,
+      sizeof(VectorList) + elements.size() * sizeof(value_type)
+    );
+#endif
+
     return std::make_shared<VectorList>(elements);
   }
 
+  std::shared_ptr<IntList>
+  IntList::Make(container_type elements)
+  {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(
+      Kind::List,
+      sizeof(IntList) + elements.size() * sizeof(Int::value_type)
+    );
+#endif
+
+    return std::make_shared<IntList>(std::move(elements));
+  }
+
+  List::value_type
+  IntList::At(size_type index) const
+  {
+    const auto value = m_elements[index];
+
+#if defined(SNEK_ENABLE_INT_CACHE)
+    if (const auto cached = Builtins::Get().GetCachedInt(value))
+    {
+      return *cached;
+    }
+#endif
+
+    return std::make_shared<Int>(value);
+  }
+
+  std::shared_ptr<FloatList>
+  FloatList::Make(container_type elements)
+  {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(
+      Kind::List,
+      sizeof(FloatList) + elements.size() * sizeof(Float::value_type)
+    );
+#endif
+
+    return std::make_shared<FloatList>(std::move(elements));
+  }
+
+  List::value_type
+  FloatList::At(size_type index) const
+  {
+    return std::make_shared<Float>(m_elements[index]);
+  }
+
   bool
   List::Equals(const Base& that) const
   {
@@ -79,6 +79,19 @@ namespace snek::interpreter::value
   ptr
   Record::Make(const std::unordered_map<key_type, mapped_type>& fields)
   {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    std::size_t bytes = sizeof(MapRecord)
+      + fields.bucket_count() * sizeof(void*);
+
+    for (const auto& field : fields)
+    {
+      // Each field is stored in it's own node of the hash table.
+      bytes += sizeof(field) + sizeof(void*)
+        + field.first.length() * sizeof(char32_t);
+    }
+    AllocationTracker::Track(Kind::Record, bytes);
+#endif
+
     return std::make_shared<MapRecord>(fields);
   }
 
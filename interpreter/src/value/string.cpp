@@ -59,6 +59,13 @@ namespace snek::interpreter::value
   ptr
   String::Make(const std::u32string& text)
   {
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+    AllocationTracker::Track(
+      Kind::String,
+      sizeof(StringWrapper) + text.length() * sizeof(char32_t)
+    );
+#endif
+
     return std::make_shared<StringWrapper>(text);
   }
 
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <optional>
+
+#include "snek/interpreter/thread_pool.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
+
+namespace snek::interpreter
+{
+  using chunk_type = std::pair<std::size_t, std::size_t>;
+
+  struct WorkStealingPool::Job
+  {
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<chunk_type> chunks;
+    };
+
+    explicit Job(
+      const task_type& task,
+      std::size_t queue_count,
+      const std::atomic<bool>* cancelled
+    )
+      : task(task)
+      , cancelled(cancelled)
+      , queues(queue_count)
+      , remaining(0)
+      , failed(false)
+      , skipped(false) {}
+
+    /**
+     * Takes next chunk from the front of the worker's own queue, or steals
+     * one from the back of another worker's queue.
+     */
+    std::optional<chunk_type> Take(std::size_t worker)
+    {
+      const auto queue_count = queues.size();
+
+      for (std::size_t i = 0; i < queue_count; ++i)
+      {
+        auto& queue = queues[(worker + i) % queue_count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.chunks.empty())
+        {
+          chunk_type chunk;
+
+          if (i == 0)
+          {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+          } else {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+          }
+
+          return chunk;
+        }
+      }
+
+      return std::nullopt;
+    }
+
+    /**
+     * Executes chunks of the job until there are no chunks left to take.
+     */
+    void Execute(std::size_t worker)
+    {
+      while (const auto chunk = Take(worker))
+      {
+        if (cancelled && cancelled->load(std::memory_order_relaxed))
+        {
+          skipped = true;
+          failed = true;
+        }
+        if (!failed)
+        {
+          try
+          {
+            task(worker, chunk->first, chunk->second);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (!failed)
+            {
+              exception = std::current_exception();
+              failed = true;
+            }
+          }
+        }
+        if (--remaining == 0)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+
+          done.notify_all();
+        }
+      }
+    }
+
+    const task_type task;
+    const std::atomic<bool>* cancelled;
+    std::vector<Queue> queues;
+    std::atomic<std::size_t> remaining;
+    std::atomic<bool> failed;
+    std::atomic<bool> skipped;
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+
+  std::size_t
+  WorkStealingPool::DefaultSize()
+  {
+    return ThreadPool::DefaultSize() - 1;
+  }
+
+  const std::shared_ptr<WorkStealingPool>&
+  WorkStealingPool::Default()
+  {
+    static const auto pool = std::make_shared<WorkStealingPool>();
+
+    return pool;
+  }
+
+  WorkStealingPool::WorkStealingPool(std::size_t size)
+    : m_stopping(false)
+  {
+    m_workers.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      m_workers.emplace_back(&WorkStealingPool::Work, this, i);
+    }
+  }
+
+  WorkStealingPool::~WorkStealingPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+  }
+
+  void
+  WorkStealingPool::Run(
+    std::size_t count,
+    std::size_t grain_size,
+    const task_type& task,
+    const std::atomic<bool>* cancelled
+  )
+  {
+    const auto worker_count = size();
+    std::shared_ptr<Job> job;
+    std::size_t chunk_count;
+
+    if (count == 0)
+    {
+      return;
+    }
+    grain_size = std::max<std::size_t>(grain_size, 1);
+    chunk_count = (count + grain_size - 1) / grain_size;
+    job = std::make_shared<Job>(task, worker_count + 1, cancelled);
+
+    // Give each queue a contiguous block of chunks to begin with.
+    for (std::size_t i = 0; i < chunk_count; ++i)
+    {
+      const auto begin = i * grain_size;
+
+      job->queues[i * job->queues.size() / chunk_count].chunks.emplace_back(
+        begin,
+        std::min(begin + grain_size, count)
+      );
+    }
+    job->remaining = chunk_count;
+
+    if (worker_count > 0 && chunk_count > 1)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_jobs.push_back(job);
+      }
+      m_condition.notify_all();
+    }
+    job->Execute(worker_count);
+    Detach(job);
+
+    {
+      std::unique_lock<std::mutex> lock(job->mutex);
+
+      job->done.wait(lock, [&job]() { return job->remaining == 0; });
+    }
+    if (job->exception)
+    {
+      std::rethrow_exception(job->exception);
+    }
+    else if (job->skipped)
+    {
+      throw Cancelled();
+    }
+  }
+
+  void
+  WorkStealingPool::Detach(const std::shared_ptr<Job>& job)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(std::begin(m_jobs), std::end(m_jobs), job);
+
+    if (it != std::end(m_jobs))
+    {
+      m_jobs.erase(it);
+    }
+  }
+
+  void
+  WorkStealingPool::Work(std::size_t index)
+  {
+    for (;;)
+    {
+      std::shared_ptr<Job> job;
+
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(
+          lock,
+          [this]() { return m_stopping || !m_jobs.empty(); }
+        );
+        if (m_stopping)
+        {
+          return;
+        }
+        job = m_jobs.front();
+      }
+      job->Execute(index);
+      Detach(job);
+    }
+  }
+}
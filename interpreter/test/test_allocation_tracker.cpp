@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/allocation_tracker.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+#if defined(SNEK_ENABLE_ALLOCATION_TRACKING)
+TEST_CASE("Allocation tracker attributes values to source positions")
+{
+  Runtime runtime;
+  AllocationTracker tracker;
+  std::stringstream output;
+
+  REQUIRE(tracker.Start());
+  runtime.RunScript(
+    runtime.root_scope(),
+    U"let strings = []\n"
+    U"for i in range(3):\n"
+    U"  strings = [\"a\" + \"b\"]\n"
+    U"const r = { x: 1.5 }\n",
+    U"test.snek"
+  );
+  tracker.Stop();
+
+  REQUIRE(tracker.total(value::Kind::String).count >= 3);
+  REQUIRE(tracker.total(value::Kind::List).count >= 4);
+  REQUIRE(tracker.total(value::Kind::Record).count == 1);
+  REQUIRE(tracker.total(value::Kind::Float).count >= 1);
+  REQUIRE(tracker.scope_total().count >= 3);
+
+  tracker.WriteTable(output);
+  REQUIRE(output.str().find("test.snek:3:") != std::string::npos);
+  REQUIRE(output.str().find("test.snek:4:") != std::string::npos);
+}
+
+TEST_CASE("Allocation tracker ignores allocations when not running")
+{
+  Runtime runtime;
+  AllocationTracker tracker;
+
+  runtime.RunScript(runtime.root_scope(), U"[\"a\" + \"b\"]");
+
+  REQUIRE(tracker.total(value::Kind::String).count == 0);
+  REQUIRE(tracker.total(value::Kind::List).count == 0);
+}
+
+TEST_CASE("Only one allocation tracker can run in a thread")
+{
+  AllocationTracker first;
+  AllocationTracker second;
+
+  REQUIRE(first.Start());
+  REQUIRE(!second.Start());
+  first.Stop();
+  REQUIRE(second.Start());
+}
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
+
+using namespace snek::interpreter;
+
+static void
+RunLoop(Runtime& runtime)
+{
+  runtime.RunScript(
+    std::make_shared<Scope>(runtime.root_scope()),
+    U"while true:\n"
+    U"  pass\n"
+  );
+}
+
+static void
+RunParallelLoop(Runtime& runtime)
+{
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  runtime.RunScript(
+    std::make_shared<Scope>(runtime.root_scope()),
+    U"const spin = (x):\n"
+    U"  while true:\n"
+    U"    pass\n"
+    U"([0] * 5000).parallelMap(spin)\n"
+  );
+}
+
+TEST_CASE("Fuel budget aborts runaway loop")
+{
+  Runtime runtime;
+  BudgetScope budget(runtime, 1000, std::nullopt);
+
+  REQUIRE_THROWS_AS(RunLoop(runtime), Error);
+  REQUIRE(runtime.budget().fuel == 0u);
+}
+
+TEST_CASE("Fuel is consumed by loop iterations and function calls")
+{
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+
+  {
+    BudgetScope budget(runtime, 100, std::nullopt);
+
+    runtime.RunScript(
+      scope,
+      U"const f = (x) => x\n"
+      U"for i in range(10):\n"
+      U"  f(i)\n"
+    );
+    // Ten iterations, ten calls to `f' and one call to `range'.
+    REQUIRE(runtime.budget().fuel == 79u);
+  }
+  REQUIRE(!runtime.budget().fuel);
+}
+
+TEST_CASE("Deadline aborts runaway loop")
+{
+  Runtime runtime;
+  BudgetScope budget(
+    runtime,
+    std::nullopt,
+    std::chrono::milliseconds(20)
+  );
+
+  REQUIRE_THROWS_AS(RunLoop(runtime), Error);
+}
+
+TEST_CASE("Runaway loop can be interrupted from another thread")
+{
+  Runtime runtime;
+  std::thread interrupter([&runtime]()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    runtime.Interrupt();
+  });
+
+  REQUIRE_THROWS_AS(RunLoop(runtime), Error);
+  interrupter.join();
+
+  // Interrupt is cleared once it has been handled.
+  REQUIRE(runtime.RunScript(runtime.root_scope(), U"1 + 2"));
+}
+
+TEST_CASE("Nested budget scope cannot exceed the enclosing one")
+{
+  Runtime runtime;
+  BudgetScope outer(runtime, 10, std::nullopt);
+
+  {
+    BudgetScope inner(runtime, 1000, std::nullopt);
+
+    REQUIRE(runtime.budget().fuel == 10u);
+    runtime.Checkpoint();
+    runtime.Checkpoint();
+  }
+  REQUIRE(runtime.budget().fuel == 8u);
+}
+
+TEST_CASE("Parallel operation can be interrupted from another thread")
+{
+  Runtime runtime;
+  std::thread interrupter([&runtime]()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    runtime.Interrupt();
+  });
+
+  // Worker threads have to be interrupted as well, or this never returns.
+  REQUIRE_THROWS_AS(RunParallelLoop(runtime), Error);
+  interrupter.join();
+  REQUIRE(runtime.RunScript(runtime.root_scope(), U"1 + 2"));
+}
+
+TEST_CASE("Budget applies to parallel operations")
+{
+  Runtime runtime;
+
+  {
+    BudgetScope budget(
+      runtime,
+      std::nullopt,
+      std::chrono::milliseconds(20)
+    );
+
+    REQUIRE_THROWS_AS(RunParallelLoop(runtime), Error);
+  }
+  {
+    BudgetScope budget(runtime, 1000, std::nullopt);
+
+    REQUIRE_THROWS_AS(RunParallelLoop(runtime), Error);
+    REQUIRE(runtime.budget().fuel == 0u);
+  }
+}
+
+TEST_CASE("Fuel consumed by worker threads is charged from the runtime")
+{
+  Runtime runtime;
+  BudgetScope budget(runtime, 100000, std::nullopt);
+
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  runtime.RunScript(
+    runtime.root_scope(),
+    U"([0] * 5000).parallelMap((x) => x)"
+  );
+  // At least one checkpoint for each call to the callback, regardless of
+  // the thread it was called from.
+  REQUIRE(runtime.budget().fuel <= 95000u);
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+static value::ptr
+Run(Runtime& runtime, const std::u32string& source)
+{
+  return runtime.RunScript(runtime.root_scope(), source);
+}
+
+static bool
+RunEquals(
+  Runtime& runtime,
+  const std::u32string& source,
+  const std::u32string& expected
+)
+{
+  return value::Equals(Run(runtime, source), Run(runtime, expected));
+}
+
+TEST_CASE("For loop iterates over list elements")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let a = []\n"
+    U"for x in [1, 2.5, \"c\"]:\n"
+    U"  a = [...a, x]\n"
+    U"a\n",
+    U"[1, 2.5, \"c\"]"
+  ));
+}
+
+TEST_CASE("For loop iterates over string characters and record keys")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let s = []\n"
+    U"for c in \"abc\":\n"
+    U"  s = [c, ...s]\n"
+    U"s\n",
+    U"[\"c\", \"b\", \"a\"]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"let k = 0\n"
+    U"for key in { a: 1, bb: 2 }:\n"
+    U"  k += key.length()\n"
+    U"k\n",
+    U"3"
+  ));
+}
+
+TEST_CASE("For loop supports destructuring, break and continue")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let total = 0\n"
+    U"for [a, b] in [[1, 2], [3, 4], [5, 6], [7, 8]]:\n"
+    U"  if a == 3:\n"
+    U"    continue\n"
+    U"  if a == 7:\n"
+    U"    break\n"
+    U"  total += a * b\n"
+    U"total\n",
+    U"32"
+  ));
+}
+
+TEST_CASE("For loop rejects values which are not iterable")
+{
+  Runtime runtime;
+
+  REQUIRE_THROWS_AS(Run(runtime, U"for x in 5:\n  pass\n"), Error);
+}
+
+TEST_CASE("Range computes its elements")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(runtime, U"range(4)", U"[0, 1, 2, 3]"));
+  REQUIRE(RunEquals(runtime, U"range(2, 5)", U"[2, 3, 4]"));
+  REQUIRE(RunEquals(runtime, U"range(0, 10, 3)", U"[0, 3, 6, 9]"));
+  REQUIRE(RunEquals(runtime, U"range(5, 0, -2)", U"[5, 3, 1]"));
+  REQUIRE(RunEquals(runtime, U"range(5, 5)", U"[]"));
+  REQUIRE(RunEquals(runtime, U"range(5, 0)", U"[]"));
+  REQUIRE(RunEquals(
+    runtime,
+    U"range(-9223372036854775807 - 1, 9223372036854775807, "
+    U"9223372036854775807).size()",
+    U"3"
+  ));
+  REQUIRE_THROWS_AS(Run(runtime, U"range(0, 5, 0)"), Error);
+}
+
+TEST_CASE("Iterating huge range does not materialize it")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let n = 0\n"
+    U"for i in range(10000000000000):\n"
+    U"  n += i\n"
+    U"  if i == 1000:\n"
+    U"    break\n"
+    U"n\n",
+    U"500500"
+  ));
+}
+
+TEST_CASE("For loop streams lazy sequences")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let result = []\n"
+    U"for x in range(100).lazy().filter((x) => x % 2 == 1).map((x) => x * x):\n"
+    U"  if x > 50:\n"
+    U"    break\n"
+    U"  result = [...result, x]\n"
+    U"result\n",
+    U"[1, 9, 25, 49]"
+  ));
+}
+
+TEST_CASE("Read lines from file")
+{
+  const char* filename = "test_for_read_lines.txt";
+  const std::string long_line(100000, 'x');
+  Runtime runtime;
+
+  {
+    std::ofstream file(filename, std::ios_base::out | std::ios_base::binary);
+
+    file << "first\r\n\n\xc3\xa4iti\n" << long_line << "\nlast";
+  }
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"readLines(\"test_for_read_lines.txt\").map((l) => l.length()).toList()",
+    U"[5, 0, 4, 100000, 4]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"let lines = []\n"
+    U"for line in readLines(\"test_for_read_lines.txt\").take(3):\n"
+    U"  lines = [...lines, line]\n"
+    U"lines\n",
+    U"[\"first\", \"\", \"\u00e4iti\"]"
+  ));
+  REQUIRE_THROWS_AS(
+    Run(runtime, U"readLines(\"does-not-exist.txt\").toList()"),
+    Error
+  );
+
+  std::remove(filename);
+}
+
+TEST_CASE("Sequences of standard input share buffered input")
+{
+  std::istringstream input("header\n1\n2\n3\n");
+  const auto previous = std::cin.rdbuf(input.rdbuf());
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"readLines().take(1).toList()",
+    U"[\"header\"]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"readLines().toList()",
+    U"[\"1\", \"2\", \"3\"]"
+  ));
+  std::cin.rdbuf(previous);
+}
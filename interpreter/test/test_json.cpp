@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <clocale>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+static value::ptr
+Run(Runtime& runtime, const std::u32string& source)
+{
+  return runtime.RunScript(runtime.root_scope(), source);
+}
+
+static bool
+RunEquals(
+  Runtime& runtime,
+  const std::u32string& source,
+  const std::u32string& expected
+)
+{
+  return value::Equals(Run(runtime, source), Run(runtime, expected));
+}
+
+TEST_CASE("Parse JSON values")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"null\")", U"null"));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\" true \")", U"true"));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"false\")", U"false"));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"-42\")", U"-42"));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"1.5e2\")", U"150.0"));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"0.25\")", U"0.25"));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"-9223372036854775808\")",
+    U"-9223372036854775807 - 1"
+  ));
+  REQUIRE(value::IsFloat(
+    Run(runtime, U"JSON.parse(\"18446744073709551616\")")
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"[1, 2.5, \\\"a\\\", [], {}]\")",
+    U"[1, 2.5, \"a\", [], {}]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"{\\\"a\\\": {\\\"b\\\": [true, null]}, \\\"c\\\": 1}\")",
+    U"{ a: { b: [true, null] }, c: 1 }"
+  ));
+}
+
+TEST_CASE("Parse JSON strings")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"\\\"abcdefghijklmnopqrstuvwxyz0123456789\\\"\").length()",
+    U"36"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"\\\"a\\\\nb\\\\t\\\\\\\"\\\\u00e4\\\\ud83d\\\\ude00\\\"\")",
+    U"\"a\\nb\\t\\\"ä\U0001F600\""
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(\"\\\"äiti ja € and some more text\\\"\")",
+    U"\"äiti ja € and some more text\""
+  ));
+}
+
+TEST_CASE("Reject invalid JSON")
+{
+  Runtime runtime;
+  const char32_t* inputs[] =
+  {
+    U"JSON.parse(\"\")",
+    U"JSON.parse(\"[1, 2\")",
+    U"JSON.parse(\"[1,]\")",
+    U"JSON.parse(\"{\\\"a\\\" 1}\")",
+    U"JSON.parse(\"{a: 1}\")",
+    U"JSON.parse(\"01\")",
+    U"JSON.parse(\"1.\")",
+    U"JSON.parse(\"tru\")",
+    U"JSON.parse(\"\\\"abc\")",
+    U"JSON.parse(\"\\\"\\\\x\\\"\")",
+    U"JSON.parse(\"\\\"\\\\ud800\\\"\")",
+    U"JSON.parse(\"1 2\")",
+    U"JSON.parse(\"[\" * 1000 + \"]\" * 1000)",
+  };
+
+  for (const auto input : inputs)
+  {
+    REQUIRE_THROWS_AS(Run(runtime, input), Error);
+  }
+}
+
+TEST_CASE("Stringify values as JSON")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(null)", U"\"null\""));
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(true)", U"\"true\""));
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(-15)", U"\"-15\""));
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(2.0)", U"\"2.0\""));
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(0.1)", U"\"0.1\""));
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(1.0 / 0.0)", U"\"null\""));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.stringify([1, \"a\\n\\\"ä\", [], { x: [null] }])",
+    U"\"[1,\\\"a\\\\n\\\\\\\"ä\\\",[],{\\\"x\\\":[null]}]\""
+  ));
+  REQUIRE_THROWS_AS(Run(runtime, U"JSON.stringify([() => 1])"), Error);
+}
+
+TEST_CASE("Reject values nested too deeply for JSON")
+{
+  Runtime runtime;
+
+  Run(
+    runtime,
+    U"let value = []\n"
+    U"let i = 0\n"
+    U"while i < 1000:\n"
+    U"  value = [value]\n"
+    U"  i = i + 1\n"
+  );
+
+  REQUIRE_THROWS_AS(Run(runtime, U"JSON.stringify(value)"), Error);
+}
+
+TEST_CASE("Floats round trip through JSON in any locale")
+{
+  Runtime runtime;
+  const auto previous = std::string(std::setlocale(LC_NUMERIC, nullptr));
+
+  // Decimal separator of these is a comma. Not every system has them.
+  for (const auto name : { "de_DE.UTF-8", "fi_FI.UTF-8", "fr_FR.UTF-8" })
+  {
+    if (std::setlocale(LC_NUMERIC, name))
+    {
+      break;
+    }
+  }
+  REQUIRE(RunEquals(runtime, U"JSON.stringify(0.5)", U"\"0.5\""));
+  REQUIRE(RunEquals(runtime, U"JSON.parse(\"2.5e-1\")", U"0.25"));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.stringify(0.1 + 0.2)",
+    U"\"0.30000000000000004\""
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(JSON.stringify(5e-324))",
+    U"5e-324"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.stringify(JSON.parse(\"-1e400\"))",
+    U"\"null\""
+  ));
+  std::setlocale(LC_NUMERIC, previous.c_str());
+}
+
+TEST_CASE("JSON round trip")
+{
+  Runtime runtime;
+
+  Run(
+    runtime,
+    U"const data = {\n"
+    U"  name: \"snék\",\n"
+    U"  values: [1, -2, 3.25, 1e100, true, false, null],\n"
+    U"  nested: { list: [[1], [2, [3]]], empty: {} },\n"
+    U"}\n"
+  );
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"JSON.parse(JSON.stringify(data))",
+    U"data"
+  ));
+}
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
+
+using namespace snek::interpreter;
+
+static value::ptr
+Run(Runtime& runtime, const std::u32string& source)
+{
+  return runtime.RunScript(runtime.root_scope(), source);
+}
+
+static bool
+RunEquals(
+  Runtime& runtime,
+  const std::u32string& source,
+  const std::u32string& expected
+)
+{
+  return value::Equals(Run(runtime, source), Run(runtime, expected));
+}
+
+TEST_CASE("Parallel list operations match sequential ones")
+{
+  Runtime runtime;
+
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  Run(runtime, U"let list = ([0] * 10000).map((x, i) => i)");
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelMap((x, i) => x * 2 + i)",
+    U"list.map((x, i) => x * 2 + i)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelFilter((x) => x % 3 == 0)",
+    U"list.filter((x) => x % 3 == 0)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelReduce((a, b) => a + b)",
+    U"list.reduce((a, b) => a + b)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelReduce((a, b) => a + b, 5)",
+    U"list.reduce((a, b) => a + b, 5)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelMap((x) => x.toString())"
+    U".parallelFilter((x) => x.length() == 3)",
+    U"list.map((x) => x.toString()).filter((x) => x.length() == 3)"
+  ));
+}
+
+TEST_CASE("Errors in parallel callbacks are propagated")
+{
+  Runtime runtime;
+
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  Run(runtime, U"let list = ([0] * 5000).map((x, i) => i)");
+  REQUIRE_THROWS_AS(
+    Run(runtime, U"list.parallelMap((x) => x == 4000 ? x.foo() : x)"),
+    Error
+  );
+}
+
+TEST_CASE("Parallel callbacks cannot assign captured variables")
+{
+  Runtime runtime;
+
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  Run(runtime, U"let list = ([0] * 5000).map((x, i) => i)");
+  Run(runtime, U"let total = 0");
+  REQUIRE_THROWS_AS(
+    Run(runtime, U"list.parallelMap((x) => total = total + x)"),
+    Error
+  );
+  REQUIRE_THROWS_AS(
+    Run(runtime, U"list.parallelFilter((x) => total = x)"),
+    Error
+  );
+  REQUIRE(RunEquals(runtime, U"total", U"0"));
+
+  // Variables of the callback itself can still be assigned.
+  REQUIRE(RunEquals(
+    runtime,
+    U"list.parallelMap((x) => x = x + total + 1)",
+    U"list.map((x) => x + 1)"
+  ));
+
+  // Captured variables are writable again once the operation has finished.
+  Run(runtime, U"total = list.parallelReduce((a, b) => a + b)");
+  REQUIRE(RunEquals(runtime, U"total", U"list.reduce((a, b) => a + b)"));
+}
+
+TEST_CASE("Lists can be sorted")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(runtime, U"[3, 1, 2].sort()", U"[1, 2, 3]"));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[2.5, -1.0, 2.0].sort()",
+    U"[-1.0, 2.0, 2.5]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[\"b\", \"c\", \"a\"].sort()",
+    U"[\"a\", \"b\", \"c\"]"
+  ));
+  REQUIRE(RunEquals(runtime, U"[3, 1.5, 2].sort()", U"[1.5, 2, 3]"));
+  REQUIRE(RunEquals(runtime, U"[].sort()", U"[]"));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[1, 3, 2].sort((a, b) => b - a)",
+    U"[3, 2, 1]"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[[2, \"a\"], [1, \"b\"], [2, \"c\"], [1, \"d\"]].sortBy((x) => x[0])",
+    U"[[1, \"b\"], [1, \"d\"], [2, \"a\"], [2, \"c\"]]"
+  ));
+  REQUIRE_THROWS_AS(Run(runtime, U"[1, 2].sort((a, b) => \"\")"), Error);
+}
+
+TEST_CASE("Lists of numbers are stored unboxed")
+{
+  Runtime runtime;
+  const auto unboxed_kind = [&runtime](const std::u32string& source)
+  {
+    return static_cast<const value::List*>(
+      Run(runtime, source).get()
+    )->GetUnboxedKind();
+  };
+
+  REQUIRE(unboxed_kind(U"[1, 2, 3]") == value::Kind::Int);
+  REQUIRE(unboxed_kind(U"[1.5, 2.5]") == value::Kind::Float);
+  REQUIRE(unboxed_kind(U"[1, 2.5]") == std::nullopt);
+  REQUIRE(unboxed_kind(U"[\"a\"]") == std::nullopt);
+  REQUIRE(unboxed_kind(U"[1.5].map((x) => x.round())") == value::Kind::Int);
+  REQUIRE(RunEquals(runtime, U"[1, 2, 3]", U"[1, 2, 3].map((x) => x)"));
+  REQUIRE(RunEquals(runtime, U"[1, 2, 3][1]", U"2"));
+  REQUIRE(RunEquals(runtime, U"[3, 1, 2].sort()", U"[1, 2, 3]"));
+}
+
+TEST_CASE("Numeric list operations")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(runtime, U"[1, 2, 3, 4, 5].sum()", U"15"));
+  REQUIRE(RunEquals(runtime, U"[1.5, 2.5].sum()", U"4.0"));
+  REQUIRE(RunEquals(runtime, U"[1, 2.5].sum()", U"3.5"));
+  REQUIRE(RunEquals(runtime, U"[].sum()", U"0"));
+  REQUIRE(RunEquals(runtime, U"[3, -1, 2].min()", U"-1"));
+  REQUIRE(RunEquals(runtime, U"[3, -1, 2].max()", U"3"));
+  REQUIRE(RunEquals(runtime, U"[1.5, 0.5].min()", U"0.5"));
+  REQUIRE(RunEquals(runtime, U"[].max()", U"null"));
+  REQUIRE(RunEquals(runtime, U"[1, 2, 3, 4].mean()", U"2.5"));
+  REQUIRE(RunEquals(runtime, U"[].mean()", U"null"));
+  REQUIRE(RunEquals(runtime, U"[1, 2, 3].dot([4, 5, 6])", U"32"));
+  REQUIRE(RunEquals(runtime, U"[1, 2].dot([0.5, 0.5])", U"1.5"));
+  REQUIRE(value::IsInt(Run(runtime, U"[4611686018427387904, 1].sum()")));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[4611686018427387904, 1].sum()",
+    U"4611686018427387905"
+  ));
+  // Overflow is handled like it is with the operators.
+  REQUIRE(RunEquals(
+    runtime,
+    U"[4611686018427387904, 4611686018427387904].sum()",
+    U"4611686018427387904 + 4611686018427387904"
+  ));
+  REQUIRE(value::IsFloat(Run(
+    runtime,
+    U"[9223372036854775807, 9223372036854775807, 5].sum()"
+  )));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[9223372036854775807, 9223372036854775807, 5].sum()",
+    U"[9223372036854775807, 9223372036854775807, 5].reduce("
+    U"(a, b) => a + b)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[9223372036854775807, 1, -1].sum()",
+    U"9223372036854775807"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[4611686018427387904, 3].dot([2, 5])",
+    U"4611686018427387904 * 2 + 3 * 5"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"[4611686018427387904, 3].dot([4, 5])",
+    U"4611686018427387904 * 4 + 3 * 5"
+  ));
+  REQUIRE(RunEquals(runtime, U"range(1, 101).sum()", U"5050"));
+  REQUIRE(RunEquals(runtime, U"range(10, 0, -3).max()", U"10"));
+  REQUIRE(RunEquals(runtime, U"range(3).dot(range(1, 4))", U"8"));
+  REQUIRE_THROWS_AS(Run(runtime, U"[1, \"a\"].sum()"), Error);
+  REQUIRE_THROWS_AS(Run(runtime, U"[1, 2].dot([1])"), Error);
+}
+
+TEST_CASE("Lazy sequences match eager list operations")
+{
+  Runtime runtime;
+
+  Run(runtime, U"const xs = ([0] * 100).map((x, i) => i)");
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"xs.lazy().map((x) => x * 3).filter((x, i) => i % 2 == 0)"
+    U".map((x, i) => x + i).skip(5).take(10).toList()",
+    U"xs.map((x) => x * 3).filter((x, i) => i % 2 == 0)"
+    U".map((x, i) => x + i).filter((x, i) => i >= 5).filter((x, i) => i < 10)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"xs.lazy().filter((x) => x % 7 == 0).reduce((a, b) => a + b)",
+    U"xs.filter((x) => x % 7 == 0).reduce((a, b) => a + b)"
+  ));
+  REQUIRE(RunEquals(
+    runtime,
+    U"xs.lazy().reduce((a, b, i) => a + i, 0)",
+    U"4950"
+  ));
+  REQUIRE(RunEquals(runtime, U"xs.lazy().take(0).toList()", U"[]"));
+  REQUIRE(RunEquals(runtime, U"xs.lazy().skip(500).toList()", U"[]"));
+  REQUIRE(RunEquals(runtime, U"[].lazy().reduce((a, b) => a + b)", U"null"));
+  REQUIRE_THROWS_AS(Run(runtime, U"xs.lazy().take(-1)"), Error);
+}
+
+TEST_CASE("Lazy sequences share one prototype")
+{
+  Runtime runtime;
+  const auto& prototype = runtime.sequence_prototype();
+  const auto map = std::static_pointer_cast<value::Function>(
+    *std::static_pointer_cast<value::Record>(prototype)->GetOwnProperty(
+      U"map"
+    )
+  );
+
+  REQUIRE(value::GetPrototypeOf(runtime, Run(runtime, U"[1].lazy()")) ==
+    prototype);
+  REQUIRE(value::GetPrototypeOf(
+    runtime,
+    Run(runtime, U"[1].lazy().map((x) => x).take(1)")
+  ) == prototype);
+
+  // Methods of the prototype cannot be used with other records.
+  REQUIRE_THROWS_AS(
+    value::Function::Call(
+      runtime,
+      map,
+      {
+        value::Record::Make({}),
+        Run(runtime, U"(x) => x"),
+      }
+    ),
+    Error
+  );
+}
+
+TEST_CASE("Lazy sequence stops consuming source after take")
+{
+  Runtime runtime;
+
+  REQUIRE(RunEquals(
+    runtime,
+    U"let calls = 0\n"
+    U"const square = (x):\n"
+    U"  calls += 1\n"
+    U"  return x * x\n"
+    U"range(1000000000000).lazy().map(square).take(3).toList()\n",
+    U"[0, 1, 4]"
+  ));
+  REQUIRE(RunEquals(runtime, U"calls", U"3"));
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/interpreter/module.hpp"
+#include "snek/interpreter/runtime.hpp"
+#include "snek/parser/serialize.hpp"
+
+using namespace snek::interpreter;
+
+#if defined(SNEK_ENABLE_MODULE_CACHE)
+namespace
+{
+  /**
+   * Size of the header of compiled module files, which must be kept in sync
+   * with the one in module.cpp.
+   */
+  static constexpr std::size_t kHeaderSize = 32;
+
+  class TemporaryModule final
+  {
+  public:
+    explicit TemporaryModule()
+      : m_directory(
+          std::filesystem::temp_directory_path() /
+          ("snek-test-module-" + std::to_string(std::random_device()()))
+        )
+      , m_path((m_directory / "module.snek").string())
+    {
+      std::filesystem::create_directories(m_directory);
+    }
+
+    ~TemporaryModule()
+    {
+      std::error_code ec;
+
+      std::filesystem::remove_all(m_directory, ec);
+    }
+
+    inline const std::string& path() const
+    {
+      return m_path;
+    }
+
+    inline std::string compiled_path() const
+    {
+      return m_path + "c";
+    }
+
+    void Write(const std::string& source) const
+    {
+      std::ofstream(m_path, std::ios_base::binary) << source;
+    }
+
+    std::string ReadCompiled() const
+    {
+      std::ifstream ifs(compiled_path(), std::ios_base::binary);
+
+      return std::string(
+        std::istreambuf_iterator<char>(ifs),
+        std::istreambuf_iterator<char>()
+      );
+    }
+
+    void WriteCompiled(const std::string& data) const
+    {
+      std::ofstream(compiled_path(), std::ios_base::binary) << data;
+    }
+
+    /**
+     * Replaces syntax tree stored in the compiled module file while keeping
+     * it's header intact.
+     */
+    void ReplaceCompiledTree(const std::string& tree) const
+    {
+      WriteCompiled(ReadCompiled().substr(0, kHeaderSize) + tree);
+    }
+
+    std::u32string Load() const
+    {
+      const auto module = LoadFilesystemModule(
+        peelo::unicode::encoding::utf8::decode(m_path)
+      );
+
+      std::u32string result;
+
+      REQUIRE(module.statements);
+      for (const auto& statement : *module.statements)
+      {
+        if (!result.empty())
+        {
+          result.append(1, U'\n');
+        }
+        result.append(statement->ToString());
+      }
+
+      return result;
+    }
+
+  private:
+    const std::filesystem::path m_directory;
+    const std::string m_path;
+  };
+
+  static std::string
+  Compile(const std::string& source)
+  {
+    snek::parser::Lexer lexer(source);
+    std::vector<snek::parser::statement::ptr> statements;
+    std::string output;
+
+    while (!lexer.PeekToken(snek::parser::Token::Kind::Eof))
+    {
+      statements.push_back(snek::parser::statement::Parse(lexer, true));
+    }
+    snek::parser::serialize::Serialize(statements, output);
+
+    return output;
+  }
+}
+
+TEST_CASE("Compiled module is written and used")
+{
+  TemporaryModule module;
+
+  module.Write("let a = 1");
+  REQUIRE(module.Load() == U"let a = 1");
+  REQUIRE(std::filesystem::exists(module.compiled_path()));
+
+  // Syntax tree in the compiled module is used as long as the source file
+  // has not changed.
+  module.ReplaceCompiledTree(Compile("let z = 9"));
+  REQUIRE(module.Load() == U"let z = 9");
+}
+
+TEST_CASE("Imported module is loaded from the compiled module")
+{
+  TemporaryModule module;
+  const auto path = peelo::unicode::encoding::utf8::decode(module.path());
+  value::ptr a;
+
+  module.Write("export const a = 1");
+  Runtime().ImportModule(path);
+  REQUIRE(std::filesystem::exists(module.compiled_path()));
+
+  // Another runtime importing the same module uses the compiled module
+  // written by the first one.
+  module.ReplaceCompiledTree(Compile("export const a = 2"));
+  REQUIRE(Runtime().ImportModule(path)->FindVariable(U"a", a, true));
+  REQUIRE(value::ToString(a) == U"2");
+}
+
+TEST_CASE("Compiled module is invalidated when the source changes")
+{
+  TemporaryModule module;
+
+  module.Write("let a = 1");
+  module.Load();
+
+  // Different size.
+  module.Write("let a = 10");
+  REQUIRE(module.Load() == U"let a = 10");
+
+  // Same size, different contents and modification time.
+  module.Write("let b = 20");
+  std::filesystem::last_write_time(
+    module.path(),
+    std::filesystem::last_write_time(module.path()) + std::chrono::hours(1)
+  );
+  REQUIRE(module.Load() == U"let b = 20");
+}
+
+TEST_CASE("Touched source file revalidates the compiled module")
+{
+  TemporaryModule module;
+
+  module.Write("let a = 1");
+  module.Load();
+
+  // Touching the source without changing it keeps the compiled module, but
+  // rewrites it's header with the new modification time.
+  module.ReplaceCompiledTree(Compile("let z = 9"));
+  const auto header = module.ReadCompiled().substr(0, kHeaderSize);
+  std::filesystem::last_write_time(
+    module.path(),
+    std::filesystem::last_write_time(module.path()) + std::chrono::hours(1)
+  );
+  REQUIRE(module.Load() == U"let z = 9");
+  REQUIRE(module.ReadCompiled().substr(0, kHeaderSize) != header);
+  REQUIRE(module.ReadCompiled().substr(kHeaderSize) == Compile("let z = 9"));
+  REQUIRE(module.Load() == U"let z = 9");
+}
+
+TEST_CASE("Corrupt compiled module falls back to the source")
+{
+  TemporaryModule module;
+
+  module.Write("let a = 1");
+  module.Load();
+
+  // Expression statement without an expression.
+  module.ReplaceCompiledTree(
+    std::string{
+      1,
+      static_cast<char>(
+        static_cast<int>(snek::parser::statement::Kind::Expression) + 1
+      ),
+      0,
+      0
+    }
+  );
+  REQUIRE(module.Load() == U"let a = 1");
+  REQUIRE(module.ReadCompiled().substr(kHeaderSize) == Compile("let a = 1"));
+
+  // Truncated file.
+  module.WriteCompiled(module.ReadCompiled().substr(0, kHeaderSize + 2));
+  REQUIRE(module.Load() == U"let a = 1");
+
+  // Garbage.
+  module.WriteCompiled(std::string(100, '\xff'));
+  REQUIRE(module.Load() == U"let a = 1");
+}
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/native.hpp"
+
+using namespace snek::interpreter;
+
+static std::int64_t
+Add(std::int64_t a, std::int64_t b)
+{
+  return a + b;
+}
+
+static std::u32string
+Repeat(Runtime& runtime, const std::u32string& text, std::int64_t count)
+{
+  std::u32string result;
+
+  if (count < 0)
+  {
+    throw runtime.MakeError(U"Negative count.");
+  }
+  for (std::int64_t i = 0; i < count; ++i)
+  {
+    result.append(text);
+  }
+
+  return result;
+}
+
+static std::optional<double>
+Half(std::optional<double> value)
+{
+  if (!value)
+  {
+    return std::nullopt;
+  }
+
+  return *value / 2;
+}
+
+static bool s_called = false;
+
+static void
+Touch()
+{
+  s_called = true;
+}
+
+static value::ptr
+Call(
+  Runtime& runtime,
+  const value::ptr& function,
+  const std::vector<value::ptr>& arguments
+)
+{
+  return value::Function::Call(
+    runtime,
+    std::static_pointer_cast<value::Function>(function),
+    arguments
+  );
+}
+
+TEST_CASE("Parameter types are derived from the C++ function")
+{
+  Runtime runtime;
+  const auto function = native::Bind<Repeat>(
+    &runtime.builtins(),
+    { { U"text" }, { U"count" } }
+  );
+  const auto& parameters = function->parameters();
+
+  REQUIRE(parameters.size() == 2);
+  REQUIRE(parameters[0].name == U"text");
+  REQUIRE(parameters[0].type == runtime.string_type());
+  REQUIRE(parameters[1].name == U"count");
+  REQUIRE(parameters[1].type == runtime.int_type());
+  REQUIRE(function->return_type() == runtime.string_type());
+  REQUIRE(native::Bind<Touch>(&runtime.builtins())->return_type() ==
+    runtime.void_type());
+}
+
+TEST_CASE("Bound function converts arguments and return value")
+{
+  Runtime runtime;
+  const auto add = native::Bind<Add>(
+    &runtime.builtins(),
+    { { U"a" }, { U"b" } }
+  );
+  const auto repeat = native::Bind<Repeat>(
+    &runtime.builtins(),
+    { { U"text" }, { U"count" } }
+  );
+  const auto result = Call(
+    runtime,
+    add,
+    { runtime.MakeInt(2), runtime.MakeInt(3) }
+  );
+
+  REQUIRE(value::IsInt(result));
+  REQUIRE(std::static_pointer_cast<value::Int>(result)->value == 5);
+  REQUIRE(value::ToString(Call(
+    runtime,
+    repeat,
+    { value::String::Make(U"ab"), runtime.MakeInt(2) }
+  )) == U"abab");
+  REQUIRE_THROWS_AS(
+    Call(
+      runtime,
+      repeat,
+      { value::String::Make(U"ab"), runtime.MakeInt(-1) }
+    ),
+    Error
+  );
+}
+
+TEST_CASE("Bound function checks types of the arguments")
+{
+  Runtime runtime;
+  const auto add = native::Bind<Add>(
+    &runtime.builtins(),
+    { { U"a" }, { U"b" } }
+  );
+
+  REQUIRE_THROWS_AS(
+    Call(runtime, add, { runtime.MakeInt(1), value::String::Make(U"2") }),
+    Error
+  );
+  REQUIRE_THROWS_AS(Call(runtime, add, { runtime.MakeInt(1) }), Error);
+}
+
+TEST_CASE("Bound function evaluates default values")
+{
+  Runtime runtime;
+  const auto add = native::Bind<Add>(
+    &runtime.builtins(),
+    {
+      { U"a" },
+      {
+        U"b",
+        std::make_shared<snek::parser::expression::Int>(std::nullopt, 10)
+      },
+    }
+  );
+  const auto result = Call(runtime, add, { runtime.MakeInt(1) });
+
+  REQUIRE(std::static_pointer_cast<value::Int>(result)->value == 11);
+}
+
+TEST_CASE("Optional parameters of bound function accept null")
+{
+  Runtime runtime;
+  const auto half = native::Bind<Half>(
+    &runtime.builtins(),
+    { { U"value" } }
+  );
+  const auto result = Call(runtime, half, { runtime.MakeInt(3) });
+
+  REQUIRE(value::IsFloat(result));
+  REQUIRE(std::static_pointer_cast<value::Float>(result)->value == 1.5);
+  REQUIRE(value::IsNull(Call(runtime, half, { nullptr })));
+}
+
+TEST_CASE("Bound function without return value returns null")
+{
+  Runtime runtime;
+  const auto touch = native::Bind<Touch>(&runtime.builtins());
+
+  s_called = false;
+  REQUIRE(value::IsNull(Call(runtime, touch, {})));
+  REQUIRE(s_called);
+}
+
+TEST_CASE("Bound function can be called from script")
+{
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+
+  scope->DeclareVariable(
+    U"add",
+    native::Bind<Add>(&runtime.builtins(), { { U"a" }, { U"b" } })
+  );
+  REQUIRE(value::ToString(runtime.RunScript(scope, U"add(4, 5)")) == U"9");
+  REQUIRE(value::ToString(
+    runtime.RunScript(scope, U"Int.parse(\"ff\", 16) + 2.5.floor()")
+  ) == U"257");
+}
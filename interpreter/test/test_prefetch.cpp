@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <random>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/interpreter/module.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+#if defined(SNEK_ENABLE_MODULE_PREFETCH)
+namespace
+{
+  class TemporaryDirectory final
+  {
+  public:
+    explicit TemporaryDirectory()
+      : m_path(
+          std::filesystem::temp_directory_path() /
+          ("snek-test-prefetch-" + std::to_string(std::random_device()()))
+        )
+    {
+      std::filesystem::create_directories(m_path);
+    }
+
+    ~TemporaryDirectory()
+    {
+      std::error_code ec;
+
+      std::filesystem::remove_all(m_path, ec);
+    }
+
+    std::u32string Path(const std::string& name) const
+    {
+      return peelo::unicode::encoding::utf8::decode((m_path / name).string());
+    }
+
+    std::u32string Write(
+      const std::string& name,
+      const std::string& source
+    ) const
+    {
+      std::ofstream((m_path / name).string(), std::ios_base::binary) << source;
+
+      return Path(name);
+    }
+
+    bool IsCompiled(const std::string& name) const
+    {
+      return std::filesystem::exists((m_path / (name + "c")).string());
+    }
+
+  private:
+    const std::filesystem::path m_path;
+  };
+
+  /**
+   * Waits until the single worker of given pool has finished all tasks that
+   * have been submitted to it so far.
+   */
+  static void
+  Drain(ThreadPool& pool)
+  {
+    std::promise<void> promise;
+
+    pool.Submit([&promise]() { promise.set_value(); });
+    promise.get_future().wait();
+  }
+
+  static std::u32string
+  ToString(const LoadedModule& module)
+  {
+    std::u32string result;
+
+    REQUIRE(module.statements);
+    for (const auto& statement : *module.statements)
+    {
+      if (!result.empty())
+      {
+        result.append(1, U'\n');
+      }
+      result.append(statement->ToString());
+    }
+
+    return result;
+  }
+
+  static std::string
+  MakeImport(const std::u32string& path)
+  {
+    return
+      "import * as m from \"" +
+      peelo::unicode::encoding::utf8::encode(path) +
+      "\"\n";
+  }
+}
+
+TEST_CASE("Prefetched modules can be loaded in any order")
+{
+  TemporaryDirectory directory;
+  ThreadPool pool(1);
+  ModulePrefetcher prefetcher(pool);
+  const auto c = directory.Write("c.snek", "let c = 3");
+  const auto b = directory.Write("b.snek", MakeImport(c) + "let b = 2");
+  const auto a = directory.Write("a.snek", MakeImport(b) + "let a = 1");
+
+  // Each module schedules the modules it imports once it has been loaded, so
+  // the whole chain has been loaded after draining the pool once per module.
+  prefetcher.Prefetch(a);
+  Drain(pool);
+  Drain(pool);
+  Drain(pool);
+
+  // Nothing is written for modules which have not been imported yet.
+  REQUIRE(!directory.IsCompiled("a.snek"));
+  REQUIRE(!directory.IsCompiled("b.snek"));
+  REQUIRE(!directory.IsCompiled("c.snek"));
+
+  REQUIRE(ToString(prefetcher.Load(c)) == U"let c = 3");
+  REQUIRE(ToString(prefetcher.Load(a)).find(U"let a = 1") != std::u32string::npos);
+  REQUIRE(ToString(prefetcher.Load(b)).find(U"let b = 2") != std::u32string::npos);
+#if defined(SNEK_ENABLE_MODULE_CACHE)
+  REQUIRE(directory.IsCompiled("a.snek"));
+  REQUIRE(directory.IsCompiled("b.snek"));
+  REQUIRE(directory.IsCompiled("c.snek"));
+#endif
+}
+
+TEST_CASE("Modules which have not been prefetched are loaded directly")
+{
+  TemporaryDirectory directory;
+  ThreadPool pool(1);
+  ModulePrefetcher prefetcher(pool);
+  const auto a = directory.Write("a.snek", "let a = 1");
+
+  REQUIRE(ToString(prefetcher.Load(a)) == U"let a = 1");
+
+  // Loading the same module again reads it again.
+  directory.Write("a.snek", "let a = 10");
+  REQUIRE(ToString(prefetcher.Load(a)) == U"let a = 10");
+}
+
+TEST_CASE("Errors are reported by prefetched modules")
+{
+  TemporaryDirectory directory;
+  ThreadPool pool(1);
+  ModulePrefetcher prefetcher(pool);
+  const auto missing = directory.Path("missing.snek");
+  const auto invalid = directory.Write("invalid.snek", "let = ");
+
+  prefetcher.Prefetch(missing);
+  prefetcher.Prefetch(invalid);
+  Drain(pool);
+
+  const auto missing_module = prefetcher.Load(missing);
+  const auto invalid_module = prefetcher.Load(invalid);
+
+  REQUIRE(!missing_module.source);
+  REQUIRE(!missing_module.statements);
+
+  // Source of module with syntax errors is returned, so that the error can be
+  // reported when the module is executed.
+  REQUIRE(invalid_module.source == "let = ");
+  REQUIRE(!invalid_module.statements);
+  REQUIRE(!directory.IsCompiled("invalid.snek"));
+}
+
+TEST_CASE("Modules imported by compiled program are prefetched")
+{
+  TemporaryDirectory directory;
+  ThreadPool pool(1);
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+  const auto a = directory.Write("a.snek", "export const value = 1");
+
+  runtime.set_module_prefetcher(std::make_shared<ModulePrefetcher>(pool));
+  scope->DeclareVariable(
+    U"change",
+    value::Function::MakeNative(
+      {},
+      runtime.void_type(),
+      [&](Runtime&, const std::vector<value::ptr>&) -> value::ptr
+      {
+        // Module has been loaded before the import statement is reached,
+        // so the import does not see this change.
+        Drain(pool);
+        directory.Write("a.snek", "export const value = 2");
+
+        return nullptr;
+      }
+    )
+  );
+
+  REQUIRE(value::Equals(
+    runtime.Run(
+      runtime.Compile("change()\n" + MakeImport(a) + "m.value\n"),
+      scope
+    ),
+    runtime.MakeInt(1)
+  ));
+}
+
+TEST_CASE("Pending modules are dropped with the prefetcher")
+{
+  TemporaryDirectory directory;
+  ThreadPool pool(1);
+  std::promise<void> blocker;
+  const auto a = directory.Write("a.snek", "let a = 1");
+
+  // Keep the worker busy until the prefetcher has been destroyed.
+  pool.Submit([future = blocker.get_future().share()]() { future.wait(); });
+  {
+    ModulePrefetcher prefetcher(pool);
+
+    prefetcher.Prefetch(a);
+  }
+  blocker.set_value();
+  Drain(pool);
+  REQUIRE(!directory.IsCompiled("a.snek"));
+}
+#endif
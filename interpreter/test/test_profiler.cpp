@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/profiler.hpp"
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+#if defined(SNEK_ENABLE_PROFILER) && !defined(_WIN32)
+TEST_CASE("Profiler samples call stacks of the runtime")
+{
+  Runtime runtime;
+  Profiler profiler;
+  std::stringstream output;
+  std::string line;
+
+  REQUIRE(profiler.Start(runtime, Profiler::interval_type(200)));
+  REQUIRE(profiler.running());
+  REQUIRE(runtime.profiler() == &profiler);
+  runtime.RunScript(
+    runtime.root_scope(),
+    U"const fib = (n):\n"
+    U"  if n < 2:\n"
+    U"    return n\n"
+    U"  return fib(n - 1) + fib(n - 2)\n"
+    U"fib(20)\n"
+  );
+  profiler.Stop();
+
+  REQUIRE(!profiler.running());
+  REQUIRE(runtime.profiler() == nullptr);
+  REQUIRE(!profiler.counts().empty());
+
+  profiler.WriteFolded(output);
+  while (std::getline(output, line))
+  {
+    // Each line is the call stack, outermost frame first, followed by the
+    // number of samples.
+    REQUIRE(line.find("<eval>:1:1: <module>") == 0);
+    REQUIRE(line.find_last_of(' ') != std::string::npos);
+    REQUIRE(std::stoul(line.substr(line.find_last_of(' ') + 1)) > 0);
+  }
+
+  profiler.Clear();
+  REQUIRE(profiler.counts().empty());
+}
+
+TEST_CASE("Only one profiler can be running at a time")
+{
+  Runtime runtime1;
+  Runtime runtime2;
+  Profiler profiler1;
+  Profiler profiler2;
+
+  REQUIRE(profiler1.Start(runtime1));
+  REQUIRE(!profiler1.Start(runtime1));
+  REQUIRE(!profiler2.Start(runtime2));
+  profiler1.Stop();
+  REQUIRE(profiler2.Start(runtime2));
+  profiler2.Stop();
+}
+#endif
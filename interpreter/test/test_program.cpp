@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+static std::int64_t
+ToInt(const value::ptr& value)
+{
+  REQUIRE(value::IsInt(value));
+
+  return std::static_pointer_cast<value::Int>(value)->value;
+}
+
+TEST_CASE("Compiled program can be run many times")
+{
+  Runtime runtime;
+  const auto program = runtime.Compile(
+    U"let total = 0\n"
+    U"for i in range(limit):\n"
+    U"  total += i\n"
+    U"total\n",
+    U"sum.snek"
+  );
+
+  REQUIRE(program->filename() == U"sum.snek");
+  REQUIRE(program->statements().size() == 3);
+  for (std::int64_t limit = 1; limit <= 10; ++limit)
+  {
+    const auto scope = std::make_shared<Scope>(runtime.root_scope());
+
+    scope->DeclareVariable(U"limit", runtime.MakeInt(limit));
+    REQUIRE(ToInt(runtime.Run(program, scope)) == limit * (limit - 1) / 2);
+  }
+  REQUIRE(runtime.call_stack().empty());
+}
+
+TEST_CASE("Syntax errors are reported when compiling")
+{
+  Runtime runtime;
+
+  REQUIRE_THROWS_AS(
+    runtime.Compile(std::string("print(1)\nlet = 5\n"), U"broken.snek"),
+    Error
+  );
+  try
+  {
+    runtime.Compile(std::string("let = 5\n"), U"broken.snek");
+  }
+  catch (const Error& e)
+  {
+    REQUIRE(!e.stack_trace.empty());
+    REQUIRE(e.stack_trace.top().position);
+    REQUIRE(*e.stack_trace.top().position->filename == U"broken.snek");
+  }
+}
+
+TEST_CASE("Compiled program can be shared between runtimes")
+{
+  const auto program = Runtime().Compile(
+    std::string("const f = (x) => x * 2\nf(21)\n")
+  );
+  std::vector<std::thread> threads;
+  std::vector<std::int64_t> results(4);
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    threads.emplace_back([&program, &results, i]()
+    {
+      Runtime runtime;
+
+      for (int j = 0; j < 50; ++j)
+      {
+        const auto value = runtime.Run(
+          program,
+          std::make_shared<Scope>(runtime.root_scope())
+        );
+
+        results[i] = std::static_pointer_cast<value::Int>(value)->value;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto result : results)
+  {
+    REQUIRE(result == 42);
+  }
+}
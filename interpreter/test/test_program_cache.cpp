@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+TEST_CASE("Program cache returns inserted entries")
+{
+  Runtime runtime;
+  ProgramCache cache;
+  const auto program = runtime.Compile(U"1 + 2");
+
+  REQUIRE(!cache.Find(U"1 + 2"));
+  cache.Insert(U"1 + 2", program);
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.Find(U"1 + 2") == program);
+  REQUIRE(!cache.Find(U"1 + 3"));
+  REQUIRE(cache.hits() == 1);
+  REQUIRE(cache.misses() == 2);
+  cache.Clear();
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.hits() == 0);
+  REQUIRE(cache.misses() == 0);
+}
+
+TEST_CASE("Program cache evicts least recently used entry")
+{
+  Runtime runtime;
+  ProgramCache cache(2);
+  const auto program = runtime.Compile(U"null");
+
+  cache.Insert(U"a", program);
+  cache.Insert(U"b", program);
+  REQUIRE(cache.Find(U"a"));
+  cache.Insert(U"c", program);
+  REQUIRE(cache.size() == 2);
+  REQUIRE(cache.Find(U"a"));
+  REQUIRE(!cache.Find(U"b"));
+  REQUIRE(cache.Find(U"c"));
+}
+
+TEST_CASE("Program cache does not store long source code")
+{
+  Runtime runtime;
+  ProgramCache cache;
+  const std::u32string source(ProgramCache::kMaxSourceLength + 1, U' ');
+
+  cache.Insert(source, runtime.Compile(source));
+  REQUIRE(cache.size() == 0);
+}
+
+#if defined(SNEK_ENABLE_EVAL_CACHE)
+TEST_CASE("Programs compiled by eval are cached")
+{
+  Runtime runtime;
+  const auto& cache = runtime.program_cache();
+  const auto result = runtime.RunScript(
+    std::make_shared<Scope>(runtime.root_scope()),
+    U"let sum = 0\n"
+    U"for i in range(10):\n"
+    U"  sum = sum + eval(\"3 * 2\")\n"
+    U"sum\n"
+  );
+
+  REQUIRE(value::IsInt(result));
+  REQUIRE(std::static_pointer_cast<value::Int>(result)->value == 60);
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.misses() == 1);
+  REQUIRE(cache.hits() == 9);
+}
+
+TEST_CASE("Syntax errors in eval are not cached")
+{
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+
+  REQUIRE_THROWS_AS(runtime.RunScript(scope, U"eval(\"1 +\")"), Error);
+  REQUIRE_THROWS_AS(runtime.RunScript(scope, U"eval(\"1 +\")"), Error);
+  REQUIRE(runtime.program_cache().size() == 0);
+  REQUIRE(runtime.program_cache().hits() == 0);
+}
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+TEST_CASE("Property cache returns inserted entries")
+{
+  PropertyCache cache;
+  const auto prototype = value::Record::Make({});
+  const auto property = std::make_shared<value::Int>(5);
+
+  REQUIRE(!cache.Find(prototype, U"foo"));
+  cache.Insert(prototype, U"foo", prototype, property);
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.Find(prototype, U"foo") == property);
+  REQUIRE(!cache.Find(prototype, U"bar"));
+  REQUIRE(!cache.Find(value::Record::Make({}), U"foo"));
+}
+
+TEST_CASE("Property cache has bounded size")
+{
+  PropertyCache cache;
+  const auto prototype = value::Record::Make({});
+
+  for (int i = 0; i < 10000; ++i)
+  {
+    cache.Insert(prototype, std::u32string(1, U'a' + i), prototype, nullptr);
+  }
+  REQUIRE(cache.size() <= PropertyCache::kSize);
+}
+
+TEST_CASE("Property cache entries can be invalidated")
+{
+  PropertyCache cache;
+  const auto parent = value::Record::Make({});
+  const auto child = value::Record::Make({ { U"[[Prototype]]", parent } });
+  const auto other = value::Record::Make({});
+
+  cache.Insert(child, U"foo", parent, nullptr);
+  cache.Insert(other, U"foo", other, nullptr);
+  cache.Invalidate(parent);
+  REQUIRE(!cache.Find(child, U"foo"));
+  REQUIRE(cache.Find(other, U"foo"));
+  REQUIRE(cache.size() == 1);
+  cache.Clear();
+  REQUIRE(!cache.Find(other, U"foo"));
+  REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Property lookups through prototypes are cached")
+{
+  Runtime runtime;
+  const auto value = runtime.MakeInt(5);
+  const auto first = value::GetProperty(runtime, value, U"toString");
+
+  REQUIRE(first);
+  REQUIRE(value::IsFunction(*first));
+  REQUIRE(runtime.property_cache().Find(runtime.int_prototype(), U"toString"));
+
+  const auto second = value::GetProperty(runtime, value, U"toString");
+
+  REQUIRE(second);
+  REQUIRE(value::IsFunction(*second));
+  REQUIRE(!value::GetProperty(runtime, value, U"nonExistent"));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "snek/interpreter/sort.hpp"
+
+using namespace snek::interpreter;
+
+using entry_type = std::pair<int, std::size_t>;
+
+static std::vector<entry_type>
+MakeEntries(const std::vector<int>& keys)
+{
+  std::vector<entry_type> entries;
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    entries.emplace_back(keys[i], i);
+  }
+
+  return entries;
+}
+
+static void
+RequireStablySorted(const std::vector<int>& keys)
+{
+  auto entries = MakeEntries(keys);
+  auto expected = entries;
+
+  StableSort(
+    entries,
+    [](const entry_type& a, const entry_type& b) { return a.first < b.first; }
+  );
+  std::stable_sort(
+    std::begin(expected),
+    std::end(expected),
+    [](const entry_type& a, const entry_type& b) { return a.first < b.first; }
+  );
+  REQUIRE(entries == expected);
+}
+
+TEST_CASE("Short inputs are sorted")
+{
+  RequireStablySorted({});
+  RequireStablySorted({ 1 });
+  RequireStablySorted({ 2, 1 });
+  RequireStablySorted({ 3, 1, 2, 1, 3 });
+}
+
+TEST_CASE("Random inputs are sorted stably")
+{
+  std::mt19937 generator(1234);
+
+  for (const auto size : { 31, 32, 33, 64, 1000, 10000, 100000 })
+  {
+    for (const auto range : { 4, 1000000 })
+    {
+      std::uniform_int_distribution<int> distribution(0, range);
+      std::vector<int> keys(size);
+
+      for (auto& key : keys)
+      {
+        key = distribution(generator);
+      }
+      RequireStablySorted(keys);
+    }
+  }
+}
+
+TEST_CASE("Partially sorted inputs are sorted stably")
+{
+  std::vector<int> keys;
+
+  // Ascending and descending runs of varying lengths, with duplicates.
+  for (int run = 0; run < 200; ++run)
+  {
+    const auto length = (run * 37) % 150 + 1;
+
+    for (int i = 0; i < length; ++i)
+    {
+      keys.push_back(run % 2 ? length - i / 2 : i / 2);
+    }
+  }
+  RequireStablySorted(keys);
+}
+
+TEST_CASE("Inconsistent comparison does not break the sort")
+{
+  std::mt19937 generator(1234);
+  std::vector<int> values(5000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<int>(i);
+  }
+  StableSort(
+    values,
+    [&generator](int, int) { return generator() % 2 == 0; }
+  );
+  std::sort(std::begin(values), std::end(values));
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    REQUIRE(values[i] == static_cast<int>(i));
+  }
+}
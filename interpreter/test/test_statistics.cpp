@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/runtime.hpp"
+#include "snek/interpreter/work_stealing_pool.hpp"
+
+using namespace snek;
+using namespace snek::interpreter;
+
+#if defined(SNEK_ENABLE_STATISTICS)
+TEST_CASE("Runtime counts what it executes")
+{
+  using parser::expression::Kind;
+
+  Runtime runtime;
+  auto& statistics = runtime.statistics();
+
+  statistics.Reset();
+  runtime.RunScript(
+    runtime.root_scope(),
+    U"let total = 0\n"
+    U"for x in [1, 2, 3]:\n"
+    U"  total += x\n"
+    U"[1, 2].map((x) => x * 2)\n"
+  );
+
+  REQUIRE(statistics.statements[
+    static_cast<std::size_t>(parser::statement::Kind::For)
+  ] == 1);
+  REQUIRE(statistics.expressions[static_cast<std::size_t>(Kind::Int)] >= 6);
+  REQUIRE(statistics.method_calls[U"+"] == 3);
+  REQUIRE(statistics.method_calls[U"*"] == 2);
+  REQUIRE(statistics.scripted_calls == 2);
+  REQUIRE(statistics.native_calls >= 6);
+  REQUIRE(statistics.parameter_checks > 0);
+#if defined(SNEK_ENABLE_PROPERTY_CACHE)
+  REQUIRE(statistics.property_cache_hits > 0);
+  REQUIRE(statistics.property_cache_misses > 0);
+#endif
+}
+
+TEST_CASE("Method calls are counted by name")
+{
+  static const std::u32string add = U"+";
+  Statistics statistics;
+  std::u32string name = U"-";
+
+  statistics.CountMethodCall(add);
+  statistics.CountMethodCall(add);
+  statistics.CountMethodCall(name);
+
+  // Same address with a different name.
+  name = U"*";
+  statistics.CountMethodCall(name);
+  statistics.CountMethodCall(U"+");
+
+  REQUIRE(statistics.method_calls[U"+"] == 3);
+  REQUIRE(statistics.method_calls[U"-"] == 1);
+  REQUIRE(statistics.method_calls[U"*"] == 1);
+
+  // Copies do not share the counters.
+  auto copy = statistics;
+
+  copy.CountMethodCall(add);
+  REQUIRE(copy.method_calls[U"+"] == 4);
+  REQUIRE(statistics.method_calls[U"+"] == 3);
+
+  statistics.Reset();
+  statistics.CountMethodCall(add);
+  REQUIRE(statistics.method_calls[U"+"] == 1);
+}
+
+TEST_CASE("Statistics of parallel operations are merged")
+{
+  Runtime runtime;
+  auto& statistics = runtime.statistics();
+
+  runtime.set_worker_pool(std::make_shared<WorkStealingPool>(3));
+  runtime.RunScript(
+    runtime.root_scope(),
+    U"let list = ([0] * 5000).map((x, i) => i)"
+  );
+  statistics.Reset();
+  runtime.RunScript(runtime.root_scope(), U"list.parallelMap((x) => x * 2)");
+
+  REQUIRE(statistics.method_calls[U"*"] == 5000);
+  REQUIRE(statistics.scripted_calls == 5000);
+}
+
+TEST_CASE("Statistics report omits zero counters")
+{
+  Statistics statistics;
+  std::stringstream output;
+
+  statistics.CountStatement(parser::statement::Kind::While);
+  statistics.CountStatement(parser::statement::Kind::While);
+  statistics.method_calls[U"+"] = 5;
+  statistics.Write(output);
+
+  REQUIRE(output.str().find("While") != std::string::npos);
+  REQUIRE(output.str().find("Block") == std::string::npos);
+  REQUIRE(output.str().find("Native function calls") == std::string::npos);
+  REQUIRE(output.str().find("+") != std::string::npos);
+
+  statistics.Reset();
+  output.str("");
+  statistics.Write(output);
+  REQUIRE(output.str().empty());
+}
+#endif
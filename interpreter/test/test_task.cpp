@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/interpreter/task.hpp"
+
+using namespace snek::interpreter;
+
+#if !defined(_WIN32)
+static const char32_t* loop_script =
+  U"let total = 0\n"
+  U"for i in range(100):\n"
+  U"  total += i\n"
+  U"total\n";
+
+static std::int64_t
+ToInt(const value::ptr& value)
+{
+  REQUIRE(value::IsInt(value));
+
+  return std::static_pointer_cast<value::Int>(value)->value;
+}
+
+TEST_CASE("Task suspends after its slice and can be resumed")
+{
+  Runtime runtime;
+  const auto task = Task::MakeScript(
+    runtime,
+    std::make_shared<Scope>(runtime.root_scope()),
+    loop_script
+  );
+  int resumes = 1;
+
+  task->set_slice(10);
+  while (!task->Resume())
+  {
+    REQUIRE(task->state() == Task::State::Suspended);
+    REQUIRE(runtime.call_stack().empty());
+    ++resumes;
+  }
+  REQUIRE(task->state() == Task::State::Finished);
+  REQUIRE(resumes >= 10);
+  REQUIRE(ToInt(task->result()) == 4950);
+}
+
+TEST_CASE("Tasks sharing a runtime can be interleaved")
+{
+  Runtime runtime;
+  std::vector<Task::ptr> tasks;
+  bool all_done = false;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    tasks.push_back(Task::MakeScript(
+      runtime,
+      std::make_shared<Scope>(runtime.root_scope()),
+      loop_script
+    ));
+    tasks.back()->set_slice(7);
+  }
+  while (!all_done)
+  {
+    all_done = true;
+    for (const auto& task : tasks)
+    {
+      all_done = task->Resume() && all_done;
+    }
+  }
+  for (const auto& task : tasks)
+  {
+    REQUIRE(ToInt(task->result()) == 4950);
+  }
+}
+
+TEST_CASE("Task waits for asynchronous native function")
+{
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+  Task::ptr pending;
+
+  scope->DeclareVariable(
+    U"fetch",
+    value::Function::MakeNative(
+      {},
+      runtime.int_type(),
+      [&pending](Runtime& runtime, const std::vector<value::ptr>&)
+      {
+        return Task::Await(runtime, [&pending](const Task::ptr& task)
+        {
+          pending = task;
+        });
+      }
+    )
+  );
+
+  const auto task = Task::MakeScript(runtime, scope, U"fetch() + 1");
+
+  REQUIRE(!task->Resume());
+  REQUIRE(task->state() == Task::State::Waiting);
+  REQUIRE(pending == task);
+  REQUIRE(!task->Resume());
+  task->Complete(runtime.MakeInt(41));
+  REQUIRE(task->Resume());
+  REQUIRE(ToInt(task->result()) == 42);
+}
+
+TEST_CASE("Task reports errors")
+{
+  Runtime runtime;
+  const auto task = Task::MakeScript(
+    runtime,
+    std::make_shared<Scope>(runtime.root_scope()),
+    U"undefinedVariable"
+  );
+
+  REQUIRE(task->Resume());
+  REQUIRE(task->state() == Task::State::Failed);
+  REQUIRE(task->error());
+  REQUIRE(runtime.call_stack().empty());
+}
+
+TEST_CASE("Destroying suspended task releases its values")
+{
+  Runtime runtime;
+  const auto scope = std::make_shared<Scope>(runtime.root_scope());
+  const auto resource = value::List::Make({});
+  Task::ptr task;
+
+  scope->DeclareVariable(U"resource", resource);
+  task = Task::MakeScript(
+    runtime,
+    scope,
+    U"const f = ():\n"
+    U"  const held = [resource]\n"
+    U"  while true:\n"
+    U"    pass\n"
+    U"f()\n"
+  );
+  task->set_slice(5);
+  REQUIRE(!task->Resume());
+  REQUIRE(resource.use_count() > 2);
+  task.reset();
+  REQUIRE(resource.use_count() == 2);
+  REQUIRE(runtime.RunScript(runtime.root_scope(), U"1 + 2"));
+}
+
+TEST_CASE("Budgets of interleaved tasks do not affect each other")
+{
+  Runtime runtime;
+  const auto make_task = [&runtime](std::uint64_t fuel)
+  {
+    const auto scope = std::make_shared<Scope>(runtime.root_scope());
+    const auto task = Task::Make(runtime, [scope, fuel](Runtime& runtime)
+    {
+      BudgetScope budget_scope(runtime, fuel, std::nullopt);
+
+      return runtime.RunScript(scope, loop_script);
+    });
+
+    task->set_slice(7);
+
+    return task;
+  };
+  const auto limited = make_task(20);
+  const auto unlimited = make_task(100000);
+  bool all_done = false;
+
+  while (!all_done)
+  {
+    all_done = limited->Resume();
+    all_done = unlimited->Resume() && all_done;
+    REQUIRE(!runtime.budget().fuel);
+  }
+  REQUIRE(limited->state() == Task::State::Failed);
+  REQUIRE(unlimited->state() == Task::State::Finished);
+  REQUIRE(ToInt(unlimited->result()) == 4950);
+}
+
+TEST_CASE("Budget given to a task applies only inside it")
+{
+  Runtime runtime;
+  const auto task = Task::MakeScript(
+    runtime,
+    std::make_shared<Scope>(runtime.root_scope()),
+    loop_script
+  );
+  BudgetScope budget_scope(runtime, 5, std::nullopt);
+
+  task->set_budget({ 1000, std::nullopt });
+  REQUIRE(task->Resume());
+  REQUIRE(task->state() == Task::State::Finished);
+  REQUIRE(*task->budget().fuel < 1000);
+  REQUIRE(runtime.budget().fuel == 5u);
+}
+
+TEST_CASE("Asynchronous function cannot be called outside of a task")
+{
+  Runtime runtime;
+
+  REQUIRE_THROWS_AS(
+    Task::Await(runtime, [](const Task::ptr&) {}),
+    Error
+  );
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "snek/interpreter/runtime.hpp"
+
+using namespace snek::interpreter;
+
+static constexpr std::size_t kThreadCount = 8;
+
+template<class Callback>
+static void
+RunInThreads(Callback callback)
+{
+  std::vector<std::thread> threads;
+
+  threads.reserve(kThreadCount);
+  for (std::size_t i = 0; i < kThreadCount; ++i)
+  {
+    threads.emplace_back(callback, i);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+static const std::u32string script = UR"(
+const fib = (n: Int) -> Int:
+    if n < 2:
+        return n
+    else:
+        return fib(n - 1) + fib(n - 2)
+
+let total = 0
+let i = 0
+
+while i < 200:
+    total = total + [1, 2, 3].map((x) => x * i).reduce((a, b) => a + b, 0)
+    total = total + "snek".length() + Int.random(1, 1)
+    total = total + (true.toString() == "true" ? 1 : 0)
+    i = i + 1
+
+total + fib(15)
+)";
+
+TEST_CASE("Runtimes can run concurrently in multiple threads")
+{
+  std::vector<value::ptr> results(kThreadCount);
+
+  RunInThreads([&results](std::size_t index)
+  {
+    Runtime runtime;
+
+    results[index] = runtime.RunScript(runtime.root_scope(), script);
+  });
+
+  for (const auto& result : results)
+  {
+    REQUIRE(value::IsInt(result));
+    REQUIRE(static_cast<const value::Int*>(result.get())->value == 121210);
+  }
+}
+
+TEST_CASE("Values can be shared between runtimes")
+{
+  Runtime main_runtime;
+  const auto list = main_runtime.RunScript(
+    main_runtime.root_scope(),
+    U"[1, 2, 3, 4, 5]"
+  );
+  std::vector<value::ptr> results(kThreadCount);
+
+  RunInThreads([&list, &results](std::size_t index)
+  {
+    Runtime runtime;
+    const auto scope = std::make_shared<Scope>(runtime.root_scope());
+
+    scope->DeclareVariable(U"list", list);
+    for (int i = 0; i < 1000; ++i)
+    {
+      results[index] = runtime.RunScript(
+        scope,
+        U"list.map((x) => x + 1).reverse().includes(6) && 1.toString() == \"1\""
+      );
+    }
+  });
+
+  for (const auto& result : results)
+  {
+    REQUIRE(value::IsBoolean(result));
+    REQUIRE(static_cast<const value::Boolean*>(result.get())->value);
+  }
+}
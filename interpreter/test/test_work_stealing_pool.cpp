@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "snek/interpreter/work_stealing_pool.hpp"
+
+using namespace snek::interpreter;
+
+TEST_CASE("Every item is processed exactly once")
+{
+  WorkStealingPool pool(4);
+  std::vector<std::atomic<int>> counts(10000);
+  std::atomic<bool> valid_workers(true);
+
+  pool.Run(
+    counts.size(),
+    7,
+    [&](std::size_t worker, std::size_t begin, std::size_t end)
+    {
+      if (worker > pool.size())
+      {
+        valid_workers = false;
+      }
+      for (auto i = begin; i < end; ++i)
+      {
+        ++counts[i];
+      }
+    }
+  );
+  REQUIRE(valid_workers);
+  for (const auto& count : counts)
+  {
+    REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("Pool without workers runs tasks in calling thread")
+{
+  WorkStealingPool pool(0);
+  std::size_t total = 0;
+
+  pool.Run(
+    100,
+    10,
+    [&](std::size_t worker, std::size_t begin, std::size_t end)
+    {
+      REQUIRE(worker == 0);
+      total += end - begin;
+    }
+  );
+  REQUIRE(total == 100);
+}
+
+TEST_CASE("Pool can be used from inside of it's own tasks")
+{
+  WorkStealingPool pool(2);
+  std::atomic<std::size_t> total(0);
+
+  pool.Run(
+    16,
+    1,
+    [&](std::size_t, std::size_t, std::size_t)
+    {
+      pool.Run(
+        16,
+        1,
+        [&](std::size_t, std::size_t begin, std::size_t end)
+        {
+          total += end - begin;
+        }
+      );
+    }
+  );
+  REQUIRE(total == 256);
+}
+
+TEST_CASE("Exceptions thrown by tasks are rethrown to the caller")
+{
+  WorkStealingPool pool(2);
+
+  REQUIRE_THROWS_AS(
+    pool.Run(
+      100,
+      1,
+      [](std::size_t, std::size_t begin, std::size_t)
+      {
+        if (begin == 50)
+        {
+          throw std::runtime_error("failure");
+        }
+      }
+    ),
+    std::runtime_error
+  );
+}
+
+TEST_CASE("Skipping cancelled chunks is reported to the caller")
+{
+  WorkStealingPool pool(0);
+  std::atomic<bool> cancelled(false);
+  std::size_t total = 0;
+
+  REQUIRE_THROWS_AS(
+    pool.Run(
+      100,
+      10,
+      [&](std::size_t, std::size_t begin, std::size_t end)
+      {
+        total += end - begin;
+        cancelled = true;
+      },
+      &cancelled
+    ),
+    WorkStealingPool::Cancelled
+  );
+  REQUIRE(total == 10);
+}
+
+TEST_CASE("Work which was not cancelled does not throw")
+{
+  WorkStealingPool pool(2);
+  std::atomic<bool> cancelled(false);
+  std::atomic<std::size_t> total(0);
+
+  pool.Run(
+    100,
+    10,
+    [&](std::size_t, std::size_t begin, std::size_t end)
+    {
+      total += end - begin;
+    },
+    &cancelled
+  );
+  REQUIRE(total == 100);
+}
@@ -43,8 +43,15 @@ namespace snek::parser
     public:
       DISALLOW_COPY_AND_ASSIGN(Input);
 
+      /**
+       * Maximum number of characters that can be peeked or unread at once.
+       */
+      static constexpr std::size_t kLookaheadSize = 4;
+
       explicit Input(const Position& position)
-        : m_position(position) {}
+        : m_position(position)
+        , m_lookahead_size(0)
+        , m_line_count(0) {}
 
       inline const Position& position() const
       {
@@ -53,15 +60,12 @@ namespace snek::parser
 
       inline bool Eof() const
       {
-        return m_char_queue.empty() && !HasMoreInput();
+        return !m_lookahead_size && !HasMoreInput();
       }
 
       char32_t Read();
 
-      inline void Unread(char32_t c)
-      {
-        m_char_queue.push_back(c);
-      }
+      void Unread(char32_t c);
 
       char32_t Peek();
 
@@ -82,14 +86,68 @@ namespace snek::parser
         return false;
       }
 
+      /**
+       * Consumes run of ASCII identifier characters directly from the
+       * underlying input, without going through the lookahead buffer, and
+       * appends them into given buffer. Characters outside of ASCII range are
+       * left to be read with Read().
+       */
+      inline void ReadAsciiIdPart(std::u32string& buffer)
+      {
+        if (!m_lookahead_size)
+        {
+          m_position.column += static_cast<int>(ScanAsciiIdPart(buffer));
+        }
+      }
+
+      /**
+       * Skips run of spaces and tabs directly from the underlying input,
+       * without going through the lookahead buffer.
+       */
+      inline void SkipBlanks()
+      {
+        if (!m_lookahead_size)
+        {
+          m_position.column += static_cast<int>(ScanBlanks());
+        }
+      }
+
     protected:
       virtual bool HasMoreInput() const = 0;
 
       virtual char32_t Advance() = 0;
 
+      /**
+       * Fast path used by ReadAsciiIdPart(). Returns number of characters
+       * consumed. Default implementation consumes nothing.
+       */
+      virtual std::size_t ScanAsciiIdPart(std::u32string&)
+      {
+        return 0;
+      }
+
+      /**
+       * Fast path used by SkipBlanks(). Returns number of characters
+       * consumed. Default implementation consumes nothing.
+       */
+      virtual std::size_t ScanBlanks()
+      {
+        return 0;
+      }
+
+    private:
+      char32_t Fetch();
+
     private:
       Position m_position;
-      std::deque<char32_t> m_char_queue;
+      char32_t m_lookahead[kLookaheadSize];
+      std::size_t m_lookahead_size;
+      /**
+       * Columns where the most recently read lines ended, so that the
+       * position can be restored when a line terminator is unread.
+       */
+      int m_line_ends[kLookaheadSize];
+      std::size_t m_line_count;
     };
 
     Lexer(
@@ -99,6 +157,19 @@ namespace snek::parser
       int column = 1
     );
 
+    /**
+     * Constructs lexer which reads UTF-8 encoded source code directly from
+     * given contiguous buffer, such as an memory mapped file, without making
+     * copy of it. The buffer must outlive the lexer.
+     */
+    Lexer(
+      const char* input,
+      std::size_t length,
+      const std::u32string& filename = U"<eval>",
+      int line = 1,
+      int column = 1
+    );
+
     Lexer(
       const std::u32string& input,
       const std::u32string& filename = U"<eval>",
@@ -132,6 +203,13 @@ namespace snek::parser
     std::u32string ReadString();
 
   private:
+    /**
+     * Lexes more input until there is at least one token in the token queue.
+     * Returns false if end of input has been reached and the token queue is
+     * still empty.
+     */
+    bool FillTokenQueue();
+
     void LexLogicalLine();
 
     Token LexOperator();
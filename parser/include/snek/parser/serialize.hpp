@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "snek/parser/statement.hpp"
+
+namespace snek::parser::serialize
+{
+  /**
+   * Version of the binary syntax tree format. Must be incremented whenever
+   * the format or the syntax tree changes in an incompatible way.
+   */
+  static constexpr std::uint32_t kVersion = 2;
+
+  /**
+   * Appends binary representation of given statements into the output.
+   * Source code positions are included, but the filename is not, as it's
+   * expected to be the same for all of the statements.
+   */
+  void Serialize(
+    const std::vector<statement::ptr>& statements,
+    std::string& output
+  );
+
+  /**
+   * Reconstructs statements from their binary representation produced by
+   * Serialize(). Throws a SyntaxError if the input is truncated or otherwise
+   * malformed.
+   */
+  std::vector<statement::ptr> Deserialize(
+    const char* input,
+    std::size_t length,
+    const std::u32string& filename
+  );
+}
@@ -42,6 +42,7 @@ namespace snek::parser::statement
     DeclareType,
     DeclareVar,
     Expression,
+    For,
     If,
     Import,
     Jump,
@@ -176,6 +177,32 @@ namespace snek::parser::statement
     }
   };
 
+  class For final : public Base
+  {
+  public:
+    const expression::ptr variable;
+    const expression::ptr iterable;
+    const ptr body;
+
+    explicit For(
+      const std::optional<Position>& position,
+      const expression::ptr& variable_,
+      const expression::ptr& iterable_,
+      const ptr& body_
+    )
+      : Base(position)
+      , variable(variable_)
+      , iterable(iterable_)
+      , body(body_) {}
+
+    inline Kind kind() const override
+    {
+      return Kind::For;
+    }
+
+    std::u32string ToString() const override;
+  };
+
   class If final : public Base
   {
   public:
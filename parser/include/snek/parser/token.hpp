@@ -119,6 +119,7 @@ namespace snek::parser
       KeywordExport,
       KeywordIf,
       KeywordImport,
+      KeywordIn,
       KeywordLet,
       KeywordNull,
       KeywordPass,
@@ -134,11 +135,11 @@ namespace snek::parser
     Token(
       const std::optional<Position>& position = std::nullopt,
       Kind kind_ = Kind::Eof,
-      const std::optional<std::u32string>& text_ = std::nullopt
+      std::optional<std::u32string> text_ = std::nullopt
     )
       : Node(position)
       , kind(kind_)
-      , text(text_) {}
+      , text(std::move(text_)) {}
 
     static std::u32string ToString(Kind kind);
 
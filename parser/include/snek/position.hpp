@@ -25,6 +25,7 @@
  */
 #pragma once
 
+#include <memory>
 #include <string>
 
 namespace snek
@@ -34,7 +35,11 @@ namespace snek
    */
   struct Position
   {
-    std::u32string filename;
+    /**
+     * Name of the file. Shared between all positions originating from the same
+     * source so that copying a position does not copy the filename.
+     */
+    std::shared_ptr<const std::u32string> filename;
     int line;
     int column;
 
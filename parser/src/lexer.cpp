@@ -23,8 +23,6 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
-#include <unordered_map>
-
 #include <peelo/unicode/ctype/isvalid.hpp>
 #include <peelo/unicode/encoding/utf8.hpp>
 
@@ -34,76 +32,168 @@
 
 namespace snek::parser
 {
-  using keyword_map = std::unordered_map<std::u32string, Token::Kind>;
+  namespace
+  {
+    struct Keyword
+    {
+      const char32_t* text;
+      Token::Kind kind;
+    };
+  }
 
-  static const std::unordered_map<std::u32string, Token::Kind> keywords =
+  static constexpr std::size_t kKeywordTableSize = 32;
+
+  /**
+   * Perfect hash table of reserved keywords, indexed with KeywordHash(). Empty
+   * slots have null text.
+   */
+  static const Keyword keywords[kKeywordTableSize] =
   {
-    { U"as", Token::Kind::KeywordAs },
-    { U"break", Token::Kind::KeywordBreak },
     { U"const", Token::Kind::KeywordConst },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
     { U"continue", Token::Kind::KeywordContinue },
     { U"else", Token::Kind::KeywordElse },
-    { U"export", Token::Kind::KeywordExport },
-    { U"false", Token::Kind::KeywordFalse },
+    { U"pass", Token::Kind::KeywordPass },
+    { U"true", Token::Kind::KeywordTrue },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
+    { U"while", Token::Kind::KeywordWhile },
     { U"for", Token::Kind::KeywordFor },
-    { U"from", Token::Kind::KeywordFrom },
+    { nullptr, Token::Kind::Eof },
     { U"if", Token::Kind::KeywordIf },
-    { U"import", Token::Kind::KeywordImport },
-    { U"let", Token::Kind::KeywordLet },
+    { U"type", Token::Kind::KeywordType },
+    { U"from", Token::Kind::KeywordFrom },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
     { U"null", Token::Kind::KeywordNull },
-    { U"pass", Token::Kind::KeywordPass },
+    { U"export", Token::Kind::KeywordExport },
     { U"return", Token::Kind::KeywordReturn },
-    { U"true", Token::Kind::KeywordTrue },
-    { U"type", Token::Kind::KeywordType },
-    { U"while", Token::Kind::KeywordWhile },
+    { U"in", Token::Kind::KeywordIn },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
+    { U"import", Token::Kind::KeywordImport },
+    { U"let", Token::Kind::KeywordLet },
+    { U"as", Token::Kind::KeywordAs },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
+    { nullptr, Token::Kind::Eof },
+    { U"false", Token::Kind::KeywordFalse },
+    { U"break", Token::Kind::KeywordBreak },
   };
 
-  char32_t
-  Lexer::Input::Read()
+  static inline std::size_t
+  KeywordHash(const std::u32string& text)
   {
-    char32_t c;
+    return (text.length() + 4 * text[0] + text[1]) % kKeywordTableSize;
+  }
 
-    if (m_char_queue.empty())
+  static inline std::optional<Token::Kind>
+  LookupKeyword(const std::u32string& text)
+  {
+    if (text.length() >= 2)
     {
-      c = Advance();
-      if (utils::IsNewLine(c))
-      {
-        if (c == '\r')
-        {
-          const auto c2 = HasMoreInput() ? Advance() : '\n';
+      const auto& keyword = keywords[KeywordHash(text)];
 
-          if (c2 != '\n')
-          {
-            m_char_queue.push_back(c2);
-          }
-        }
-        ++m_position.line;
-        m_position.column = 1;
-        c = '\n';
-      } else {
-        ++m_position.column;
+      if (keyword.text && !text.compare(keyword.text))
+      {
+        return keyword.kind;
       }
+    }
+
+    return std::nullopt;
+  }
+
+  static inline bool
+  IsAsciiIdPart(char c)
+  {
+    return (c >= 'a' && c <= 'z')
+      || (c >= 'A' && c <= 'Z')
+      || (c >= '0' && c <= '9')
+      || c == '_'
+      || c == '$';
+  }
+
+  char32_t
+  Lexer::Input::Read()
+  {
+    const auto c = m_lookahead_size
+      ? m_lookahead[--m_lookahead_size]
+      : Fetch();
+
+    if (c == '\n')
+    {
+      m_line_ends[m_line_count++ % kLookaheadSize] = m_position.column;
+      ++m_position.line;
+      m_position.column = 1;
     } else {
-      c = m_char_queue.front();
-      m_char_queue.pop_front();
+      ++m_position.column;
     }
 
     return c;
   }
 
+  void
+  Lexer::Input::Unread(char32_t c)
+  {
+    if (m_lookahead_size >= kLookaheadSize)
+    {
+      throw SyntaxError{ m_position, U"Too many characters unread." };
+    }
+    m_lookahead[m_lookahead_size++] = c;
+    if (c == '\n')
+    {
+      if (m_line_count > 0 && m_position.line > 1)
+      {
+        --m_position.line;
+        m_position.column = m_line_ends[--m_line_count % kLookaheadSize];
+      }
+    }
+    else if (m_position.column > 1)
+    {
+      --m_position.column;
+    }
+  }
+
   char32_t
   Lexer::Input::Peek()
   {
-    if (m_char_queue.empty())
+    if (!m_lookahead_size)
+    {
+      const auto c = Fetch();
+
+      m_lookahead[m_lookahead_size++] = c;
+    }
+
+    return m_lookahead[m_lookahead_size - 1];
+  }
+
+  /**
+   * Reads next character from the underlying input and normalizes different
+   * line terminators into single `\n'.
+   */
+  char32_t
+  Lexer::Input::Fetch()
+  {
+    const auto c = Advance();
+
+    if (c == '\r')
     {
-      const auto c = Advance();
+      if (HasMoreInput())
+      {
+        const auto c2 = Advance();
 
-      m_char_queue.push_back(c);
+        if (c2 != '\n')
+        {
+          m_lookahead[m_lookahead_size++] = c2;
+        }
+      }
 
-      return c;
+      return '\n';
     }
 
-    return m_char_queue.front();
+    return c;
   }
 
   namespace
@@ -113,76 +203,119 @@ namespace snek::parser
     public:
       explicit Utf8Input(const Position& position, const std::string& input)
         : Input(position)
-        , m_input(input)
-        , m_offset(0) {}
+        , m_storage(input)
+        , m_current(m_storage.data())
+        , m_end(m_storage.data() + m_storage.length()) {}
+
+      explicit Utf8Input(
+        const Position& position,
+        const char* input,
+        std::size_t length
+      )
+        : Input(position)
+        , m_current(input)
+        , m_end(input + length) {}
 
     protected:
       inline bool HasMoreInput() const override
       {
-        return m_offset < m_input.length();
+        return m_current < m_end;
       }
 
       char32_t Advance() override
       {
         using peelo::unicode::encoding::utf8::sequence_length;
 
-        const auto c = m_input[m_offset++];
-        const auto length = sequence_length(c);
+        const auto c = *m_current++;
+        std::size_t length;
+        char32_t result;
 
-        if (length > 1)
+        // Fast path for ASCII characters.
+        if (!(c & 0x80))
         {
-          char32_t result;
+          return static_cast<char32_t>(c);
+        }
 
-          if (m_offset + (length - 1) >= m_input.length())
-          {
+        length = sequence_length(c);
+        if (
+          !length ||
+          length - 1 > static_cast<std::size_t>(m_end - m_current)
+        )
+        {
+          throw SyntaxError{
+            position(),
+            U"Unable to decode given input as UTF-8."
+          };
+        }
+        switch (length)
+        {
+          case 2:
+            result = static_cast<char32_t>(c & 0x1f);
+            break;
+
+          case 3:
+            result = static_cast<char32_t>(c & 0x0f);
+            break;
+
+          case 4:
+            result = static_cast<char32_t>(c & 0x07);
+            break;
+
+          default:
             throw SyntaxError{
               position(),
               U"Unable to decode given input as UTF-8."
             };
-          }
-          switch (length)
-          {
-            case 2:
-              result = static_cast<char32_t>(c & 0x1f);
-              break;
-
-            case 3:
-              result = static_cast<char32_t>(c & 0x0f);
-              break;
-
-            case 4:
-              result = static_cast<char32_t>(c & 0x07);
-              break;
-
-            default:
-              throw SyntaxError{
-                position(),
-                U"Unable to decode given input as UTF-8."
-              };
-          }
-          for (std::size_t i = 1; i < length; ++i)
+        }
+        for (std::size_t i = 1; i < length; ++i)
+        {
+          const auto c2 = *m_current++;
+
+          if ((c2 & 0xc0) != 0x80)
           {
-            const auto c2 = m_input[m_offset++];
-
-            if ((c2 & 0xc0) != 0x80)
-            {
-              throw SyntaxError{
-                position(),
-                U"Unable to decode given input as UTF-8."
-              };
-            }
-            result = (result << 6) | (c2 & 0x3f);
+            throw SyntaxError{
+              position(),
+              U"Unable to decode given input as UTF-8."
+            };
           }
+          result = (result << 6) | (c2 & 0x3f);
+        }
+
+        return result;
+      }
+
+      std::size_t ScanAsciiIdPart(std::u32string& buffer) override
+      {
+        const auto begin = m_current;
+
+        while (m_current < m_end && IsAsciiIdPart(*m_current))
+        {
+          ++m_current;
+        }
+        buffer.append(begin, m_current);
+
+        return static_cast<std::size_t>(m_current - begin);
+      }
+
+      std::size_t ScanBlanks() override
+      {
+        const auto begin = m_current;
 
-          return result;
+        while (
+          m_current < m_end &&
+          (*m_current == ' ' || *m_current == '\t')
+        )
+        {
+          ++m_current;
         }
 
-        return static_cast<char32_t>(c);
+        return static_cast<std::size_t>(m_current - begin);
       }
 
     private:
-      const std::string m_input;
-      std::string::size_type m_offset;
+      const std::string m_storage;
+      const char* m_current;
+      const char* const m_end;
     };
 
     class UnicodeInput final : public Lexer::Input
@@ -220,10 +353,31 @@ namespace snek::parser
     int column
   )
     : m_input(std::make_shared<Utf8Input>(
-        Position{ filename, line, column },
+        Position{
+          std::make_shared<const std::u32string>(filename),
+          line,
+          column
+        },
         source
       )) {}
 
+  Lexer::Lexer(
+    const char* source,
+    std::size_t length,
+    const std::u32string& filename,
+    int line,
+    int column
+  )
+    : m_input(std::make_shared<Utf8Input>(
+        Position{
+          std::make_shared<const std::u32string>(filename),
+          line,
+          column
+        },
+        source,
+        length
+      )) {}
+
   Lexer::Lexer(
     const std::u32string& source,
     const std::u32string& filename,
@@ -231,46 +385,59 @@ namespace snek::parser
     int column
   )
     : m_input(std::make_shared<UnicodeInput>(
-        Position{ filename, line, column },
+        Position{
+          std::make_shared<const std::u32string>(filename),
+          line,
+          column
+        },
         source
       )) {}
 
-  Token
-  Lexer::ReadToken()
+  bool
+  Lexer::FillTokenQueue()
   {
-    for (;;)
+    while (m_token_queue.empty())
     {
-      if (!m_token_queue.empty())
-      {
-        const auto token = m_token_queue.front();
-
-        m_token_queue.pop_front();
-
-        return token;
-      }
       if (!m_input->Eof())
       {
         LexLogicalLine();
-      } else {
-        if (m_indent_stack.empty())
-        {
-          return Token(m_input->position(), Token::Kind::Eof);
-        }
+        continue;
+      }
+      else if (m_indent_stack.empty())
+      {
+        return false;
+      }
+      m_token_queue.push_back(Token(
+        m_input->position(),
+        Token::Kind::NewLine
+      ));
+      do
+      {
+        m_indent_stack.pop();
         m_token_queue.push_back(Token(
           m_input->position(),
-          Token::Kind::NewLine
+          Token::Kind::Dedent
         ));
-        do
-        {
-          m_indent_stack.pop();
-          m_token_queue.push_back(Token(
-            m_input->position(),
-            Token::Kind::Dedent
-          ));
-        }
-        while (!m_indent_stack.empty());
       }
+      while (!m_indent_stack.empty());
     }
+
+    return true;
+  }
+
+  Token
+  Lexer::ReadToken()
+  {
+    if (FillTokenQueue())
+    {
+      auto token = std::move(m_token_queue.front());
+
+      m_token_queue.pop_front();
+
+      return token;
+    }
+
+    return Token(m_input->position(), Token::Kind::Eof);
   }
 
   void
@@ -321,11 +488,12 @@ namespace snek::parser
   bool
   Lexer::PeekToken(Token::Kind expected)
   {
-    const auto token = ReadToken();
-
-    UnreadToken(token);
+    if (FillTokenQueue())
+    {
+      return m_token_queue.front().kind == expected;
+    }
 
-    return token.kind == expected;
+    return expected == Token::Kind::Eof;
   }
 
   bool
@@ -343,16 +511,17 @@ namespace snek::parser
   bool
   Lexer::PeekReadToken(Token::Kind expected)
   {
-    const auto token = ReadToken();
-
-    if (token.kind != expected)
+    if (PeekToken(expected))
     {
-      UnreadToken(token);
+      if (!m_token_queue.empty())
+      {
+        m_token_queue.pop_front();
+      }
 
-      return false;
+      return true;
     }
 
-    return true;
+    return false;
   }
 
   std::u32string
@@ -456,6 +625,8 @@ namespace snek::parser
     // Lex tokens after initial indent.
     for (;;)
     {
+      m_input->SkipBlanks();
+
       // End of input.
       if (m_input->Eof())
       {
@@ -756,20 +927,20 @@ namespace snek::parser
   {
     const auto position = m_input->position();
     std::u32string result;
-    keyword_map::const_iterator keyword_index;
 
     do
     {
       result.append(1, m_input->Read());
+      m_input->ReadAsciiIdPart(result);
     }
     while (!m_input->Eof() && utils::IsIdPart(m_input->Peek()));
 
-    if ((keyword_index = keywords.find(result)) != std::end(keywords))
+    if (const auto keyword = LookupKeyword(result))
     {
-      return Token(position, keyword_index->second);
+      return Token(position, *keyword);
     }
 
-    return Token(position, Token::Kind::Id, result);
+    return Token(position, Token::Kind::Id, std::move(result));
   }
 
   Token
@@ -804,7 +975,7 @@ namespace snek::parser
       }
     }
 
-    return Token(position, Token::Kind::String, result);
+    return Token(position, Token::Kind::String, std::move(result));
   }
 
   static inline void
@@ -864,7 +1035,7 @@ namespace snek::parser
       EatDigits(m_input, result);
     }
 
-    return Token(position, kind, result);
+    return Token(position, kind, std::move(result));
   }
 
   char32_t
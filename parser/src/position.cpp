@@ -31,7 +31,7 @@ namespace snek
   std::u32string
   Position::ToString() const
   {
-    return filename +
+    return (filename ? *filename : std::u32string()) +
       U':' +
       parser::utils::IntToString(line) +
       U':' +
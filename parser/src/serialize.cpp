@@ -0,0 +1,1485 @@
+/*
+ * Copyright (c) 2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <climits>
+#include <cstring>
+
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "snek/parser/element.hpp"
+#include "snek/parser/error.hpp"
+#include "snek/parser/expression.hpp"
+#include "snek/parser/field.hpp"
+#include "snek/parser/import.hpp"
+#include "snek/parser/serialize.hpp"
+#include "snek/parser/type.hpp"
+
+namespace snek::parser::serialize
+{
+  namespace
+  {
+    /**
+     * Maximum nesting depth of syntax tree nodes accepted by the reader, so
+     * that corrupted input cannot exhaust the stack.
+     */
+    static constexpr std::size_t kMaxDepth = 1024;
+
+    static bool
+    IsValid(expression::Assign::Operator op)
+    {
+      switch (op)
+      {
+        case expression::Assign::Operator::Add:
+        case expression::Assign::Operator::Sub:
+        case expression::Assign::Operator::Mul:
+        case expression::Assign::Operator::Div:
+        case expression::Assign::Operator::Mod:
+        case expression::Assign::Operator::BitwiseAnd:
+        case expression::Assign::Operator::BitwiseOr:
+        case expression::Assign::Operator::BitwiseXor:
+        case expression::Assign::Operator::LeftShift:
+        case expression::Assign::Operator::RightShift:
+        case expression::Assign::Operator::LogicalAnd:
+        case expression::Assign::Operator::LogicalOr:
+        case expression::Assign::Operator::NullCoalescing:
+          return true;
+      }
+
+      return false;
+    }
+
+    static bool
+    IsValid(expression::Binary::Operator op)
+    {
+      switch (op)
+      {
+        case expression::Binary::Operator::Add:
+        case expression::Binary::Operator::Sub:
+        case expression::Binary::Operator::Mul:
+        case expression::Binary::Operator::Div:
+        case expression::Binary::Operator::Mod:
+        case expression::Binary::Operator::BitwiseAnd:
+        case expression::Binary::Operator::BitwiseOr:
+        case expression::Binary::Operator::BitwiseXor:
+        case expression::Binary::Operator::Equal:
+        case expression::Binary::Operator::NotEqual:
+        case expression::Binary::Operator::LessThan:
+        case expression::Binary::Operator::GreaterThan:
+        case expression::Binary::Operator::LessThanEqual:
+        case expression::Binary::Operator::GreaterThanEqual:
+        case expression::Binary::Operator::LeftShift:
+        case expression::Binary::Operator::RightShift:
+        case expression::Binary::Operator::LogicalAnd:
+        case expression::Binary::Operator::LogicalOr:
+        case expression::Binary::Operator::NullCoalescing:
+          return true;
+      }
+
+      return false;
+    }
+
+    static bool
+    IsValid(expression::Unary::Operator op)
+    {
+      switch (op)
+      {
+        case expression::Unary::Operator::Not:
+        case expression::Unary::Operator::Add:
+        case expression::Unary::Operator::Sub:
+        case expression::Unary::Operator::BitwiseNot:
+          return true;
+      }
+
+      return false;
+    }
+
+    static bool
+    IsValid(statement::JumpKind kind)
+    {
+      switch (kind)
+      {
+        case statement::JumpKind::Break:
+        case statement::JumpKind::Continue:
+        case statement::JumpKind::Return:
+          return true;
+      }
+
+      return false;
+    }
+
+    class Writer final
+    {
+    public:
+      explicit Writer(std::string& output)
+        : m_output(output) {}
+
+      void WriteByte(std::uint8_t value)
+      {
+        m_output.push_back(static_cast<char>(value));
+      }
+
+      void WriteBool(bool value)
+      {
+        WriteByte(value ? 1 : 0);
+      }
+
+      void WriteUInt(std::uint64_t value)
+      {
+        while (value >= 0x80)
+        {
+          WriteByte(static_cast<std::uint8_t>(value | 0x80));
+          value >>= 7;
+        }
+        WriteByte(static_cast<std::uint8_t>(value));
+      }
+
+      void WriteInt(std::int64_t value)
+      {
+        // Zig-zag encoding keeps small negative numbers small.
+        WriteUInt(
+          (static_cast<std::uint64_t>(value) << 1) ^
+          static_cast<std::uint64_t>(value >> 63)
+        );
+      }
+
+      void WriteDouble(double value)
+      {
+        char buffer[sizeof(double)];
+
+        std::memcpy(buffer, &value, sizeof(double));
+        m_output.append(buffer, sizeof(double));
+      }
+
+      void WriteString(const std::u32string& value)
+      {
+        const auto encoded = peelo::unicode::encoding::utf8::encode(value);
+
+        WriteUInt(encoded.length());
+        m_output.append(encoded);
+      }
+
+      void WriteOptionalString(const std::optional<std::u32string>& value)
+      {
+        WriteBool(!!value);
+        if (value)
+        {
+          WriteString(*value);
+        }
+      }
+
+      void WritePosition(const std::optional<Position>& position)
+      {
+        WriteBool(!!position);
+        if (position)
+        {
+          WriteUInt(position->line);
+          WriteUInt(position->column);
+        }
+      }
+
+      void WriteParameters(const std::vector<Parameter>& parameters)
+      {
+        WriteUInt(parameters.size());
+        for (const auto& parameter : parameters)
+        {
+          WritePosition(parameter.position);
+          WriteString(parameter.name);
+          WriteType(parameter.type);
+          WriteExpression(parameter.default_value);
+          WriteBool(parameter.rest);
+        }
+      }
+
+      void WriteElement(const element::ptr& element)
+      {
+        WritePosition(element->position);
+        WriteByte(static_cast<std::uint8_t>(element->kind));
+        WriteExpression(element->expression);
+      }
+
+      void WriteField(const field::ptr& field);
+
+      void WriteSpecifier(const import::ptr& specifier);
+
+      void WriteType(const type::ptr& type);
+
+      void WriteExpression(const expression::ptr& expression);
+
+      void WriteStatement(const statement::ptr& statement);
+
+    private:
+      std::string& m_output;
+    };
+
+    class Reader final
+    {
+    public:
+      explicit Reader(
+        const char* input,
+        std::size_t length,
+        const std::u32string& filename
+      )
+        : m_current(input)
+        , m_end(input + length)
+        , m_filename(std::make_shared<const std::u32string>(filename))
+        , m_depth(0) {}
+
+      inline bool HasMoreInput() const
+      {
+        return m_current < m_end;
+      }
+
+      std::uint8_t ReadByte()
+      {
+        if (!HasMoreInput())
+        {
+          Fail();
+        }
+
+        return static_cast<std::uint8_t>(*m_current++);
+      }
+
+      inline bool ReadBool()
+      {
+        return ReadByte() != 0;
+      }
+
+      std::uint64_t ReadUInt()
+      {
+        std::uint64_t value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+          const auto byte = ReadByte();
+
+          value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+          if (!(byte & 0x80))
+          {
+            return value;
+          }
+        }
+        Fail();
+      }
+
+      inline std::int64_t ReadInt()
+      {
+        const auto value = ReadUInt();
+
+        return static_cast<std::int64_t>(value >> 1) ^
+          -static_cast<std::int64_t>(value & 1);
+      }
+
+      double ReadDouble()
+      {
+        double value;
+
+        Require(sizeof(double));
+        std::memcpy(&value, m_current, sizeof(double));
+        m_current += sizeof(double);
+
+        return value;
+      }
+
+      std::u32string ReadString()
+      {
+        const auto length = ReadUInt();
+        const char* start = m_current;
+
+        Require(length);
+        m_current += length;
+
+        return peelo::unicode::encoding::utf8::decode(
+          std::string(start, length)
+        );
+      }
+
+      std::optional<std::u32string> ReadOptionalString()
+      {
+        if (ReadBool())
+        {
+          return ReadString();
+        }
+
+        return std::nullopt;
+      }
+
+      std::optional<Position> ReadPosition()
+      {
+        if (ReadBool())
+        {
+          const auto line = static_cast<int>(ReadUInt());
+          const auto column = static_cast<int>(ReadUInt());
+
+          return std::make_optional<Position>({ m_filename, line, column });
+        }
+
+        return std::nullopt;
+      }
+
+      std::vector<Parameter> ReadParameters()
+      {
+        const auto size = ReadUInt();
+        std::vector<Parameter> parameters;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+          const auto position = ReadPosition();
+          const auto name = ReadString();
+          const auto type = ReadType();
+          const auto default_value = ReadExpression();
+
+          parameters.emplace_back(
+            position,
+            name,
+            type,
+            default_value,
+            ReadBool()
+          );
+        }
+
+        return parameters;
+      }
+
+      /**
+       * Reads operator or other enumeration whose values are stored as
+       * integers, and fails unless the value is one of the enumerators.
+       */
+      template<class T>
+      T ReadEnum()
+      {
+        const auto value = ReadUInt();
+
+        if (
+          value > static_cast<std::uint64_t>(INT_MAX) ||
+          !IsValid(static_cast<T>(value))
+        )
+        {
+          Fail();
+        }
+
+        return static_cast<T>(value);
+      }
+
+      /**
+       * Converts tag of a syntax tree node into it's kind, and fails if the
+       * tag is greater than the last kind.
+       */
+      template<class T>
+      static T ToKind(std::uint8_t tag, T last)
+      {
+        if (tag > static_cast<std::uint8_t>(last))
+        {
+          Fail();
+        }
+
+        return static_cast<T>(tag);
+      }
+
+      element::ptr ReadElement()
+      {
+        const auto position = ReadPosition();
+        const auto kind = ToKind(ReadByte(), element::Kind::Value);
+
+        return std::make_shared<element::Base>(
+          position,
+          kind,
+          ReadRequiredExpression()
+        );
+      }
+
+      field::ptr ReadField();
+
+      import::ptr ReadSpecifier();
+
+      type::ptr ReadType();
+
+      expression::ptr ReadExpression();
+
+      statement::ptr ReadStatement();
+
+      type::ptr ReadRequiredType()
+      {
+        return Required(ReadType());
+      }
+
+      expression::ptr ReadRequiredExpression()
+      {
+        return Required(ReadExpression());
+      }
+
+      statement::ptr ReadRequiredStatement()
+      {
+        return Required(ReadStatement());
+      }
+
+      template<class T, class Function>
+      std::vector<T> ReadVector(Function read)
+      {
+        const auto size = ReadUInt();
+        std::vector<T> result;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+          result.push_back((this->*read)());
+        }
+
+        return result;
+      }
+
+      [[noreturn]] static void Fail()
+      {
+        throw SyntaxError{ std::nullopt, U"Malformed compiled syntax tree." };
+      }
+
+    private:
+      /**
+       * Tracks nesting depth of the node being read.
+       */
+      class DepthScope final
+      {
+      public:
+        explicit DepthScope(Reader& reader)
+          : m_reader(reader)
+        {
+          if (m_reader.m_depth >= kMaxDepth)
+          {
+            Fail();
+          }
+          ++m_reader.m_depth;
+        }
+
+        ~DepthScope()
+        {
+          --m_reader.m_depth;
+        }
+
+      private:
+        Reader& m_reader;
+      };
+
+      inline void Require(std::uint64_t size) const
+      {
+        if (size > static_cast<std::uint64_t>(m_end - m_current))
+        {
+          Fail();
+        }
+      }
+
+      template<class T>
+      static inline T Required(T node)
+      {
+        if (!node)
+        {
+          Fail();
+        }
+
+        return node;
+      }
+
+    private:
+      const char* m_current;
+      const char* const m_end;
+      const std::shared_ptr<const std::u32string> m_filename;
+      std::size_t m_depth;
+    };
+
+    void
+    Writer::WriteField(const field::ptr& field)
+    {
+      const auto kind = field->kind();
+
+      WriteByte(static_cast<std::uint8_t>(kind));
+      WritePosition(field->position);
+      switch (kind)
+      {
+        case field::Kind::Computed:
+          {
+            const auto computed = static_cast<const field::Computed*>(
+              field.get()
+            );
+
+            WriteExpression(computed->key);
+            WriteExpression(computed->value);
+          }
+          break;
+
+        case field::Kind::Function:
+          {
+            const auto function = static_cast<const field::Function*>(
+              field.get()
+            );
+
+            WriteString(function->name);
+            WriteParameters(function->parameters);
+            WriteType(function->return_type);
+            WriteStatement(function->body);
+          }
+          break;
+
+        case field::Kind::Named:
+          {
+            const auto named = static_cast<const field::Named*>(field.get());
+
+            WriteString(named->name);
+            WriteExpression(named->value);
+          }
+          break;
+
+        case field::Kind::Shorthand:
+          WriteString(static_cast<const field::Shorthand*>(field.get())->name);
+          break;
+
+        case field::Kind::Spread:
+          WriteExpression(
+            static_cast<const field::Spread*>(field.get())->expression
+          );
+          break;
+      }
+    }
+
+    field::ptr
+    Reader::ReadField()
+    {
+      const auto kind = ToKind(ReadByte(), field::Kind::Spread);
+      const auto position = ReadPosition();
+
+      switch (kind)
+      {
+        case field::Kind::Computed:
+          {
+            const auto key = ReadRequiredExpression();
+
+            return std::make_shared<field::Computed>(
+              position,
+              key,
+              ReadRequiredExpression()
+            );
+          }
+
+        case field::Kind::Function:
+          {
+            const auto name = ReadString();
+            const auto parameters = ReadParameters();
+            const auto return_type = ReadType();
+
+            return std::make_shared<field::Function>(
+              position,
+              name,
+              parameters,
+              return_type,
+              ReadRequiredStatement()
+            );
+          }
+
+        case field::Kind::Named:
+          {
+            const auto name = ReadString();
+
+            return std::make_shared<field::Named>(
+              position,
+              name,
+              ReadRequiredExpression()
+            );
+          }
+
+        case field::Kind::Shorthand:
+          return std::make_shared<field::Shorthand>(position, ReadString());
+
+        case field::Kind::Spread:
+          return std::make_shared<field::Spread>(
+            position,
+            ReadRequiredExpression()
+          );
+      }
+      Fail();
+    }
+
+    void
+    Writer::WriteSpecifier(const import::ptr& specifier)
+    {
+      const auto kind = specifier->kind();
+
+      WriteByte(static_cast<std::uint8_t>(kind));
+      WritePosition(specifier->position);
+      WriteOptionalString(specifier->alias);
+      if (kind == import::Kind::Named)
+      {
+        WriteString(static_cast<const import::Named*>(specifier.get())->name);
+      }
+    }
+
+    import::ptr
+    Reader::ReadSpecifier()
+    {
+      const auto kind = ToKind(ReadByte(), import::Kind::Star);
+      const auto position = ReadPosition();
+      const auto alias = ReadOptionalString();
+
+      switch (kind)
+      {
+        case import::Kind::Named:
+          return std::make_shared<import::Named>(
+            position,
+            ReadString(),
+            alias
+          );
+
+        case import::Kind::Star:
+          return std::make_shared<import::Star>(position, alias);
+      }
+      Fail();
+    }
+
+    void
+    Writer::WriteType(const type::ptr& type)
+    {
+      if (!type)
+      {
+        WriteByte(0);
+        return;
+      }
+
+      const auto kind = type->kind();
+
+      WriteByte(static_cast<std::uint8_t>(kind) + 1);
+      WritePosition(type->position);
+      switch (kind)
+      {
+        case type::Kind::Boolean:
+          WriteBool(static_cast<const type::Boolean*>(type.get())->value);
+          break;
+
+        case type::Kind::Function:
+          {
+            const auto function = static_cast<const type::Function*>(
+              type.get()
+            );
+
+            WriteParameters(function->parameters);
+            WriteType(function->return_type);
+          }
+          break;
+
+        case type::Kind::List:
+          WriteType(static_cast<const type::List*>(type.get())->element_type);
+          break;
+
+        case type::Kind::Multiple:
+          {
+            const auto multiple = static_cast<const type::Multiple*>(
+              type.get()
+            );
+
+            WriteByte(static_cast<std::uint8_t>(multiple->multiple_kind));
+            WriteUInt(multiple->types.size());
+            for (const auto& element : multiple->types)
+            {
+              WriteType(element);
+            }
+          }
+          break;
+
+        case type::Kind::Named:
+          WriteString(static_cast<const type::Named*>(type.get())->name);
+          break;
+
+        case type::Kind::Null:
+          break;
+
+        case type::Kind::Record:
+          {
+            const auto& fields = static_cast<const type::Record*>(
+              type.get()
+            )->fields;
+
+            WriteUInt(fields.size());
+            for (const auto& field : fields)
+            {
+              WriteString(field.first);
+              WriteType(field.second);
+            }
+          }
+          break;
+
+        case type::Kind::String:
+          WriteString(static_cast<const type::String*>(type.get())->value);
+          break;
+      }
+    }
+
+    type::ptr
+    Reader::ReadType()
+    {
+      const auto tag = ReadByte();
+
+      if (!tag)
+      {
+        return nullptr;
+      }
+
+      const DepthScope depth(*this);
+      const auto kind = ToKind(tag - 1, type::Kind::String);
+      const auto position = ReadPosition();
+
+      switch (kind)
+      {
+        case type::Kind::Boolean:
+          return std::make_shared<type::Boolean>(position, ReadBool());
+
+        case type::Kind::Function:
+          {
+            const auto parameters = ReadParameters();
+
+            return std::make_shared<type::Function>(
+              position,
+              parameters,
+              ReadType()
+            );
+          }
+
+        case type::Kind::List:
+          return std::make_shared<type::List>(
+            position,
+            ReadRequiredType()
+          );
+
+        case type::Kind::Multiple:
+          {
+            const auto multiple_kind = ToKind(
+              ReadByte(),
+              type::Multiple::MultipleKind::Union
+            );
+
+            return std::make_shared<type::Multiple>(
+              position,
+              multiple_kind,
+              ReadVector<type::ptr>(&Reader::ReadRequiredType)
+            );
+          }
+
+        case type::Kind::Named:
+          return std::make_shared<type::Named>(position, ReadString());
+
+        case type::Kind::Null:
+          return std::make_shared<type::Null>(position);
+
+        case type::Kind::Record:
+          {
+            const auto size = ReadUInt();
+            type::Record::container_type fields;
+
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+              const auto name = ReadString();
+
+              fields[name] = ReadRequiredType();
+            }
+
+            return std::make_shared<type::Record>(position, fields);
+          }
+
+        case type::Kind::String:
+          return std::make_shared<type::String>(position, ReadString());
+      }
+      Fail();
+    }
+
+    void
+    Writer::WriteExpression(const expression::ptr& expression)
+    {
+      if (!expression)
+      {
+        WriteByte(0);
+        return;
+      }
+
+      const auto kind = expression->kind();
+
+      WriteByte(static_cast<std::uint8_t>(kind) + 1);
+      WritePosition(expression->position);
+      switch (kind)
+      {
+        case expression::Kind::Assign:
+          {
+            const auto assign = static_cast<const expression::Assign*>(
+              expression.get()
+            );
+
+            WriteExpression(assign->variable);
+            WriteExpression(assign->value);
+            WriteBool(!!assign->op);
+            if (assign->op)
+            {
+              WriteUInt(static_cast<std::uint64_t>(*assign->op));
+            }
+          }
+          break;
+
+        case expression::Kind::Binary:
+          {
+            const auto binary = static_cast<const expression::Binary*>(
+              expression.get()
+            );
+
+            WriteExpression(binary->left);
+            WriteUInt(static_cast<std::uint64_t>(binary->op));
+            WriteExpression(binary->right);
+          }
+          break;
+
+        case expression::Kind::Boolean:
+          WriteBool(
+            static_cast<const expression::Boolean*>(expression.get())->value
+          );
+          break;
+
+        case expression::Kind::Call:
+          {
+            const auto call = static_cast<const expression::Call*>(
+              expression.get()
+            );
+
+            WriteExpression(call->expression);
+            WriteUInt(call->arguments.size());
+            for (const auto& argument : call->arguments)
+            {
+              WriteExpression(argument);
+            }
+            WriteBool(call->conditional);
+          }
+          break;
+
+        case expression::Kind::Decrement:
+          {
+            const auto decrement = static_cast<const expression::Decrement*>(
+              expression.get()
+            );
+
+            WriteExpression(decrement->variable);
+            WriteBool(decrement->pre);
+          }
+          break;
+
+        case expression::Kind::Float:
+          WriteDouble(
+            static_cast<const expression::Float*>(expression.get())->value
+          );
+          break;
+
+        case expression::Kind::Function:
+          {
+            const auto function = static_cast<const expression::Function*>(
+              expression.get()
+            );
+
+            WriteParameters(function->parameters);
+            WriteType(function->return_type);
+            WriteStatement(function->body);
+          }
+          break;
+
+        case expression::Kind::Id:
+          WriteString(
+            static_cast<const expression::Id*>(expression.get())->identifier
+          );
+          break;
+
+        case expression::Kind::Increment:
+          {
+            const auto increment = static_cast<const expression::Increment*>(
+              expression.get()
+            );
+
+            WriteExpression(increment->variable);
+            WriteBool(increment->pre);
+          }
+          break;
+
+        case expression::Kind::Int:
+          WriteInt(
+            static_cast<const expression::Int*>(expression.get())->value
+          );
+          break;
+
+        case expression::Kind::List:
+          {
+            const auto& elements = static_cast<const expression::List*>(
+              expression.get()
+            )->elements;
+
+            WriteUInt(elements.size());
+            for (const auto& element : elements)
+            {
+              WriteElement(element);
+            }
+          }
+          break;
+
+        case expression::Kind::Null:
+          break;
+
+        case expression::Kind::Property:
+          {
+            const auto property = static_cast<const expression::Property*>(
+              expression.get()
+            );
+
+            WriteExpression(property->expression);
+            WriteString(property->name);
+            WriteBool(property->conditional);
+          }
+          break;
+
+        case expression::Kind::Record:
+          {
+            const auto& fields = static_cast<const expression::Record*>(
+              expression.get()
+            )->fields;
+
+            WriteUInt(fields.size());
+            for (const auto& field : fields)
+            {
+              WriteField(field);
+            }
+          }
+          break;
+
+        case expression::Kind::Spread:
+          WriteExpression(
+            static_cast<const expression::Spread*>(
+              expression.get()
+            )->expression
+          );
+          break;
+
+        case expression::Kind::String:
+          WriteString(
+            static_cast<const expression::String*>(expression.get())->value
+          );
+          break;
+
+        case expression::Kind::Subscript:
+          {
+            const auto subscript = static_cast<const expression::Subscript*>(
+              expression.get()
+            );
+
+            WriteExpression(subscript->expression);
+            WriteExpression(subscript->index);
+            WriteBool(subscript->conditional);
+          }
+          break;
+
+        case expression::Kind::Ternary:
+          {
+            const auto ternary = static_cast<const expression::Ternary*>(
+              expression.get()
+            );
+
+            WriteExpression(ternary->condition);
+            WriteExpression(ternary->then_expression);
+            WriteExpression(ternary->else_expression);
+          }
+          break;
+
+        case expression::Kind::Unary:
+          {
+            const auto unary = static_cast<const expression::Unary*>(
+              expression.get()
+            );
+
+            WriteUInt(static_cast<std::uint64_t>(unary->op));
+            WriteExpression(unary->operand);
+          }
+          break;
+      }
+    }
+
+    expression::ptr
+    Reader::ReadExpression()
+    {
+      const auto tag = ReadByte();
+
+      if (!tag)
+      {
+        return nullptr;
+      }
+
+      const DepthScope depth(*this);
+      const auto kind = ToKind(tag - 1, expression::Kind::Unary);
+      const auto position = ReadPosition();
+
+      switch (kind)
+      {
+        case expression::Kind::Assign:
+          {
+            const auto variable = ReadRequiredExpression();
+            const auto value = ReadRequiredExpression();
+            std::optional<expression::Assign::Operator> op;
+
+            if (ReadBool())
+            {
+              op = ReadEnum<expression::Assign::Operator>();
+            }
+
+            return std::make_shared<expression::Assign>(
+              position,
+              variable,
+              value,
+              op
+            );
+          }
+
+        case expression::Kind::Binary:
+          {
+            const auto left = ReadRequiredExpression();
+            const auto op = ReadEnum<expression::Binary::Operator>();
+            const auto right = ReadRequiredExpression();
+
+            return std::make_shared<expression::Binary>(left, op, right);
+          }
+
+        case expression::Kind::Boolean:
+          return std::make_shared<expression::Boolean>(position, ReadBool());
+
+        case expression::Kind::Call:
+          {
+            const auto callee = ReadRequiredExpression();
+            const auto arguments = ReadVector<expression::ptr>(
+              &Reader::ReadRequiredExpression
+            );
+
+            return std::make_shared<expression::Call>(
+              position,
+              callee,
+              arguments,
+              ReadBool()
+            );
+          }
+
+        case expression::Kind::Decrement:
+          {
+            const auto variable = ReadRequiredExpression();
+
+            return std::make_shared<expression::Decrement>(
+              position,
+              variable,
+              ReadBool()
+            );
+          }
+
+        case expression::Kind::Float:
+          return std::make_shared<expression::Float>(position, ReadDouble());
+
+        case expression::Kind::Function:
+          {
+            const auto parameters = ReadParameters();
+            const auto return_type = ReadType();
+
+            return std::make_shared<expression::Function>(
+              position,
+              parameters,
+              return_type,
+              ReadRequiredStatement()
+            );
+          }
+
+        case expression::Kind::Id:
+          return std::make_shared<expression::Id>(position, ReadString());
+
+        case expression::Kind::Increment:
+          {
+            const auto variable = ReadRequiredExpression();
+
+            return std::make_shared<expression::Increment>(
+              position,
+              variable,
+              ReadBool()
+            );
+          }
+
+        case expression::Kind::Int:
+          return std::make_shared<expression::Int>(position, ReadInt());
+
+        case expression::Kind::List:
+          return std::make_shared<expression::List>(
+            position,
+            ReadVector<element::ptr>(&Reader::ReadElement)
+          );
+
+        case expression::Kind::Null:
+          return std::make_shared<expression::Null>(position);
+
+        case expression::Kind::Property:
+          {
+            const auto object = ReadRequiredExpression();
+            const auto name = ReadString();
+
+            return std::make_shared<expression::Property>(
+              position,
+              object,
+              name,
+              ReadBool()
+            );
+          }
+
+        case expression::Kind::Record:
+          return std::make_shared<expression::Record>(
+            position,
+            ReadVector<field::ptr>(&Reader::ReadField)
+          );
+
+        case expression::Kind::Spread:
+          return std::make_shared<expression::Spread>(
+            position,
+            ReadRequiredExpression()
+          );
+
+        case expression::Kind::String:
+          return std::make_shared<expression::String>(
+            position,
+            ReadString()
+          );
+
+        case expression::Kind::Subscript:
+          {
+            const auto object = ReadRequiredExpression();
+            const auto index = ReadRequiredExpression();
+
+            return std::make_shared<expression::Subscript>(
+              position,
+              object,
+              index,
+              ReadBool()
+            );
+          }
+
+        case expression::Kind::Ternary:
+          {
+            const auto condition = ReadRequiredExpression();
+            const auto then_expression = ReadRequiredExpression();
+
+            return std::make_shared<expression::Ternary>(
+              position,
+              condition,
+              then_expression,
+              ReadRequiredExpression()
+            );
+          }
+
+        case expression::Kind::Unary:
+          {
+            const auto op = ReadEnum<expression::Unary::Operator>();
+
+            return std::make_shared<expression::Unary>(
+              position,
+              op,
+              ReadRequiredExpression()
+            );
+          }
+      }
+      Fail();
+    }
+
+    void
+    Writer::WriteStatement(const statement::ptr& statement)
+    {
+      if (!statement)
+      {
+        WriteByte(0);
+        return;
+      }
+
+      const auto kind = statement->kind();
+
+      WriteByte(static_cast<std::uint8_t>(kind) + 1);
+      WritePosition(statement->position);
+      switch (kind)
+      {
+        case statement::Kind::Block:
+          {
+            const auto& statements = static_cast<const statement::Block*>(
+              statement.get()
+            )->statements;
+
+            WriteUInt(statements.size());
+            for (const auto& child : statements)
+            {
+              WriteStatement(child);
+            }
+          }
+          break;
+
+        case statement::Kind::DeclareType:
+          {
+            const auto declare = static_cast<const statement::DeclareType*>(
+              statement.get()
+            );
+
+            WriteBool(declare->is_export);
+            WriteString(declare->name);
+            WriteType(declare->type);
+          }
+          break;
+
+        case statement::Kind::DeclareVar:
+          {
+            const auto declare = static_cast<const statement::DeclareVar*>(
+              statement.get()
+            );
+
+            WriteBool(declare->is_export);
+            WriteBool(declare->is_read_only);
+            WriteExpression(declare->variable);
+            WriteExpression(declare->value);
+          }
+          break;
+
+        case statement::Kind::Expression:
+          WriteExpression(
+            static_cast<const statement::Expression*>(
+              statement.get()
+            )->expression
+          );
+          break;
+
+        case statement::Kind::For:
+          {
+            const auto for_statement = static_cast<const statement::For*>(
+              statement.get()
+            );
+
+            WriteExpression(for_statement->variable);
+            WriteExpression(for_statement->iterable);
+            WriteStatement(for_statement->body);
+          }
+          break;
+
+        case statement::Kind::If:
+          {
+            const auto if_statement = static_cast<const statement::If*>(
+              statement.get()
+            );
+
+            WriteExpression(if_statement->condition);
+            WriteStatement(if_statement->then_statement);
+            WriteStatement(if_statement->else_statement);
+          }
+          break;
+
+        case statement::Kind::Import:
+          {
+            const auto import = static_cast<const statement::Import*>(
+              statement.get()
+            );
+
+            WriteUInt(import->specifiers.size());
+            for (const auto& specifier : import->specifiers)
+            {
+              WriteSpecifier(specifier);
+            }
+            WriteString(import->path);
+          }
+          break;
+
+        case statement::Kind::Jump:
+          {
+            const auto jump = static_cast<const statement::Jump*>(
+              statement.get()
+            );
+
+            WriteUInt(static_cast<std::uint64_t>(jump->jump_kind));
+            WriteExpression(jump->value);
+          }
+          break;
+
+        case statement::Kind::While:
+          {
+            const auto while_statement = static_cast<const statement::While*>(
+              statement.get()
+            );
+
+            WriteExpression(while_statement->condition);
+            WriteStatement(while_statement->body);
+          }
+          break;
+      }
+    }
+
+    statement::ptr
+    Reader::ReadStatement()
+    {
+      const auto tag = ReadByte();
+
+      if (!tag)
+      {
+        return nullptr;
+      }
+
+      const DepthScope depth(*this);
+      const auto kind = ToKind(tag - 1, statement::Kind::While);
+      const auto position = ReadPosition();
+
+      switch (kind)
+      {
+        case statement::Kind::Block:
+          return std::make_shared<statement::Block>(
+            position,
+            ReadVector<statement::ptr>(&Reader::ReadRequiredStatement)
+          );
+
+        case statement::Kind::DeclareType:
+          {
+            const auto is_export = ReadBool();
+            const auto name = ReadString();
+
+            return std::make_shared<statement::DeclareType>(
+              position,
+              is_export,
+              name,
+              ReadRequiredType()
+            );
+          }
+
+        case statement::Kind::DeclareVar:
+          {
+            const auto is_export = ReadBool();
+            const auto is_read_only = ReadBool();
+            const auto variable = ReadRequiredExpression();
+
+            return std::make_shared<statement::DeclareVar>(
+              position,
+              is_export,
+              is_read_only,
+              variable,
+              ReadExpression()
+            );
+          }
+
+        case statement::Kind::Expression:
+          return std::make_shared<statement::Expression>(
+            ReadRequiredExpression()
+          );
+
+        case statement::Kind::For:
+          {
+            const auto variable = ReadRequiredExpression();
+            const auto iterable = ReadRequiredExpression();
+
+            return std::make_shared<statement::For>(
+              position,
+              variable,
+              iterable,
+              ReadRequiredStatement()
+            );
+          }
+
+        case statement::Kind::If:
+          {
+            const auto condition = ReadRequiredExpression();
+            const auto then_statement = ReadRequiredStatement();
+
+            return std::make_shared<statement::If>(
+              position,
+              condition,
+              then_statement,
+              ReadStatement()
+            );
+          }
+
+        case statement::Kind::Import:
+          {
+            const auto specifiers = ReadVector<import::ptr>(
+              &Reader::ReadSpecifier
+            );
+
+            return std::make_shared<statement::Import>(
+              position,
+              specifiers,
+              ReadString()
+            );
+          }
+
+        case statement::Kind::Jump:
+          {
+            const auto jump_kind = ReadEnum<statement::JumpKind>();
+
+            return std::make_shared<statement::Jump>(
+              position,
+              jump_kind,
+              ReadExpression()
+            );
+          }
+
+        case statement::Kind::While:
+          {
+            const auto condition = ReadRequiredExpression();
+
+            return std::make_shared<statement::While>(
+              position,
+              condition,
+              ReadRequiredStatement()
+            );
+          }
+      }
+      Fail();
+    }
+  }
+
+  void
+  Serialize(
+    const std::vector<statement::ptr>& statements,
+    std::string& output
+  )
+  {
+    Writer writer(output);
+
+    writer.WriteUInt(statements.size());
+    for (const auto& statement : statements)
+    {
+      writer.WriteStatement(statement);
+    }
+  }
+
+  std::vector<statement::ptr>
+  Deserialize(
+    const char* input,
+    std::size_t length,
+    const std::u32string& filename
+  )
+  {
+    Reader reader(input, length, filename);
+    auto statements = reader.ReadVector<statement::ptr>(
+      &Reader::ReadRequiredStatement
+    );
+
+    if (reader.HasMoreInput())
+    {
+      Reader::Fail();
+    }
+
+    return statements;
+  }
+}
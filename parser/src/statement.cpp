@@ -289,6 +289,34 @@ namespace snek::parser::statement
     );
   }
 
+  static ptr
+  ParseFor(Lexer& lexer)
+  {
+    const auto position = lexer.ReadToken().position;
+    const auto variable = expression::ParseTernary(lexer);
+    expression::ptr iterable;
+
+    if (!variable->IsAssignable())
+    {
+      throw SyntaxError{
+        variable->position,
+        U"Cannot assign to " +
+        variable->ToString() +
+        U"."
+      };
+    }
+    lexer.ReadToken(Token::Kind::KeywordIn);
+    iterable = expression::Parse(lexer);
+    lexer.ReadToken(Token::Kind::Colon);
+
+    return std::make_shared<For>(
+      position,
+      variable,
+      iterable,
+      ParseBlock(lexer)
+    );
+  }
+
   static ptr
   ParseWhile(Lexer& lexer)
   {
@@ -310,6 +338,9 @@ namespace snek::parser::statement
       case Token::Kind::KeywordIf:
         return ParseIf(lexer);
 
+      case Token::Kind::KeywordFor:
+        return ParseFor(lexer);
+
       case Token::Kind::KeywordWhile:
         return ParseWhile(lexer);
 
@@ -376,6 +407,21 @@ namespace snek::parser::statement
     return result;
   }
 
+  std::u32string
+  For::ToString() const
+  {
+    std::u32string result(U"for ");
+
+    result
+      .append(variable->ToString())
+      .append(U" in ")
+      .append(iterable->ToString())
+      .append(U": ")
+      .append(body->ToString());
+
+    return result;
+  }
+
   std::u32string
   If::ToString() const
   {
@@ -245,6 +245,9 @@ namespace snek::parser
       case Token::Kind::KeywordImport:
         return U"`import'";
 
+      case Token::Kind::KeywordIn:
+        return U"`in'";
+
       case Token::Kind::KeywordLet:
         return U"`let'";
 
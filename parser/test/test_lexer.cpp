@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+#include "snek/parser/error.hpp"
+#include "snek/parser/lexer.hpp"
+
+using namespace snek::parser;
+
+TEST_CASE("Lex identifier")
+{
+  Lexer lexer("foo_Bar$1");
+  const auto token = lexer.ReadToken();
+
+  REQUIRE(token.kind == Token::Kind::Id);
+  REQUIRE(!token.text->compare(U"foo_Bar$1"));
+}
+
+TEST_CASE("Lex identifier with non-ASCII characters")
+{
+  Lexer lexer("f\xc3\xa4\xc3\xa4 x");
+  const auto token = lexer.ReadToken();
+
+  REQUIRE(token.kind == Token::Kind::Id);
+  REQUIRE(!token.text->compare(U"fää"));
+  REQUIRE(lexer.ReadToken().position->column == 5);
+}
+
+TEST_CASE("Lex keywords")
+{
+  Lexer lexer(
+    "as break const continue else export false for from if import in let "
+    "null pass return true type while"
+  );
+  const Token::Kind expected[] =
+  {
+    Token::Kind::KeywordAs,
+    Token::Kind::KeywordBreak,
+    Token::Kind::KeywordConst,
+    Token::Kind::KeywordContinue,
+    Token::Kind::KeywordElse,
+    Token::Kind::KeywordExport,
+    Token::Kind::KeywordFalse,
+    Token::Kind::KeywordFor,
+    Token::Kind::KeywordFrom,
+    Token::Kind::KeywordIf,
+    Token::Kind::KeywordImport,
+    Token::Kind::KeywordIn,
+    Token::Kind::KeywordLet,
+    Token::Kind::KeywordNull,
+    Token::Kind::KeywordPass,
+    Token::Kind::KeywordReturn,
+    Token::Kind::KeywordTrue,
+    Token::Kind::KeywordType,
+    Token::Kind::KeywordWhile,
+  };
+
+  for (const auto kind : expected)
+  {
+    REQUIRE(lexer.ReadToken().kind == kind);
+  }
+}
+
+TEST_CASE("Identifiers resembling keywords are not keywords")
+{
+  Lexer lexer("i iff fro whilst as_ t");
+
+  for (int i = 0; i < 6; ++i)
+  {
+    REQUIRE(lexer.ReadToken().kind == Token::Kind::Id);
+  }
+}
+
+TEST_CASE("Lex from contiguous buffer")
+{
+  const char* source = "let x = 15";
+  Lexer lexer(source, std::strlen(source));
+
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::KeywordLet);
+  REQUIRE(!lexer.ReadId().compare(U"x"));
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::Assign);
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::Int);
+}
+
+TEST_CASE("Token positions are tracked")
+{
+  Lexer lexer("foo(bar)\r\n  baz");
+  Token token;
+
+  token = lexer.ReadToken();
+  REQUIRE(token.position->line == 1);
+  REQUIRE(token.position->column == 1);
+  token = lexer.ReadToken();
+  REQUIRE(token.position->column == 4);
+  token = lexer.ReadToken();
+  REQUIRE(token.position->column == 5);
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::RightParen);
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::NewLine);
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::Indent);
+  token = lexer.ReadToken();
+  REQUIRE(!token.text->compare(U"baz"));
+  REQUIRE(token.position->line == 2);
+  REQUIRE(token.position->column == 3);
+}
+
+TEST_CASE("Dot after integer is not consumed as decimal point")
+{
+  Lexer lexer("1.foo");
+
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::Int);
+  REQUIRE(lexer.ReadToken().kind == Token::Kind::Dot);
+  REQUIRE(!lexer.ReadId().compare(U"foo"));
+}
+
+TEST_CASE("Multi-byte character at end of input")
+{
+  Lexer lexer("\xc3\xa4");
+  const auto token = lexer.ReadToken();
+
+  REQUIRE(token.kind == Token::Kind::Id);
+  REQUIRE(!token.text->compare(U"ä"));
+}
+
+TEST_CASE("Invalid UTF-8 lead byte is rejected")
+{
+  Lexer lexer("\xff");
+
+  REQUIRE_THROWS_AS(lexer.ReadToken(), SyntaxError);
+}
+
+namespace
+{
+  class StringInput final : public Lexer::Input
+  {
+  public:
+    explicit StringInput(const std::u32string& input)
+      : Input(snek::Position{ nullptr, 1, 1 })
+      , m_input(input)
+      , m_offset(0) {}
+
+  protected:
+    bool HasMoreInput() const override
+    {
+      return m_offset < m_input.length();
+    }
+
+    char32_t Advance() override
+    {
+      return m_input[m_offset++];
+    }
+
+  private:
+    const std::u32string m_input;
+    std::size_t m_offset;
+  };
+}
+
+TEST_CASE("Unreading line terminator restores the position")
+{
+  StringInput input(U"ab\ncd");
+
+  input.Read();
+  input.Read();
+  REQUIRE(input.Read() == U'\n');
+  REQUIRE(input.position().line == 2);
+  REQUIRE(input.position().column == 1);
+  input.Unread(U'\n');
+  REQUIRE(input.position().line == 1);
+  REQUIRE(input.position().column == 3);
+  REQUIRE(input.Read() == U'\n');
+  REQUIRE(input.Read() == U'c');
+  REQUIRE(input.position().line == 2);
+  REQUIRE(input.position().column == 2);
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020-2025, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "snek/parser/error.hpp"
+#include "snek/parser/expression.hpp"
+#include "snek/parser/serialize.hpp"
+
+using namespace snek::parser;
+
+static std::vector<statement::ptr>
+ParseAll(const std::string& source)
+{
+  Lexer lexer(source);
+  std::vector<statement::ptr> statements;
+
+  while (!lexer.PeekToken(Token::Kind::Eof))
+  {
+    statements.push_back(statement::Parse(lexer, true));
+  }
+
+  return statements;
+}
+
+static std::vector<statement::ptr>
+RoundTrip(const std::vector<statement::ptr>& statements)
+{
+  std::string data;
+
+  serialize::Serialize(statements, data);
+
+  return serialize::Deserialize(data.data(), data.length(), U"test.snek");
+}
+
+TEST_CASE("Serialize and deserialize statements")
+{
+  const auto original = ParseAll(
+    "import * as c from \"d\"\n"
+    "export type Foo = (a: Int[]) => \"x\" | null\n"
+    "const f = (x: Int = -5, ...rest) => x ?? 1.5\n"
+    "let y = [1, ...z, { a, [b]: c, d: -1, e(): 5, f: true }]\n"
+    "f(a ? b : c, x--, ++x, 1 << 2, ~a, null)\n"
+    "while y?.foo(1)[2]:\n"
+    "  if !y:\n"
+    "    break\n"
+    "  else:\n"
+    "    y += 1\n"
+    "for [k, v] in y:\n"
+    "  continue\n"
+  );
+  const auto result = RoundTrip(original);
+
+  REQUIRE(result.size() == original.size());
+  for (std::size_t i = 0; i < result.size(); ++i)
+  {
+    REQUIRE(result[i]->kind() == original[i]->kind());
+    REQUIRE(!result[i]->ToString().compare(original[i]->ToString()));
+    REQUIRE(result[i]->position->line == original[i]->position->line);
+    REQUIRE(result[i]->position->column == original[i]->position->column);
+    REQUIRE(!result[i]->position->filename->compare(U"test.snek"));
+  }
+}
+
+TEST_CASE("Deserialize nested statements")
+{
+  const auto result = RoundTrip(ParseAll("if a:\n  b\nelse:\n  c\n"));
+  const auto if_statement = std::static_pointer_cast<statement::If>(
+    result[0]
+  );
+  const auto else_statement = std::static_pointer_cast<statement::Block>(
+    if_statement->else_statement
+  );
+
+  REQUIRE(else_statement->statements.size() == 1);
+  REQUIRE(!else_statement->statements[0]->ToString().compare(U"c"));
+  REQUIRE(else_statement->statements[0]->position->line == 4);
+}
+
+TEST_CASE("Deserialize truncated input")
+{
+  std::string data;
+
+  serialize::Serialize(ParseAll("let a = [1, 2, 3]"), data);
+  data.pop_back();
+  REQUIRE_THROWS_AS(
+    serialize::Deserialize(data.data(), data.length(), U"test.snek"),
+    SyntaxError
+  );
+}
+
+static void
+RequireMalformed(const std::string& data)
+{
+  REQUIRE_THROWS_AS(
+    serialize::Deserialize(data.data(), data.length(), U"test.snek"),
+    SyntaxError
+  );
+}
+
+TEST_CASE("Deserialize rejects missing required children")
+{
+  const auto expression_tag = static_cast<char>(
+    static_cast<int>(statement::Kind::Expression) + 1
+  );
+  const auto assign_tag = static_cast<char>(
+    static_cast<int>(expression::Kind::Assign) + 1
+  );
+
+  // Expression statement without an expression.
+  RequireMalformed(std::string{ 1, expression_tag, 0, 0 });
+  // Assignment without variable and value.
+  RequireMalformed(std::string{ 1, expression_tag, 0, assign_tag, 0, 0, 0, 0 });
+}
+
+TEST_CASE("Deserialize rejects out of range enumerations")
+{
+  std::string data;
+
+  // Unknown statement kind.
+  RequireMalformed(std::string{ 1, 100, 0 });
+
+  // Binary operator which is not an operator. The operator follows
+  // immediately after name of the left operand.
+  serialize::Serialize(ParseAll("a + b"), data);
+  data[data.find('a') + 1] = 0x7f;
+  RequireMalformed(data);
+}
+
+TEST_CASE("Deserialize rejects too deeply nested input")
+{
+  const auto expression_tag = static_cast<char>(
+    static_cast<int>(statement::Kind::Expression) + 1
+  );
+  const auto unary_tag = static_cast<char>(
+    static_cast<int>(expression::Kind::Unary) + 1
+  );
+  std::string data{ 1, expression_tag, 0 };
+
+  for (int i = 0; i < 100000; ++i)
+  {
+    data.push_back(unary_tag);
+    data.push_back(0);
+    data.push_back(static_cast<char>(expression::Unary::Operator::Not));
+  }
+  RequireMalformed(data);
+}